@@ -6,8 +6,29 @@
 // Balance control and timing configuration.
 
 namespace Config {
-    // Complementary filter
+    // Complementary filter, the fallback estimator (see TILT_USE_MAHONY).
+    // TILT_ALPHA is the gyro weight at a sample interval of
+    // TILT_ALPHA_REFERENCE_DT, not at the ~1 kHz FIFO rate:
+    // ComplementaryTiltEstimator rescales it per sample so the filter time
+    // constant stays the same at any IMU rate.
     constexpr float TILT_ALPHA = 0.98f;
+    constexpr float TILT_ALPHA_REFERENCE_DT = 0.01f;  // seconds (legacy 100 Hz loop)
+
+    // Tilt estimator used by the Teensy sketch: false = complementary
+    // filter above, true = quaternion Mahony filter (MahonyTiltEstimator).
+    // Mahony holds the tilt through wheel acceleration, which the
+    // complementary filter reads as lean (host/tilt_benchmark).
+    constexpr bool  TILT_USE_MAHONY = true;
+
+    // Mahony filter gains. KP in rad/s per unit of gravity-direction error,
+    // KI learns gyro bias. The accel correction fades out linearly as
+    // |accel| moves MAHONY_ACCEL_GATE (fraction of 1 g) away from 1 g.
+    constexpr float MAHONY_KP = 1.0f;
+    constexpr float MAHONY_KI = 0.02f;
+    constexpr float MAHONY_ACCEL_GATE = 0.05f;
+
+    // Upper bound on filter dt, so a sensor stall doesn't integrate a huge step
+    constexpr float MAX_FILTER_DT_S = 0.05f;
 
     // Observer notification threshold (degrees)
     constexpr float TILT_CHANGE_THRESHOLD = 1.0f;
@@ -15,13 +36,70 @@ namespace Config {
     // Safety limit (degrees)
     constexpr float EMERGENCY_TILT_ANGLE = 45.0f;
 
+    // Cascaded balance controller (BalanceMotorController), run every
+    // balance tick. Inner loop: lean angle (deg) -> wheel speed (rev/s).
+    // Outer loop: wheel speed -> lean setpoint, every
+    // BALANCE_VELOCITY_LOOP_DIVIDER ticks. Gains are a starting point
+    // for tuning on the robot, not tuned values.
+    constexpr float BALANCE_FORWARD_TILT_SIGN = -1.0f;  // sign of getTiltAngle() leaning forward
+    constexpr float TILT_KP = 0.25f;                     // rev/s per deg
+    constexpr float TILT_KI = 1.0f;                      // rev/s per deg·s
+    constexpr float TILT_KD = 0.02f;                     // rev/s per deg/s
+    constexpr float TILT_DERIVATIVE_TAU = 0.004f;        // s, ~40 Hz
+    constexpr float MAX_WHEEL_SPEED_REV_S = 8.0f;
+    constexpr uint8_t BALANCE_VELOCITY_LOOP_DIVIDER = 10;  // 100 Hz at 1 kHz
+    constexpr float VELOCITY_KP = 1.5f;                  // deg per rev/s
+    constexpr float VELOCITY_KI = 0.3f;                  // deg per rev
+    constexpr float MAX_LEAN_SETPOINT_DEG = 6.0f;
+
+    // Largest velocity target accepted over the command link (rev/s)
+    constexpr float COMMAND_MAX_VELOCITY_REV_S = 2.0f;
+
+    // Arm the balance controller at the end of setup(). Off until the
+    // gains have been tuned on the robot.
+    constexpr bool BALANCE_AUTO_ARM = false;
+
+    // Allow arming on the complementary filter. Off until it has been
+    // validated in closed loop: it reads wheel acceleration as lean.
+    constexpr bool BALANCE_ARM_ON_COMPLEMENTARY = false;
+
     // M4 loop timing
     constexpr uint8_t M4_LOOP_DELAY_MS = 9;
 
+    // Teensy fixed-rate scheduler. The balance task runs from a PIT
+    // IntervalTimer ISR; the remaining tasks are slots polled from loop().
+    constexpr uint16_t BALANCE_LOOP_HZ          = 1000;
+    constexpr uint8_t  BALANCE_ISR_PRIORITY     = 0;     // NVIC, 0 = highest
+    constexpr uint16_t TOF_TASK_PERIOD_MS       = 10;
+    constexpr uint16_t BRIDGE_TASK_PERIOD_MS    = 2;     // drains ISR rings to Serial
+    constexpr uint8_t  EVENT_DISPATCH_BUDGET    = 8;     // deferred events per bridge slot
+
+    // Coalesced event topics: deferred subscribers get at most RATE events
+    // a second per topic, bursts of up to BURST; anything published in
+    // between merges into the pending event (latest value wins, with a
+    // count). Emergency and collision events are never coalesced.
+    constexpr uint16_t TILT_EVENT_RATE_HZ       = 20;
+    constexpr uint8_t  TILT_EVENT_BURST         = 4;
+    constexpr uint16_t OBSTACLE_EVENT_RATE_HZ   = 10;    // per sensor side combined
+    constexpr uint8_t  OBSTACLE_EVENT_BURST     = 2;
+
+    // Emergency events reach immediate subscribers every tick while the
+    // tilt is over the limit; deferred ones (bridge, link) get the rising
+    // edge and then one reassert per interval, not 1 kHz of repeats.
+    constexpr uint16_t EMERGENCY_REASSERT_MS    = 100;
+
+    constexpr uint16_t SCHEDULER_STATS_INTERVAL_MS = 5000;
+
     // Telemetry intervals
     constexpr uint16_t IMU_DATA_INTERVAL_MS     = 500;
     constexpr uint16_t TOF_DATA_INTERVAL_MS     = 500;
     constexpr uint16_t QUEUE_STATUS_INTERVAL_MS = 5000;
+
+    // Teensy binary telemetry intervals (42-byte IMU frame at 100 Hz is
+    // ~4.2 KB/s, well inside the 115200-baud budget)
+    constexpr uint16_t IMU_TELEMETRY_INTERVAL_MS = 10;
+    constexpr uint16_t TOF_TELEMETRY_INTERVAL_MS = 50;
+    constexpr uint16_t MOTOR_TELEMETRY_INTERVAL_MS = 50;
 }
 
 #endif // BALANCE_CONFIG_H
@@ -0,0 +1,35 @@
+#ifndef BLACK_BOX_CONFIG_H
+#define BLACK_BOX_CONFIG_H
+
+#include <stdint.h>
+
+// Black-box recorder (BlackBoxRecorder) on the Teensy 4.1 built-in SD card.
+// One 64-byte record per balance tick. The RAM ring is 2048 records
+// (~2 s at 1 kHz) in DMAMEM, or 16384 (~16 s) in PSRAM when built with
+// -DINSTINCTUS_BLACKBOX_PSRAM; pre + post trigger windows must fit in it.
+
+namespace Config {
+    constexpr bool     BLACKBOX_ENABLED         = true;
+
+    // Continuously stream every record to RECnnnn.BBX. Off by default:
+    // SD writes run in loop() and an occasional slow card write delays
+    // the other loop slots (never the balance ISR).
+    constexpr bool     BLACKBOX_STREAM_ENABLED  = false;
+
+    // Emergency snapshot FALLnnnn.BBX: this much history before the
+    // EMERGENCY_STOP event and this much after it
+    constexpr uint16_t BLACKBOX_PRE_TRIGGER_MS  = 1500;
+    constexpr uint16_t BLACKBOX_POST_TRIGGER_MS = 250;
+
+    // After a snapshot, the next one waits until the emergency has been
+    // clear for this long (tilt back under the limit), or rearm()
+    constexpr uint16_t BLACKBOX_REARM_MS        = 200;
+
+    // SD write size: a multiple of the 512-byte sector, large enough to
+    // keep the card in multi-block writes
+    constexpr uint32_t BLACKBOX_CHUNK_BYTES     = 16384;
+
+    constexpr uint16_t BLACKBOX_TASK_PERIOD_MS  = 10;
+}
+
+#endif // BLACK_BOX_CONFIG_H
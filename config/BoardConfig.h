@@ -3,13 +3,92 @@
 
 #include <stdint.h>
 
-// Arduino Giga R1 WiFi board-level configuration.
-// Built-in LEDs (LEDR, LEDG, LEDB) are active-low on this board.
+// Board-level configuration.
+// Legacy Arduino Giga R1 WiFi: built-in LEDs (LEDR, LEDG, LEDB) are
+// active-low on this board.
 
 namespace Config {
+    // USB CDC ignores the baud rate (the Teensy 4.1 link is always 480
+    // Mbit/s high speed); it only matters for a UART on the other end.
     constexpr uint32_t SERIAL_BAUD_RATE = 115200;
-    constexpr uint16_t USB_ENUM_DELAY_MS = 150;
-    constexpr uint32_t CAN_BUS_SPEED = 250000;
+
+    // Jetson link (TelemetryLink). Port 0 is USB Serial; port 1 is an
+    // optional hardware UART (Serial1, pins 0/1) at LINK_UART_BAUD with
+    // DMA TX (DmaUartPort). Each LinkChannel is routed to one port and
+    // falls back to USB while the UART is disabled. Queue sizes are per
+    // channel, in OCRAM.
+    constexpr bool     LINK_UART_ENABLED       = false;
+    constexpr uint32_t LINK_UART_BAUD          = 4000000;
+    constexpr uint8_t  LINK_CONTROL_PORT       = 0;
+    constexpr uint8_t  LINK_TELEMETRY_PORT     = 0;
+    constexpr uint8_t  LINK_BULK_PORT          = 1;
+    constexpr uint16_t LINK_CONTROL_QUEUE_BYTES   = 1024;
+    constexpr uint16_t LINK_TELEMETRY_QUEUE_BYTES = 4096;
+    constexpr uint16_t LINK_BULK_QUEUE_BYTES      = 8192;
+    constexpr uint16_t LINK_UART_DMA_BUFFER_BYTES = 1024;   // per half, double buffered
+
+    // Clock sync with the Jetson (TimeSync). One NTP-style exchange per
+    // period; the clock model is fitted over the lowest-delay exchanges
+    // of the window and used once MIN_SAMPLES have been accepted.
+    constexpr uint16_t TIME_SYNC_PERIOD_MS       = 1000;
+    constexpr uint8_t  TIME_SYNC_WINDOW          = 16;      // exchanges kept
+    constexpr uint8_t  TIME_SYNC_MIN_SAMPLES     = 4;
+    constexpr uint32_t TIME_SYNC_MAX_RTT_US      = 20000;   // slower exchanges are discarded
+    constexpr uint32_t TIME_SYNC_RTT_TOLERANCE_US = 1000;   // fitted: within this of the fastest
+    constexpr uint8_t  TIME_SYNC_LATENCY_WINDOW  = 64;      // commands per latency percentile
+
+    // Tunable parameters (ParamStore) in the emulated EEPROM: two slots,
+    // written alternately, so a reset during a save keeps the older copy
+    constexpr uint16_t PARAM_EEPROM_BASE       = 0;
+    constexpr uint16_t PARAM_EEPROM_SLOT_BYTES = 128;
+
+    // Loop health (HealthMonitor), judged once per window. A window with
+    // any fault is degraded; SAFE_STATE_WINDOWS of them in a row latch the
+    // safe state (stop driving, keep balancing). The RTWDOG is fed after
+    // each window in which the balance task kept within DEADLINE_MISS_LIMIT,
+    // so it only resets the MCU when balance is failing outright or loop()
+    // hangs. Its timeout covers the longest loop() stalls (SD card, EEPROM).
+    constexpr bool     WATCHDOG_ENABLED            = true;
+    constexpr uint16_t WATCHDOG_TIMEOUT_MS         = 1000;    // RTWDOG at 32 kHz: up to 2047
+    constexpr uint16_t HEALTH_WINDOW_MS            = 100;
+    constexpr uint8_t  HEALTH_SAFE_STATE_WINDOWS   = 5;
+    constexpr uint16_t HEALTH_DEADLINE_MISS_LIMIT  = 10;      // per window, feed withheld above
+    constexpr uint32_t HEALTH_IMU_STALE_US         = 3000;    // newest IMU sample older than this
+    constexpr uint32_t HEALTH_TOF_STALE_MS         = 500;     // idle profile ranges at 10 Hz
+    constexpr uint32_t HEALTH_I2C_TIMEOUT_US       = 2000;    // async IMU transfer stuck in flight
+
+    // Control pipeline benchmark (PipelineBenchmark: -DINSTINCTUS_BENCH on
+    // the target, host/pipeline_benchmark.cpp on a desktop). Budgets are
+    // CPU cycles at BENCH_REFERENCE_HZ per call; a stage fails when its max
+    // (target) or p99 (host) is over budget. The whole 1 kHz tick has
+    // 600000 cycles, these stages are a small share of it.
+    constexpr uint32_t BENCH_REFERENCE_HZ = 600000000;
+    constexpr uint16_t BENCH_ITERATIONS   = 4096;
+    constexpr uint16_t BENCH_SERIAL_WAIT_MS = 5000;          // target: for the USB host to open the port
+    constexpr uint32_t BENCH_BUDGET_READ_SENSORS_CYCLES = 600;
+    constexpr uint32_t BENCH_BUDGET_TRANSFORM_CYCLES    = 120;
+    constexpr uint32_t BENCH_BUDGET_TILT_FILTER_CYCLES  = 400;
+    constexpr uint32_t BENCH_BUDGET_TELEMETRY_CYCLES    = 4000;   // BalanceImuPayload frame: CRC + write
+    constexpr uint32_t BENCH_BUDGET_CAN_ENCODE_CYCLES   = 400;    // Set_Input_Vel to the CAN driver
+
+    // Classic CAN at 1 Mbit/s, the fastest rate the ODrive S1 accepts (its
+    // CANSimple firmware has no CAN FD). At 250 kbit/s the per-cycle motor
+    // traffic below would need more than 300 % of the bus.
+    constexpr uint32_t CAN_BUS_SPEED = 1000000;
+
+    // Teensy 4.1 I2C wiring. Ports (AsyncI2C numbering):
+    //   0 = Wire  (SDA 18, SCL 19)
+    //   1 = Wire1 (SDA 17, SCL 16)
+    //   2 = Wire2 (SDA 25, SCL 24) - unused, pin 25 is the rear ToF XSHUT
+    // The balance IMU gets a bus to itself so a long ToF multi-ranging
+    // readout can never delay an IMU transfer.
+    struct I2CBusConfig {
+        uint8_t  port;
+        uint32_t clockHz;
+    };
+
+    constexpr I2CBusConfig IMU_I2C_BUS = { 0, 400000 };   // ICM20948, 400 kHz max
+    constexpr I2CBusConfig TOF_I2C_BUS = { 1, 400000 };   // both VL53L4CX
 }
 
 #endif // BOARD_CONFIG_H
@@ -26,6 +26,11 @@
 //   };
 //
 // The actual IMU transform for Calvin is defined in IMUConfig.h.
+//
+// Hot paths should use the compile-time form, which takes the transform
+// as a template argument and folds to three moves and sign flips:
+//
+//   applyTransform<Config::BALANCE_IMU_TRANSFORM>(sx, sy, sz, rx, ry, rz);
 
 // Maps one robot axis to one sensor axis.
 //   axis: index into the sensor's raw output array (0=X, 1=Y, 2=Z)
@@ -53,4 +58,42 @@ inline void applyTransform(const CoordinateTransform& t,
     rz = t.z.sign * src[t.z.axis];
 }
 
+#if __cplusplus >= 201703L
+
+// Compile-time transform. T must be a constexpr CoordinateTransform with
+// static storage (any namespace-scope constexpr works). Axis selection
+// and sign are resolved by the compiler; no array, no indexing, no
+// multiply. Axis indexes and signs are checked at compile time.
+template <int Axis, bool Negate>
+inline float mapAxis(float sx, float sy, float sz) {
+    static_assert(Axis >= 0 && Axis <= 2, "AxisMap axis must be 0, 1 or 2");
+    float v;
+    if constexpr (Axis == 0) {
+        v = sx;
+    } else if constexpr (Axis == 1) {
+        v = sy;
+    } else {
+        v = sz;
+    }
+    if constexpr (Negate) {
+        return -v;
+    } else {
+        return v;
+    }
+}
+
+template <const CoordinateTransform& T>
+inline void applyTransform(float sx, float sy, float sz,
+                           float& rx, float& ry, float& rz) {
+    static_assert((T.x.sign == 1.0f || T.x.sign == -1.0f) &&
+                  (T.y.sign == 1.0f || T.y.sign == -1.0f) &&
+                  (T.z.sign == 1.0f || T.z.sign == -1.0f),
+                  "AxisMap sign must be +1.0f or -1.0f");
+    rx = mapAxis<T.x.axis, (T.x.sign < 0.0f)>(sx, sy, sz);
+    ry = mapAxis<T.y.axis, (T.y.sign < 0.0f)>(sx, sy, sz);
+    rz = mapAxis<T.z.axis, (T.z.sign < 0.0f)>(sx, sy, sz);
+}
+
+#endif // __cplusplus >= 201703L
+
 #endif // COORDINATE_TRANSFORM_H
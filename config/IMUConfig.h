@@ -5,16 +5,62 @@
 #include "CoordinateTransform.h"
 
 // ICM20948 IMU configuration.
-// Ranges/rates are plain ints — ICM20948Interface maps them to library enums.
+// Ranges/rates are plain ints: ICM20948AsyncInterface (Teensy) turns them
+// into register values, the blocking ICM20948Interface into library enums.
 
 namespace Config {
     constexpr uint8_t  IMU_I2C_ADDRESS       = 0x69;
     constexpr uint8_t  IMU_ACCEL_RANGE_G     = 4;
     constexpr uint16_t IMU_GYRO_RANGE_DPS    = 500;
-    constexpr uint16_t IMU_ACCEL_RATE_DIVISOR = 4095;
-    constexpr uint8_t  IMU_GYRO_RATE_DIVISOR  = 255;
+    constexpr uint16_t IMU_ACCEL_RATE_DIVISOR = 0;     // 1125 Hz / (1 + div)
+    constexpr uint8_t  IMU_GYRO_RATE_DIVISOR  = 0;     // 1100 Hz / (1 + div)
     constexpr uint8_t  IMU_MAG_RATE_HZ       = 10;
 
+    // Teensy: ICM20948 INT1 (data ready) and async I2C interrupt priority
+    constexpr int      IMU_INT_PIN           = 2;
+    constexpr uint8_t  IMU_I2C_IRQ_PRIORITY  = 32;
+    constexpr uint32_t IMU_RESET_TIME_US     = 10000;  // PWR_MGMT_1 reset to first access
+
+    // Output data rates. The two sensors have different base rates, so
+    // equal divisors do not give equal rates (they only meet at 25 Hz and
+    // below). The gyro ODR is the sample rate of the fused stream: every
+    // IMUSample sits on its grid.
+    constexpr float    IMU_ACCEL_BASE_ODR_HZ = 1125.0f;
+    constexpr float    IMU_GYRO_BASE_ODR_HZ  = 1100.0f;
+    constexpr float    IMU_ACCEL_ODR_HZ      = IMU_ACCEL_BASE_ODR_HZ / (1 + IMU_ACCEL_RATE_DIVISOR);
+    constexpr float    IMU_GYRO_ODR_HZ       = IMU_GYRO_BASE_ODR_HZ / (1 + IMU_GYRO_RATE_DIVISOR);
+
+    // FIFO streaming: gyro records drained in one burst per balance tick
+    // instead of one read per sample, plus one accel register read per
+    // drain, interpolated across the batch
+    constexpr bool     IMU_FIFO_ENABLED      = true;
+    constexpr uint8_t  IMU_FIFO_MAX_BATCH    = 16;     // records per drain
+
+    // Vibration analysis (VibrationAnalyzer): Hann-windowed real FFTs of the
+    // FIFO sample stream, reduced to per-band RMS and averaged over the
+    // report interval. Window length is a CMSIS rfft size (32..4096);
+    // at the 1100 Hz gyro ODR, 256 samples give 4.3 Hz bins and a window
+    // every 233 ms.
+    // Band edges are upper limits in Hz, the last one at Nyquist.
+    constexpr bool     VIBRATION_ENABLED     = true;
+    constexpr uint16_t VIBRATION_WINDOW_SAMPLES = 256;
+    constexpr uint16_t VIBRATION_BAND_UPPER_HZ[] = { 10, 20, 40, 80, 140, 220, 350, 550 };
+    constexpr uint16_t VIBRATION_TASK_PERIOD_MS = 20;
+    constexpr uint16_t VIBRATION_REPORT_INTERVAL_MS = 1000;
+
+    // Collision detection (CollisionDetector): per FIFO sample, the jerk
+    // |da/dt| (m/s³) and angular acceleration |dω/dt| (rad/s²) are compared
+    // with mean + SIGMA x std over the last WINDOW samples, but never less
+    // than the floors. The floors sit above what balancing and motor
+    // vibration produce; a bump is a step in acceleration within a sample
+    // or two. One event per HOLDOFF at most.
+    constexpr bool     COLLISION_ENABLED          = true;
+    constexpr uint8_t  COLLISION_WINDOW_SAMPLES   = 128;   // ~116 ms at 1100 Hz
+    constexpr float    COLLISION_SIGMA            = 6.0f;
+    constexpr float    COLLISION_JERK_FLOOR       = 2500.0f;
+    constexpr float    COLLISION_ANG_ACCEL_FLOOR  = 400.0f;
+    constexpr uint16_t COLLISION_HOLDOFF_MS       = 250;
+
     // ICM20948 physical axes: X=forward, Y=right, Z=down
     // Robot frame:            X=forward, Y=left,  Z=up
     constexpr CoordinateTransform BALANCE_IMU_TRANSFORM = {
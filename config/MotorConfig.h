@@ -4,15 +4,34 @@
 #include <stdint.h>
 
 // ODrive S1 motor controller configuration.
-// Placeholder — will grow as motor control is implemented.
+// canId is the ODrive axis node_id (CANSimple arbitration ID = node_id << 5 | cmd).
 
 namespace Config {
     struct MotorInstanceConfig {
         uint8_t canId;
+        float   direction;    // +1 / -1: motor rotation for forward wheel travel
     };
 
-    constexpr MotorInstanceConfig MOTOR_LEFT  = { 0x01 };
-    constexpr MotorInstanceConfig MOTOR_RIGHT = { 0x02 };
+    constexpr MotorInstanceConfig MOTOR_LEFT  = { 0x01, +1.0f };
+    constexpr MotorInstanceConfig MOTOR_RIGHT = { 0x02, -1.0f };   // mirrored mount
+
+    // CAN interrupt: below the balance ISR so setpoint writes from the
+    // balance task are never delayed, above the I2C engine
+    constexpr uint8_t  CAN_IRQ_PRIORITY = 16;
+
+    // ODrive heartbeats arrive every 100 ms by default; several missed in
+    // a row means the node is gone
+    constexpr uint32_t ODRIVE_HEARTBEAT_TIMEOUT_US = 500000;
+
+    // Encoder estimates older than this stop the balance controller
+    // (normally one arrives every millisecond)
+    constexpr uint32_t ODRIVE_FEEDBACK_TIMEOUT_US = 20000;
+
+    // Bus budget per balance cycle: two Set_Input_Vel out, and per axis one
+    // encoder estimate and one Iq frame in (ODrive encoder_msg_rate_ms and
+    // iq_msg_rate_ms set to 1). Heartbeats and bus V/I at 10 Hz are noise.
+    constexpr uint8_t  CAN_FRAMES_PER_BALANCE_CYCLE = 6;
+    constexpr uint8_t  CAN_BUS_LOAD_LIMIT_PERCENT = 85;
 }
 
 #endif // MOTOR_CONFIG_H
@@ -9,15 +9,67 @@
 namespace Config {
     struct ToFInstanceConfig {
         int      xshutPin;
+        int      gpio1Pin;         // data-ready interrupt (-1 = poll over I2C)
         uint8_t  i2cAddress;
         float    warnDistanceMm;
         uint32_t timingBudgetUs;
     };
 
-    constexpr ToFInstanceConfig TOF_REAR  = { 25, 0x30, 20.0f, 33000 };
-    constexpr ToFInstanceConfig TOF_FRONT = { 23, 0x29, 20.0f, 33000 };
+    constexpr ToFInstanceConfig TOF_REAR  = { 25, 26, 0x30, 20.0f, 33000 };
+    constexpr ToFInstanceConfig TOF_FRONT = { 23, 27, 0x29, 20.0f, 33000 };
+
+    // With GPIO1 wired, readDistance() only polls the sensor if no
+    // data-ready edge arrived within this many timing budgets (a missed
+    // edge would otherwise leave the open-drain line low forever).
+    constexpr uint8_t TOF_INTERRUPT_TIMEOUT_BUDGETS = 3;
+
+    // XSHUT release to first I2C access (datasheet tBOOT, 1.2 ms max)
+    constexpr uint32_t TOF_BOOT_TIME_US = 1200;
 
     constexpr float NO_TARGET_DISTANCE = 9999.0f;
+
+    // Target tracking (ToFTargetTracker): every valid return is associated
+    // with a track by predicted distance; a track reports once it has
+    // CONFIRM_HITS returns and is dropped after MAX_MISSES measurements
+    // without one. A new return further than GATE_MM from every track
+    // starts a new one, so single spurious returns never get reported.
+    constexpr uint8_t  TOF_MAX_TARGETS        = 4;     // VL53L4CX_MAX_RANGE_RESULTS
+    constexpr uint8_t  TOF_TRACK_HISTORY      = 5;     // median / slope window
+    constexpr float    TOF_TRACK_GATE_MM      = 150.0f;
+    constexpr uint8_t  TOF_TRACK_CONFIRM_HITS = 3;
+    constexpr uint8_t  TOF_TRACK_MAX_MISSES   = 3;
+
+    // Time to contact: reported when closing faster than MIN_CLOSING,
+    // otherwise NO_CONTACT. Obstacle events fire below the warn distance
+    // or below TTC_WARN, whichever comes first.
+    constexpr float    TOF_MIN_CLOSING_MM_S   = 30.0f;
+    constexpr float    TOF_NO_CONTACT_S       = 999.0f;
+    constexpr float    TOF_TTC_WARN_S         = 1.0f;
+
+    // Runtime ranging profiles, chosen per sensor by ToFRangingPolicy from
+    // the commanded speed towards that sensor's side. distanceMode is a
+    // plain int (1 = short ~1.3 m, 2 = medium ~3 m, 3 = long ~4 m);
+    // VL53L4CXInterface maps it to VL53L4CX_DISTANCEMODE_*. Index order
+    // is risk order: faster profiles later.
+    struct ToFRangingProfile {
+        uint8_t  distanceMode;
+        uint32_t timingBudgetUs;
+    };
+
+    constexpr ToFRangingProfile TOF_RANGING_PROFILES[] = {
+        { 3, 100000 },   // idle: long range, 10 Hz
+        { 2,  33000 },   // cruise: 30 Hz
+        { 1,  15000 },   // fast approach: short mode, 66 Hz
+    };
+
+    // Closing speed (wheel rev/s towards the sensor) to enter profiles 1 and 2
+    constexpr float TOF_PROFILE_ENTER_REV_S[] = { 0.2f, 1.5f };
+
+    // Escalation is immediate. Stepping down needs the speed below
+    // HYSTERESIS x the entry threshold for HOLD_MS, so the sensor isn't
+    // restarted (one measurement lost) on every wobble of the target.
+    constexpr float    TOF_PROFILE_HYSTERESIS = 0.7f;
+    constexpr uint16_t TOF_PROFILE_HOLD_MS    = 500;
 }
 
 #endif // TOF_CONFIG_H
@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+"""
+memory_report.py - Where did the sketch land in Teensy 4.1 memory?
+
+Reads the symbol table of the built ELF and sorts every sized symbol into
+the i.MX RT1062 regions by address, then checks the MemoryPlacement.h
+policy: HOT_CODE functions must be in ITCM, bulk buffers in OCRAM/PSRAM.
+
+Usage (after an arduino-cli build with --export-binaries or --build-path):
+  python3 host/memory_report.py build/instinctus.ino.elf
+  python3 host/memory_report.py build/instinctus.ino.elf --top 25
+  python3 host/memory_report.py build/instinctus.ino.elf --nm arm-none-eabi-nm
+
+Exit status is 1 when a policy check fails, so it can gate a build script.
+Teensyduino's own teensy_size prints the RAM1/RAM2/flash totals; this adds
+the per-symbol view and the checks.
+"""
+
+import argparse
+import subprocess
+import sys
+
+# (name, start, end) from the i.MX RT1062 memory map
+REGIONS = [
+    ("ITCM",  0x00000000, 0x00080000),
+    ("DTCM",  0x20000000, 0x20080000),
+    ("OCRAM", 0x20200000, 0x20280000),
+    ("FLASH", 0x60000000, 0x70000000),
+    ("PSRAM", 0x70000000, 0x80000000),
+]
+
+RAM1_BANK = 32 * 1024
+RAM1_BANKS = 16
+
+# Functions marked HOT_CODE (balance ISR path, CAN and I2C ISRs)
+HOT_SYMBOLS = [
+    "TaskScheduler::balanceIsr",
+    "balanceTask",
+    "AsyncI2C::isr0",
+    "AsyncI2C::isr1",
+    "AsyncI2C::isr2",
+    "AsyncI2C::handleInterrupt",
+    "AsyncI2C::nextCommand",
+    "AsyncI2C::startTransfer",
+    "AsyncI2C::finish",
+    "ICM20948AsyncInterface::dataReadyIsr",
+    "ICM20948AsyncInterface::readBatch",
+    "ICM20948AsyncInterface::decodeAccel",
+    "ICM20948AsyncInterface::decodeGyro",
+    "ICM20948AsyncInterface::decodeRecord",
+    "ICM20948AsyncInterface::fifoDataComplete",
+    "ICM20948AsyncInterface::fifoAccelComplete",
+    "BalanceIMU::updateBatch",
+    "BalanceIMU::integrateSample",
+    "BalanceIMU::publishEvents",
+    "MahonyTiltEstimator::update",
+    "ComplementaryTiltEstimator::update",
+    "PidController::update",
+    "BalanceMotorController::update",
+    "BalanceMotorController::onBalanceEmergency",
+    "DriveCoordinator::setMotorSpeeds",
+    "DriveCoordinator::getWheelSpeeds",
+    "ODriveAxis::setInputVelocity",
+    "ODriveAxis::handleFrame",
+    "ODriveCAN::onFrame",
+    "FlexCANInterface::write",
+    "FlexCANInterface::onReceive",
+    "BlackBoxRecorder::record",
+    "CollisionDetector::update",
+    "HealthMonitor::balanceTick",
+    "CollisionDetector::WindowStats::push",
+    "CollisionDetector::WindowStats::threshold",
+    "DmaUartPort::completeIsr",
+    "DmaUartPort::kick",
+]
+
+# Buffers marked BULK_DATA (or EXTMEM)
+BULK_SYMBOLS = {
+    "ringStorage": ("OCRAM", "PSRAM"),
+    "rangingScratch": ("OCRAM",),
+    "vibrationWindows": ("OCRAM",),
+    "controlQueue": ("OCRAM",),
+    "telemetryQueue": ("OCRAM",),
+    "bulkQueue": ("OCRAM",),
+    "stagingBuffers": ("OCRAM",),
+}
+
+
+def region_of(addr):
+    for name, start, end in REGIONS:
+        if start <= addr < end:
+            return name
+    return None
+
+
+def load_symbols(nm, elf):
+    out = subprocess.run([nm, "-S", "-C", "--size-sort", elf],
+                         check=True, capture_output=True, text=True).stdout
+    symbols = []
+    for line in out.splitlines():
+        parts = line.split(None, 3)
+        if len(parts) < 4:
+            continue
+        addr, size, kind, name = parts
+        symbols.append((int(addr, 16), int(size, 16), kind, name))
+    return symbols
+
+
+def base_name(name):
+    # "Foo::bar(int) [clone .constprop.0]" -> "Foo::bar"
+    return name.split("(", 1)[0].strip()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("elf")
+    parser.add_argument("--nm", default="arm-none-eabi-nm")
+    parser.add_argument("--top", type=int, default=10)
+    args = parser.parse_args()
+
+    symbols = load_symbols(args.nm, args.elf)
+
+    by_region = {name: [] for name, _, _ in REGIONS}
+    for sym in symbols:
+        region = region_of(sym[0])
+        if region:
+            by_region[region].append(sym)
+
+    print("%-6s %10s %8s" % ("region", "bytes", "symbols"))
+    for name, _, _ in REGIONS:
+        total = sum(s[1] for s in by_region[name])
+        print("%-6s %10d %8d" % (name, total, len(by_region[name])))
+
+    # RAM1 is allocated to ITCM in whole 32 KB banks, the rest is DTCM
+    itcm_end = max((s[0] + s[1] for s in by_region["ITCM"]), default=0)
+    itcm_banks = -(-itcm_end // RAM1_BANK)
+    dtcm_bytes = sum(s[1] for s in by_region["DTCM"])
+    print("\nRAM1: ITCM %d/%d banks (%d bytes used of %d), DTCM %d of %d bytes "
+          "(stack gets the rest)" % (itcm_banks, RAM1_BANKS, itcm_end, itcm_banks * RAM1_BANK,
+                                     dtcm_bytes, (RAM1_BANKS - itcm_banks) * RAM1_BANK))
+
+    for name, _, _ in REGIONS:
+        syms = sorted(by_region[name], key=lambda s: s[1], reverse=True)[:args.top]
+        if not syms:
+            continue
+        print("\n%s, largest %d:" % (name, len(syms)))
+        for addr, size, kind, sym in syms:
+            print("  %08x %8d %s %s" % (addr, size, kind, sym))
+
+    failures = []
+    located = {}
+    for addr, size, kind, name in symbols:
+        located.setdefault(base_name(name), []).append(region_of(addr))
+
+    for hot in HOT_SYMBOLS:
+        regions = located.get(hot)
+        if regions is None:
+            continue  # inlined or not linked in this configuration
+        if any(r != "ITCM" for r in regions):
+            failures.append("hot %s in %s" % (hot, ",".join(sorted(set(map(str, regions))))))
+
+    for bulk, allowed in BULK_SYMBOLS.items():
+        regions = located.get(bulk)
+        if regions is None:
+            failures.append("bulk %s not found" % bulk)
+        elif any(r not in allowed for r in regions):
+            failures.append("bulk %s in %s" % (bulk, ",".join(sorted(set(map(str, regions))))))
+
+    print("\nplacement policy: %s" % ("ok" if not failures else "FAILED"))
+    for f in failures:
+        print("  " + f)
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,57 @@
+/**
+ * pipeline_benchmark.cpp - Host Run of the Control Pipeline Benchmark
+ *
+ * Runs PipelineBenchmark (instinctus/PipelineBenchmark.h) on the desktop:
+ * the same stages, inputs and budgets as the Teensy build, with the wall
+ * clock scaled to cycles at Config::BENCH_REFERENCE_HZ and the p99 gate.
+ * A desktop core is several times faster than the M7, so passing here is
+ * necessary, not sufficient; it catches an accidental O(n) or a stray
+ * division in a hot stage at every commit without hardware. The budgets
+ * proper are checked on the Teensy (sketch built with -DINSTINCTUS_BENCH).
+ *
+ * Build and run (from the repo root):
+ *   g++ -std=gnu++17 -O2 -DINSTINCTUS_BENCH -Ihost/shim -Iconfig -Iinstinctus \
+ *       host/pipeline_benchmark.cpp \
+ *       instinctus/PipelineBenchmark.cpp \
+ *       instinctus/ComplementaryTiltEstimator.cpp \
+ *       instinctus/ODriveAxis.cpp \
+ *       instinctus/TelemetryWriter.cpp \
+ *       instinctus/TelemetryLink.cpp \
+ *       instinctus/TimeSync.cpp \
+ *       instinctus/TelemetryFrame.cpp \
+ *       -o /tmp/pipeline_benchmark
+ *   /tmp/pipeline_benchmark              # JSON lines on stdout
+ *
+ * Exit status 0 if every stage met its budget, 1 otherwise.
+ */
+
+#include <Arduino.h>
+#include <BoardConfig.h>
+#include "PipelineBenchmark.h"
+
+#include <stdio.h>
+#include <chrono>
+
+class StdoutPort : public Print {
+public:
+    size_t write(uint8_t b) override {
+        return fwrite(&b, 1, 1, stdout);
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override {
+        return fwrite(buffer, 1, size, stdout);
+    }
+};
+
+// Nanoseconds as cycles at the reference clock
+static uint32_t hostCycles() {
+    using namespace std::chrono;
+    uint64_t ns = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    return (uint32_t)(ns * (Config::BENCH_REFERENCE_HZ / 1000000) / 1000);
+}
+
+int main() {
+    StdoutPort out;
+    PipelineBenchmark::Options options = { nullptr, hostCycles, PipelineBenchmark::GATE_P99, "host" };
+    return PipelineBenchmark::run(options, out) ? 0 : 1;
+}
@@ -0,0 +1,700 @@
+/**
+ * replay_harness.cpp - Host Replay and Simulation of the Balance Pipeline
+ *
+ * Runs the firmware's own BalanceIMU, TiltEstimators, BalanceMotorController,
+ * DriveCoordinator / ODriveAxis (CANSimple encoding) and ToFSensor against
+ * mock hardware, on a simulated clock, as fast as the host allows:
+ * - ReplayIMU (IMUInterface) and ReplayToF (ToFInterface) hand out queued
+ *   samples once the simulated clock reaches their timestamps
+ * - SimCAN (CANInterface) decodes Set_Input_Vel, models each ODrive axis
+ *   as a first-order velocity loop, and answers with Encoder_Estimates
+ *   frames through the normal receive handler
+ *
+ * Sources:
+ *   (none)       closed loop: wheeled inverted pendulum plant with an
+ *                initial lean, a push and a velocity step. Truth is known.
+ *   FALLnnnn.BBX black-box recording, open loop: the recorded IMU samples,
+ *   RECnnnn.BBX  ToF distances and wheel speeds are replayed; tilt and
+ *                wheel command are compared against what the robot logged.
+ *   trace.csv    IMU trace in the tilt_benchmark format, open loop, wheels
+ *                held at zero speed.
+ *
+ * Every run is repeated for each TiltEstimator. Reported per run:
+ * - filter: tilt error, rms and max (deg), after a 1 s settle
+ * - control: closed loop: time until the lean tracks the controller's lean
+ *   setpoint within SETTLED_BAND_DEG after arming and after the push, peak
+ *   lean after the push, rms tracking error, fall. Replay: rms and max
+ *   difference between the host wheel command and the recorded one.
+ * - cost: host ns per balance tick (updateBatch + controller update),
+ *   mean / p99 / max. Host ns only rank changes against each other; for
+ *   Teensy cycles build the sketch with -DINSTINCTUS_PROFILE.
+ *
+ * Build and run (from the repo root):
+ *   g++ -std=gnu++17 -O2 -Ihost/shim -Iconfig -Iinstinctus \
+ *       host/replay_harness.cpp \
+ *       instinctus/BalanceIMU.cpp \
+ *       instinctus/ComplementaryTiltEstimator.cpp \
+ *       instinctus/MahonyTiltEstimator.cpp \
+ *       instinctus/PidController.cpp \
+ *       instinctus/BalanceMotorController.cpp \
+ *       instinctus/DriveCoordinator.cpp \
+ *       instinctus/ODriveAxis.cpp \
+ *       instinctus/ODriveCAN.cpp \
+ *       instinctus/ToFSensor.cpp \
+ *       instinctus/ToFTargetTracker.cpp \
+ *       instinctus/TelemetryWriter.cpp \
+ *       instinctus/TelemetryLink.cpp \
+ *       instinctus/TimeSync.cpp \
+ *       instinctus/TelemetryFrame.cpp \
+ *       -o /tmp/replay_harness
+ *   /tmp/replay_harness                 # closed-loop simulation
+ *   /tmp/replay_harness FALL0003.BBX    # black-box replay
+ *   /tmp/replay_harness recording.csv   # IMU trace replay
+ */
+
+#include <Arduino.h>
+#include <BalanceConfig.h>
+#include <BoardConfig.h>
+#include <IMUConfig.h>
+#include <MotorConfig.h>
+#include <ToFConfig.h>
+#include "BlackBoxFormat.h"
+#include "BalanceIMU.h"
+#include "BalanceMotorController.h"
+#include "ComplementaryTiltEstimator.h"
+#include "MahonyTiltEstimator.h"
+#include "DriveCoordinator.h"
+#include "EventBus.h"
+#include "FastMath.h"
+#include "ODriveAxis.h"
+#include "ODriveCAN.h"
+#include "ToFSensor.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+// Plant parameters for the closed-loop run. Rough figures for Calvin;
+// measure and update before trusting the response numbers.
+static const float COM_HEIGHT_M = 0.35f;       // wheel axle to centre of mass
+static const float WHEEL_RADIUS_M = 0.0825f;   // 6.5" hub motor
+static const float ODRIVE_VEL_TAU_S = 0.010f;  // axis velocity loop time constant
+
+static const uint32_t TICK_US = 1000000UL / Config::BALANCE_LOOP_HZ;
+static const uint32_t START_US = 1000000;      // arbitrary, nonzero
+static const float SETTLE_S = 1.0f;            // excluded from filter error
+static const float SETTLED_BAND_DEG = 2.0f;    // lean tracking band for settled / recovered
+
+// ---------------------------------------------------------------------------
+// Mock hardware
+
+class ReplayIMU : public IMUInterface {
+private:
+    std::vector<IMUSample> _samples;
+    size_t _next = 0;
+
+public:
+    void push(const IMUSample& sample) { _samples.push_back(sample); }
+    bool finished() const { return _next >= _samples.size(); }
+
+    bool initialize() override { return true; }
+
+    bool readSensors(float& accelX, float& accelY, float& accelZ,
+                     float& gyroX, float& gyroY, float& gyroZ) override {
+        IMUSample s;
+        if (readBatch(&s, 1) == 0) {
+            return false;
+        }
+        accelX = s.accelX; accelY = s.accelY; accelZ = s.accelZ;
+        gyroX = s.gyroX; gyroY = s.gyroY; gyroZ = s.gyroZ;
+        return true;
+    }
+
+    // Everything "acquired" up to now, like a FIFO drain
+    uint8_t readBatch(IMUSample* samples, uint8_t maxSamples) override {
+        uint8_t count = 0;
+        uint32_t now = micros();
+        while (count < maxSamples && _next < _samples.size() &&
+               (int32_t)(_samples[_next].timestampUs - now) <= 0) {
+            samples[count++] = _samples[_next++];
+        }
+        return count;
+    }
+
+    float getSamplePeriod() const override { return 1.0f / Config::IMU_GYRO_ODR_HZ; }
+};
+
+class ReplayToF : public ToFInterface {
+private:
+    struct Reading {
+        uint32_t timestampUs;
+        float distanceMm;
+    };
+    std::vector<Reading> _readings;
+    size_t _next = 0;
+
+public:
+    void push(uint32_t timestampUs, float distanceMm) { _readings.push_back({ timestampUs, distanceMm }); }
+
+    bool initialize() override { return true; }
+    bool startRanging() override { return true; }
+
+    bool isDataReady() const override {
+        return _next < _readings.size() && (int32_t)(_readings[_next].timestampUs - micros()) <= 0;
+    }
+
+    bool readDistance(float& distance) override {
+        if (!isDataReady()) {
+            return false;
+        }
+        // Skip to the newest reading, as the sensor would overwrite
+        while (_next + 1 < _readings.size() && (int32_t)(_readings[_next + 1].timestampUs - micros()) <= 0) {
+            _next++;
+        }
+        distance = _readings[_next++].distanceMm;
+        return true;
+    }
+};
+
+class SimCAN : public CANInterface {
+private:
+    struct Axis {
+        uint8_t nodeId;
+        float commandRevS;
+        float velocityRevS;
+        float positionRev;
+    };
+
+    ReceiveHandler _handler = nullptr;
+    void* _context = nullptr;
+    Axis _axes[2];
+    CANBusStats _stats = {};
+
+    Axis* find(uint8_t nodeId) {
+        for (Axis& a : _axes) {
+            if (a.nodeId == nodeId) {
+                return &a;
+            }
+        }
+        return nullptr;
+    }
+
+public:
+    SimCAN() : _axes{ { Config::MOTOR_LEFT.canId, 0, 0, 0 }, { Config::MOTOR_RIGHT.canId, 0, 0, 0 } } {}
+
+    bool begin(uint32_t) override { return true; }
+
+    bool write(const CANFrame& frame) override {
+        _stats.txFrames++;
+        _stats.txBits += canFrameBits(frame.len, frame.extended);
+        Axis* axis = find(frame.id >> ODriveAxis::NODE_SHIFT);
+        if (axis && (frame.id & ODriveAxis::CMD_MASK) == ODriveAxis::CMD_SET_INPUT_VEL && frame.len >= 4) {
+            memcpy(&axis->commandRevS, frame.data, sizeof(float));
+        }
+        return true;
+    }
+
+    void setReceiveHandler(ReceiveHandler handler, void* context) override {
+        _handler = handler;
+        _context = context;
+    }
+
+    void getStats(CANBusStats& stats) override { stats = _stats; }
+
+    /**
+     * Advance both axis velocity loops by dt
+     */
+    void step(float dt) {
+        for (Axis& a : _axes) {
+            a.velocityRevS += (a.commandRevS - a.velocityRevS) * (dt / (ODRIVE_VEL_TAU_S + dt));
+            a.positionRev += a.velocityRevS * dt;
+        }
+    }
+
+    /**
+     * Replay: force the measured speed of both wheels, in robot terms
+     */
+    void setWheelSpeed(float revS) {
+        _axes[0].velocityRevS = revS * Config::MOTOR_LEFT.direction;
+        _axes[1].velocityRevS = revS * Config::MOTOR_RIGHT.direction;
+    }
+
+    /**
+     * Mean forward wheel speed in robot terms, rev/s
+     */
+    float getWheelSpeed() const {
+        return 0.5f * (_axes[0].velocityRevS * Config::MOTOR_LEFT.direction +
+                       _axes[1].velocityRevS * Config::MOTOR_RIGHT.direction);
+    }
+
+    /**
+     * Cyclic Encoder_Estimates from both axes (the CAN ISR's job)
+     */
+    void sendEncoderEstimates() {
+        if (!_handler) {
+            return;
+        }
+        for (const Axis& a : _axes) {
+            CANFrame frame;
+            frame.id = ((uint32_t)a.nodeId << ODriveAxis::NODE_SHIFT) | ODriveAxis::CMD_ENCODER_ESTIMATES;
+            frame.len = 8;
+            frame.extended = false;
+            memcpy(&frame.data[0], &a.positionRev, 4);
+            memcpy(&frame.data[4], &a.velocityRevS, 4);
+            frame.timestampUs = micros();
+            _stats.rxFrames++;
+            _stats.rxBits += canFrameBits(frame.len, frame.extended);
+            _handler(_context, frame);
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Firmware objects, wired as in instinctus.ino
+
+struct Pipeline {
+    ReplayIMU imuHardware;
+    ReplayToF tofHardware;
+    SimCAN can;
+    EventBus bus;
+    BalanceIMU imu;
+    ToFSensor tof;
+    ODriveCAN odrive;
+    ODriveAxis left;
+    ODriveAxis right;
+    DriveCoordinator drive;
+    BalanceMotorController controller;
+    uint32_t obstacleEvents = 0;
+    uint32_t emergencyEvents = 0;
+
+    bool onObstacle(const ObstacleEvent&) { obstacleEvents++; return true; }
+    bool onEmergency(const BalanceEmergencyEvent&) { emergencyEvents++; return true; }
+
+    explicit Pipeline(TiltEstimator* estimator)
+        : imu(&imuHardware), tof(&tofHardware), odrive(&can),
+          left(&can, Config::MOTOR_LEFT.canId), right(&can, Config::MOTOR_RIGHT.canId),
+          drive(&left, &right), controller(&imu, &drive) {
+        bus.emergency.subscribe<BalanceMotorController, &BalanceMotorController::onBalanceEmergency>(
+            &controller, Dispatch::IMMEDIATE);
+        bus.emergency.subscribe<Pipeline, &Pipeline::onEmergency>(this, Dispatch::IMMEDIATE);
+        bus.obstacle.subscribe<Pipeline, &Pipeline::onObstacle>(this, Dispatch::DEFERRED);
+        tof.setEventBus(&bus, Telemetry::SENSOR_FRONT, Config::TOF_FRONT.warnDistanceMm);
+        tof.initialize();
+        imu.initialize();
+        imu.setEventBus(&bus);
+        imu.setEstimator(estimator);
+        odrive.addAxis(&left);
+        odrive.addAxis(&right);
+        odrive.begin(Config::CAN_BUS_SPEED);
+    }
+
+    /**
+     * One balance tick at the current simulated time; returns its host cost
+     */
+    double tick(uint32_t tickIndex) {
+        can.sendEncoderEstimates();
+
+        auto start = std::chrono::steady_clock::now();
+        imu.updateBatch();
+        controller.update();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        if (tickIndex % (Config::TOF_TASK_PERIOD_MS * Config::BALANCE_LOOP_HZ / 1000) == 0) {
+            tof.update();
+            bus.dispatchDeferred(Config::EVENT_DISPATCH_BUDGET);
+        }
+        return std::chrono::duration<double, std::nano>(elapsed).count();
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Statistics
+
+struct ErrorStats {
+    double sumSq = 0;
+    double max = 0;
+    size_t count = 0;
+
+    void add(double error) {
+        error = fabs(error);
+        sumSq += error * error;
+        if (error > max) {
+            max = error;
+        }
+        count++;
+    }
+
+    double rms() const { return count ? sqrt(sumSq / count) : 0.0; }
+};
+
+struct CostStats {
+    std::vector<double> ns;
+
+    double mean() const {
+        double sum = 0;
+        for (double v : ns) {
+            sum += v;
+        }
+        return ns.empty() ? 0.0 : sum / ns.size();
+    }
+
+    double percentile(double p) const {
+        if (ns.empty()) {
+            return 0.0;
+        }
+        std::vector<double> sorted(ns);
+        size_t k = (size_t)(p * (sorted.size() - 1));
+        std::nth_element(sorted.begin(), sorted.begin() + k, sorted.end());
+        return sorted[k];
+    }
+
+    double max() const { return ns.empty() ? 0.0 : *std::max_element(ns.begin(), ns.end()); }
+};
+
+static void printCost(const CostStats& cost) {
+    printf(" %8.0f %8.0f %8.0f", cost.mean(), cost.percentile(0.99), cost.max());
+}
+
+// ---------------------------------------------------------------------------
+// Closed loop: wheeled inverted pendulum, lean positive forward
+
+struct SimResult {
+    ErrorStats filter;
+    float settleMs = -1;
+    float pushPeakDeg = 0;
+    float recoverMs = -1;
+    ErrorStats tracking;
+    bool fell = false;
+    uint32_t obstacleEvents = 0;
+    double simSeconds = 0;
+    CostStats cost;
+};
+
+static SimResult runClosedLoop(TiltEstimator* estimator) {
+    const float g = 9.80665f;
+    const float imuDt = 1.0f / Config::IMU_GYRO_ODR_HZ;
+    const float armAtS = 1.0f;        // held upright by hand until here
+    const float pushAtS = 4.0f;       // +60 deg/s kick
+    const float moveAtS = 6.0f;       // 0.5 rev/s forward for 2 s
+    const float stopAtS = 8.0f;
+    const float endS = 10.0f;
+    const float wallMm = 600.0f;      // obstacle ahead of the start point
+
+    std::mt19937 rng(20240611);
+    std::normal_distribution<float> accelNoise(0.0f, 0.08f);
+    std::normal_distribution<float> gyroNoise(0.0f, 0.005f);
+    const float biasX = 0.010f, biasY = -0.008f, biasZ = 0.004f;
+
+    Pipeline p(estimator);
+    SimResult result;
+
+    float lean = FastMath::toRadians(5.0f);   // rad
+    float leanRate = 0;
+    float lastWheelSpeed = 0;
+    float travelM = 0;
+    float nextImuS = 0;
+    float nextToFS = 0;
+    std::vector<float> truthTilt;   // deg, atan2 convention, per IMU sample
+    std::vector<uint32_t> truthUs;
+    size_t truthNext = 0;
+    float lastOutsideMs = -1;
+    bool pushed = false;
+
+    const uint32_t ticks = (uint32_t)(endS * Config::BALANCE_LOOP_HZ);
+    for (uint32_t i = 0; i < ticks; i++) {
+        float t = i * (TICK_US * 1e-6f);
+        uint32_t nowUs = START_US + i * TICK_US;
+
+        // Plant, advanced in IMU-sample steps up to this tick
+        while (nextImuS <= t) {
+            float wheelSpeed = p.can.getWheelSpeed();
+            float accel = (wheelSpeed - lastWheelSpeed) / imuDt * 2.0f * FastMath::PI_F * WHEEL_RADIUS_M;
+            lastWheelSpeed = wheelSpeed;
+            bool held = nextImuS < armAtS;
+            if (!held && !result.fell) {
+                float leanAccel = (g * sinf(lean) - accel * cosf(lean)) / COM_HEIGHT_M;
+                leanRate += leanAccel * imuDt;
+                lean += leanRate * imuDt;
+                if (!pushed && nextImuS >= pushAtS) {
+                    leanRate += FastMath::toRadians(60.0f);
+                    pushed = true;
+                }
+            }
+            p.can.step(imuDt);
+            travelM += wheelSpeed * 2.0f * FastMath::PI_F * WHEEL_RADIUS_M * imuDt;
+
+            IMUSample s;
+            s.timestampUs = START_US + (uint32_t)(nextImuS * 1e6f);
+            s.accelX = cosf(lean) * accel - sinf(lean) * g + accelNoise(rng);
+            s.accelY = accelNoise(rng);
+            s.accelZ = sinf(lean) * accel + cosf(lean) * g + accelNoise(rng);
+            s.gyroX = biasX + gyroNoise(rng);
+            s.gyroY = leanRate + biasY + gyroNoise(rng);
+            s.gyroZ = biasZ + gyroNoise(rng);
+            p.imuHardware.push(s);
+            truthTilt.push_back(-FastMath::toDegrees(lean));
+            truthUs.push_back(s.timestampUs);
+            nextImuS += imuDt;
+        }
+        while (nextToFS <= t) {
+            p.tofHardware.push(START_US + (uint32_t)(nextToFS * 1e6f), wallMm - travelM * 1000.0f);
+            nextToFS += Config::TOF_FRONT.timingBudgetUs * 1e-6f;
+        }
+
+        if (i == (uint32_t)(armAtS * Config::BALANCE_LOOP_HZ)) {
+            p.controller.arm();
+        }
+        if (i == (uint32_t)(moveAtS * Config::BALANCE_LOOP_HZ)) {
+            p.controller.setVelocityTarget(0.5f);
+        }
+        if (i == (uint32_t)(stopAtS * Config::BALANCE_LOOP_HZ)) {
+            p.controller.setVelocityTarget(0.0f);
+        }
+
+        hostSetMicros(nowUs);
+        result.cost.ns.push_back(p.tick(i));
+
+        // Filter error against the truth of the newest consumed sample
+        while (truthNext + 1 < truthUs.size() && (int32_t)(truthUs[truthNext + 1] - p.imu.getLastSampleTimeUs()) <= 0) {
+            truthNext++;
+        }
+        if (t >= SETTLE_S) {
+            result.filter.add(p.imu.getTiltAngle() - truthTilt[truthNext]);
+        }
+
+        float leanDeg = FastMath::toDegrees(lean);
+        if (fabsf(leanDeg) > Config::EMERGENCY_TILT_ANGLE || p.controller.isEmergencyStopped()) {
+            result.fell = true;
+        }
+        if (t >= armAtS) {
+            // Against the outer loop's lean setpoint: braking a drift means
+            // leaning back on purpose
+            float trackingDeg = leanDeg - p.controller.getLeanSetpoint();
+            result.tracking.add(trackingDeg);
+            if (fabsf(trackingDeg) > SETTLED_BAND_DEG) {
+                lastOutsideMs = t * 1000.0f;
+            }
+        }
+        if (t < pushAtS && i + 1 == (uint32_t)(pushAtS * Config::BALANCE_LOOP_HZ)) {
+            result.settleMs = lastOutsideMs < 0 ? 0 : lastOutsideMs - armAtS * 1000.0f;
+            lastOutsideMs = -1;
+        }
+        if (t >= pushAtS && t < moveAtS && fabsf(leanDeg) > fabsf(result.pushPeakDeg)) {
+            result.pushPeakDeg = leanDeg;
+        }
+        if (t < moveAtS && i + 1 == (uint32_t)(moveAtS * Config::BALANCE_LOOP_HZ)) {
+            result.recoverMs = lastOutsideMs < 0 ? 0 : lastOutsideMs - pushAtS * 1000.0f;
+        }
+    }
+
+    result.obstacleEvents = p.obstacleEvents;
+    result.simSeconds = endS;
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Open loop: recorded data
+
+struct ReplayRecord {
+    IMUSample imu;
+    float tiltDeg;            // recorded estimate (BBX) or truth (CSV)
+    bool hasTilt;
+    float wheelSpeedRevS;
+    float wheelCommandRevS;
+    bool hasCommand;          // recorded controller was armed
+    float frontMm;            // < 0: no reading
+};
+
+struct ReplayResult {
+    ErrorStats filter;
+    ErrorStats command;
+    uint32_t emergencies = 0;
+    uint32_t obstacleEvents = 0;
+    double simSeconds = 0;
+    CostStats cost;
+};
+
+static bool loadBbx(const char* path, std::vector<ReplayRecord>& trace) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        return false;
+    }
+    BlackBoxFileHeader header;
+    if (fread(&header, sizeof(header), 1, f) != 1 ||
+        memcmp(header.magic, BLACKBOX_MAGIC, sizeof(header.magic)) != 0 ||
+        header.recordSize != sizeof(BlackBoxRecord)) {
+        fclose(f);
+        return false;
+    }
+    if (header.version != BLACKBOX_FORMAT_VERSION) {
+        fprintf(stderr, "warning: %s is format version %u, harness reads %u\n",
+                path, header.version, BLACKBOX_FORMAT_VERSION);
+    }
+
+    BlackBoxRecord r;
+    int16_t lastFront = INT16_MIN;
+    while (fread(&r, sizeof(r), 1, f) == 1) {
+        ReplayRecord t;
+        t.imu.timestampUs = r.timestampUs;
+        t.imu.accelX = r.accel[0];
+        t.imu.accelY = r.accel[1];
+        t.imu.accelZ = r.accel[2];
+        t.imu.gyroX = r.gyro[0];
+        t.imu.gyroY = r.gyro[1];
+        t.imu.gyroZ = r.gyro[2];
+        t.tiltDeg = r.tiltDeg;
+        t.hasTilt = true;
+        t.wheelSpeedRevS = r.wheelSpeedRevS;
+        t.wheelCommandRevS = r.wheelCommandRevS;
+        t.hasCommand = r.controllerState == BalanceMotorController::STATE_ARMED;
+        // The recorder repeats the last distance every tick; a change marks a new reading
+        t.frontMm = (r.frontMm != lastFront) ? r.frontMm : -1.0f;
+        lastFront = r.frontMm;
+        trace.push_back(t);
+    }
+    fclose(f);
+    return !trace.empty();
+}
+
+static bool loadCsv(const char* path, std::vector<ReplayRecord>& trace) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        return false;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        ReplayRecord t = {};
+        unsigned long ts;
+        int n = sscanf(line, "%lu , %f , %f , %f , %f , %f , %f , %f", &ts,
+                       &t.imu.accelX, &t.imu.accelY, &t.imu.accelZ,
+                       &t.imu.gyroX, &t.imu.gyroY, &t.imu.gyroZ, &t.tiltDeg);
+        if (n < 7) {
+            continue;
+        }
+        t.imu.timestampUs = (uint32_t)ts;
+        t.hasTilt = (n == 8);
+        t.frontMm = -1.0f;
+        trace.push_back(t);
+    }
+    fclose(f);
+    return !trace.empty();
+}
+
+static ReplayResult runReplay(TiltEstimator* estimator, const std::vector<ReplayRecord>& trace) {
+    Pipeline p(estimator);
+    ReplayResult result;
+
+    for (const ReplayRecord& r : trace) {
+        p.imuHardware.push(r.imu);
+        if (r.frontMm >= 0) {
+            p.tofHardware.push(r.imu.timestampUs, r.frontMm);
+        }
+    }
+
+    // Arm with the recorded controller, or straight away if it never was
+    bool recordedArmed = false;
+    for (const ReplayRecord& r : trace) {
+        recordedArmed |= r.hasCommand;
+    }
+    bool armed = false;
+
+    uint32_t firstUs = trace.front().imu.timestampUs;
+    uint32_t lastUs = trace.back().imu.timestampUs;
+    size_t next = 0;
+    for (uint32_t i = 0; (int32_t)(firstUs + i * TICK_US - lastUs) <= 0; i++) {
+        uint32_t nowUs = firstUs + i * TICK_US;
+
+        // Latest record acquired by now drives the wheel feedback
+        while (next + 1 < trace.size() && (int32_t)(trace[next + 1].imu.timestampUs - nowUs) <= 0) {
+            next++;
+        }
+        const ReplayRecord& r = trace[next];
+        p.can.setWheelSpeed(r.wheelSpeedRevS);
+        if (!armed && (r.hasCommand || !recordedArmed)) {
+            hostSetMicros(nowUs);
+            p.can.sendEncoderEstimates();
+            armed = p.controller.arm();
+        }
+
+        hostSetMicros(nowUs);
+        result.cost.ns.push_back(p.tick(i));
+
+        if ((uint32_t)(nowUs - firstUs) >= (uint32_t)(SETTLE_S * 1e6f)) {
+            if (r.hasTilt) {
+                result.filter.add(p.imu.getTiltAngle() - r.tiltDeg);
+            }
+            if (r.hasCommand && p.controller.getState() == BalanceMotorController::STATE_ARMED) {
+                result.command.add(p.controller.getWheelCommand() - r.wheelCommandRevS);
+            }
+        }
+    }
+
+    result.emergencies = p.emergencyEvents;
+    result.obstacleEvents = p.obstacleEvents;
+    result.simSeconds = (lastUs - firstUs) * 1e-6;
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+
+static bool endsWith(const char* s, const char* suffix) {
+    size_t n = strlen(s), m = strlen(suffix);
+    return n >= m && strcasecmp(s + n - m, suffix) == 0;
+}
+
+int main(int argc, char** argv) {
+    ComplementaryTiltEstimator complementary;
+    MahonyTiltEstimator mahony;
+    TiltEstimator* estimators[] = { &complementary, &mahony };
+
+    auto wallStart = std::chrono::steady_clock::now();
+    double simSeconds = 0;
+
+    if (argc < 2) {
+        printf("source: closed-loop simulation, COM %.2f m, wheel r %.4f m, sketch default = %s\n",
+               COM_HEIGHT_M, WHEEL_RADIUS_M, Config::TILT_USE_MAHONY ? "mahony" : "complementary");
+        printf("%-14s %8s %8s | %8s %9s %9s %8s %5s %4s | %8s %8s %8s\n",
+               "estimator", "rms deg", "max deg", "settle", "push deg", "recover", "rms trk",
+               "fell", "obst", "ns mean", "ns p99", "ns max");
+        for (TiltEstimator* e : estimators) {
+            SimResult r = runClosedLoop(e);
+            simSeconds += r.simSeconds;
+            printf("%-14s %8.3f %8.3f | %6.0fms %9.2f %7.0fms %8.3f %5s %4u |",
+                   e->getName(), r.filter.rms(), r.filter.max, r.settleMs, r.pushPeakDeg,
+                   r.recoverMs, r.tracking.rms(), r.fell ? "YES" : "no", r.obstacleEvents);
+            printCost(r.cost);
+            printf("\n");
+        }
+    } else {
+        std::vector<ReplayRecord> trace;
+        bool bbx = endsWith(argv[1], ".bbx");
+        if (!(bbx ? loadBbx(argv[1], trace) : loadCsv(argv[1], trace))) {
+            fprintf(stderr, "cannot read %s\n", argv[1]);
+            return 1;
+        }
+        printf("source: %s, %zu records, tilt reference = %s\n", argv[1], trace.size(),
+               bbx ? "recorded estimate" : (trace[0].hasTilt ? "truth" : "none"));
+        printf("%-14s %8s %8s | %8s %8s %5s %4s | %8s %8s %8s\n",
+               "estimator", "rms deg", "max deg", "cmd rms", "cmd max", "estop", "obst",
+               "ns mean", "ns p99", "ns max");
+        for (TiltEstimator* e : estimators) {
+            ReplayResult r = runReplay(e, trace);
+            simSeconds += r.simSeconds;
+            printf("%-14s %8.3f %8.3f | %8.3f %8.3f %5u %4u |",
+                   e->getName(), r.filter.rms(), r.filter.max, r.command.rms(), r.command.max,
+                   r.emergencies, r.obstacleEvents);
+            printCost(r.cost);
+            printf("\n");
+        }
+    }
+
+    double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    printf("simulated %.1f s in %.3f s (%.0fx real time)\n", simSeconds, wallS, simSeconds / wallS);
+    return 0;
+}
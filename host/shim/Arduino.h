@@ -0,0 +1,68 @@
+#ifndef HOST_ARDUINO_SHIM_H
+#define HOST_ARDUINO_SHIM_H
+
+// Minimal stand-in for the Arduino core so hardware-independent modules
+// (estimators, controller, ODrive protocol, framing) build on a desktop
+// compiler. Only what those modules actually use is provided; anything
+// touching registers or pins stays target-only. Interrupt masking is a
+// no-op: host builds are single threaded.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+// Section placement (MemoryPlacement.h) has no meaning on the host
+#define FASTRUN
+#define FLASHMEM
+#define DMAMEM
+#define EXTMEM
+
+// Replay harnesses drive time themselves: after hostSetMicros(), micros()
+// returns the simulated clock instead of the wall clock.
+inline bool hostClockManual = false;
+inline uint32_t hostClockUs = 0;
+
+inline void hostSetMicros(uint32_t us) {
+    hostClockManual = true;
+    hostClockUs = us;
+}
+
+inline uint32_t micros() {
+    if (hostClockManual) {
+        return hostClockUs;
+    }
+    using namespace std::chrono;
+    static const steady_clock::time_point start = steady_clock::now();
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now() - start).count();
+}
+
+inline uint32_t millis() {
+    return micros() / 1000;
+}
+
+inline void noInterrupts() {}
+inline void interrupts() {}
+inline void __disable_irq() {}
+inline void __enable_irq() {}
+
+class Print {
+public:
+    virtual size_t write(uint8_t b) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+        while (size--) {
+            n += write(*buffer++);
+        }
+        return n;
+    }
+    virtual int availableForWrite() { return 0; }
+    virtual ~Print() = default;
+};
+
+#endif // HOST_ARDUINO_SHIM_H
@@ -0,0 +1,196 @@
+/**
+ * tilt_benchmark.cpp - Host Benchmark for the TiltEstimator Implementations
+ *
+ * Runs every estimator over the same IMU trace and reports tilt error
+ * against ground truth plus the cost per update. The trace is either a
+ * recorded CSV or a deterministic synthetic run that mixes balancing
+ * sway with hard wheel acceleration (the case the complementary filter
+ * handles worst).
+ *
+ * Build and run (from the repo root):
+ *   g++ -std=gnu++17 -O2 -Ihost/shim -Iconfig -Iinstinctus \
+ *       host/tilt_benchmark.cpp \
+ *       instinctus/ComplementaryTiltEstimator.cpp \
+ *       instinctus/MahonyTiltEstimator.cpp \
+ *       -o /tmp/tilt_benchmark
+ *   /tmp/tilt_benchmark                 # synthetic trace
+ *   /tmp/tilt_benchmark recording.csv   # recorded trace
+ *
+ * CSV format (robot frame, one sample per line, '#' starts a comment):
+ *   timestamp_us, ax, ay, az, gx, gy, gz [, truth_deg]
+ * accel in m/s², gyro in rad/s. Without a truth column, the error columns
+ * are measured against the Mahony estimate instead.
+ *
+ * Cost is host nanoseconds, useful for comparing estimators with each
+ * other. For Teensy cycle counts build the sketch with -DINSTINCTUS_PROFILE
+ * and read the "balance" probe.
+ */
+
+#include <Arduino.h>
+#include <BalanceConfig.h>
+#include <IMUConfig.h>
+#include "TiltEstimator.h"
+#include "ComplementaryTiltEstimator.h"
+#include "MahonyTiltEstimator.h"
+#include "FastMath.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <random>
+#include <vector>
+
+struct TraceSample {
+    IMUSample imu;
+    float truthDeg;
+    bool hasTruth;
+};
+
+static bool loadCsv(const char* path, std::vector<TraceSample>& trace) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        return false;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        TraceSample t;
+        unsigned long ts;
+        int n = sscanf(line, "%lu , %f , %f , %f , %f , %f , %f , %f", &ts,
+                       &t.imu.accelX, &t.imu.accelY, &t.imu.accelZ,
+                       &t.imu.gyroX, &t.imu.gyroY, &t.imu.gyroZ, &t.truthDeg);
+        if (n < 7) {
+            continue;
+        }
+        t.imu.timestampUs = (uint32_t)ts;
+        t.hasTruth = (n == 8);
+        trace.push_back(t);
+    }
+    fclose(f);
+    return !trace.empty();
+}
+
+// Tilt profile (accelerometer atan2(x, z) convention) and forward wheel
+// acceleration, at the gyro ODR for 30 s. Body pitch about +Y is -tilt.
+static void synthesize(std::vector<TraceSample>& trace) {
+    const float g = 9.80665f;
+    const float rateHz = Config::IMU_GYRO_ODR_HZ;
+    const float duration = 30.0f;
+    const float dt = 1.0f / rateHz;
+
+    std::mt19937 rng(20240611);
+    std::normal_distribution<float> accelNoise(0.0f, 0.08f);
+    std::normal_distribution<float> gyroNoise(0.0f, 0.005f);
+    const float biasX = 0.010f, biasY = -0.008f, biasZ = 0.004f;
+
+    for (int i = 0; i < (int)(duration * rateHz); i++) {
+        float t = i * dt;
+
+        // Balancing sway
+        float tilt = 4.0f * sinf(2.0f * FastMath::PI_F * 0.7f * t);
+        float tiltRate = 4.0f * 2.0f * FastMath::PI_F * 0.7f * cosf(2.0f * FastMath::PI_F * 0.7f * t);
+
+        // From 10 s: 0.4 s wheel acceleration bursts of +/-4 m/s² every 2 s
+        float linear = 0.0f;
+        if (t > 10.0f) {
+            float phase = fmodf(t - 10.0f, 2.0f);
+            if (phase < 0.4f) {
+                linear = 4.0f;
+            } else if (phase > 1.0f && phase < 1.4f) {
+                linear = -4.0f;
+            }
+        }
+
+        float pitch = FastMath::toRadians(-tilt);
+        float pitchRate = FastMath::toRadians(-tiltRate);
+
+        TraceSample s;
+        s.imu.timestampUs = (uint32_t)(t * 1e6f);
+        s.imu.accelX = cosf(pitch) * linear - sinf(pitch) * g + accelNoise(rng);
+        s.imu.accelY = accelNoise(rng);
+        s.imu.accelZ = sinf(pitch) * linear + cosf(pitch) * g + accelNoise(rng);
+        s.imu.gyroX = biasX + gyroNoise(rng);
+        s.imu.gyroY = pitchRate + biasY + gyroNoise(rng);
+        s.imu.gyroZ = biasZ + gyroNoise(rng);
+        s.truthDeg = tilt;
+        s.hasTruth = true;
+        trace.push_back(s);
+    }
+}
+
+static void runEstimator(TiltEstimator& estimator, const std::vector<TraceSample>& trace,
+                         std::vector<float>& output, double& nsPerUpdate) {
+    const int repeats = 20;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; r++) {
+        estimator.reset();
+        uint32_t lastUs = trace[0].imu.timestampUs;
+        for (size_t i = 0; i < trace.size(); i++) {
+            float dt = (uint32_t)(trace[i].imu.timestampUs - lastUs) * 1e-6f;
+            if (dt > Config::MAX_FILTER_DT_S) {
+                dt = Config::MAX_FILTER_DT_S;
+            }
+            lastUs = trace[i].imu.timestampUs;
+            output[i] = estimator.update(trace[i].imu, dt);
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    nsPerUpdate = std::chrono::duration<double, std::nano>(elapsed).count() /
+                  ((double)repeats * trace.size());
+}
+
+int main(int argc, char** argv) {
+    std::vector<TraceSample> trace;
+    if (argc > 1) {
+        if (!loadCsv(argv[1], trace)) {
+            fprintf(stderr, "cannot read trace %s\n", argv[1]);
+            return 1;
+        }
+    } else {
+        synthesize(trace);
+    }
+
+    ComplementaryTiltEstimator complementary;
+    MahonyTiltEstimator mahony;
+    TiltEstimator* estimators[] = { &complementary, &mahony };
+    const size_t count = sizeof(estimators) / sizeof(estimators[0]);
+
+    std::vector<std::vector<float>> outputs(count, std::vector<float>(trace.size()));
+    double cost[count];
+    for (size_t e = 0; e < count; e++) {
+        runEstimator(*estimators[e], trace, outputs[e], cost[e]);
+    }
+
+    // Reference: truth when recorded, otherwise the Mahony estimate
+    bool haveTruth = trace[0].hasTruth;
+    const std::vector<float>& mahonyOut = outputs[count - 1];
+
+    // Skip the first 2 s so start-up convergence doesn't dominate
+    uint32_t settleUs = trace[0].imu.timestampUs + 2000000;
+
+    printf("trace: %zu samples, %s, reference = %s\n", trace.size(),
+           argc > 1 ? argv[1] : "synthetic", haveTruth ? "truth" : "mahony");
+    printf("%-16s %10s %10s %10s\n", "estimator", "rms deg", "max deg", "ns/update");
+    for (size_t e = 0; e < count; e++) {
+        double sumSq = 0;
+        double maxErr = 0;
+        size_t n = 0;
+        for (size_t i = 0; i < trace.size(); i++) {
+            if ((int32_t)(trace[i].imu.timestampUs - settleUs) < 0) {
+                continue;
+            }
+            float reference = haveTruth ? trace[i].truthDeg : mahonyOut[i];
+            double err = fabs(outputs[e][i] - reference);
+            sumSq += err * err;
+            if (err > maxErr) {
+                maxErr = err;
+            }
+            n++;
+        }
+        printf("%-16s %10.3f %10.3f %10.1f\n", estimators[e]->getName(),
+               n ? sqrt(sumSq / n) : 0.0, maxErr, cost[e]);
+    }
+    return 0;
+}
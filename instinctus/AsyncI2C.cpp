@@ -0,0 +1,281 @@
+/**
+ * AsyncI2C.cpp - Interrupt-Driven LPI2C Master Implementation
+ *
+ * The LPI2C master is command driven: each word written to MTDR is either
+ * a START (with address), a data byte, a RECEIVE request or a STOP. The ISR
+ * walks a small phase machine to generate those words while the 4-entry TX
+ * FIFO has room, drains received bytes from MRDR, and finishes on the STOP
+ * detect flag.
+ *
+ * Implementation Notes:
+ * - RECEIVE takes (count - 1) in its data field and is limited to 256 bytes,
+ *   so longer reads queue several RECEIVE commands back to back
+ * - NACK, arbitration loss, FIFO error or pin low timeout end the transfer
+ *   with ok = false; both FIFOs are flushed and a STOP is issued if the
+ *   master still owns the bus; checkTimeout() tears a stuck transfer
+ *   down the same way
+ * - MFCR is saved and restored so TwoWire finds the watermarks it set
+ */
+
+#include "AsyncI2C.h"
+#include "MemoryPlacement.h"
+
+static IMXRT_LPI2C_t* const LPI2C_PORTS[AsyncI2C::NUM_PORTS] = {
+    &IMXRT_LPI2C1, &IMXRT_LPI2C3, &IMXRT_LPI2C4
+};
+
+static const IRQ_NUMBER_t LPI2C_IRQS[AsyncI2C::NUM_PORTS] = {
+    IRQ_LPI2C1, IRQ_LPI2C3, IRQ_LPI2C4
+};
+
+static constexpr uint32_t LPI2C_FIFO_DEPTH = 4;
+static constexpr uint32_t MSR_ERROR_FLAGS =
+    LPI2C_MSR_NDF | LPI2C_MSR_ALF | LPI2C_MSR_FEF | LPI2C_MSR_PLTF;
+
+AsyncI2C* AsyncI2C::_instances[AsyncI2C::NUM_PORTS] = {nullptr, nullptr, nullptr};
+
+HOT_CODE void AsyncI2C::isr0() { _instances[0]->handleInterrupt(); }
+HOT_CODE void AsyncI2C::isr1() { _instances[1]->handleInterrupt(); }
+HOT_CODE void AsyncI2C::isr2() { _instances[2]->handleInterrupt(); }
+
+AsyncI2C::AsyncI2C(uint8_t port)
+    : _port(port), _phase(PHASE_IDLE), _address(0),
+      _tx(nullptr), _txLen(0), _txIndex(0),
+      _rx(nullptr), _rxLen(0), _rxQueued(0), _rxIndex(0),
+      _savedFifoControl(0), _callback(nullptr), _context(nullptr),
+      _completed(0), _errors(0), _timeouts(0), _startUs(0), _lastOk(false) {
+}
+
+COLD_CODE bool AsyncI2C::begin(uint8_t priority) {
+    if (_port >= NUM_PORTS) {
+        return false;
+    }
+    static void (* const handlers[NUM_PORTS])() = { isr0, isr1, isr2 };
+
+    _instances[_port] = this;
+    LPI2C_PORTS[_port]->MIER = 0;
+    attachInterruptVector(LPI2C_IRQS[_port], handlers[_port]);
+    NVIC_SET_PRIORITY(LPI2C_IRQS[_port], priority);
+    NVIC_ENABLE_IRQ(LPI2C_IRQS[_port]);
+    return true;
+}
+
+COLD_CODE bool AsyncI2C::begin(uint8_t priority, uint32_t clockHz) {
+    TwoWire* wire = wireForPort(_port);
+    if (!wire) {
+        return false;
+    }
+    wire->begin();
+    wire->setClock(clockHz);
+    return begin(priority);
+}
+
+TwoWire* AsyncI2C::wireForPort(uint8_t port) {
+    switch (port) {
+        case 0: return &Wire;
+        case 1: return &Wire1;
+        case 2: return &Wire2;
+        default: return nullptr;
+    }
+}
+
+HOT_CODE bool AsyncI2C::startTransfer(uint8_t address, const uint8_t* tx, uint8_t txLen,
+                             uint8_t* rx, uint16_t rxLen,
+                             Callback callback, void* context) {
+    if (_port >= NUM_PORTS || (txLen == 0 && rxLen == 0) || (rxLen && !rx)) {
+        return false;
+    }
+    if (_phase != PHASE_IDLE) {
+        return false;
+    }
+
+    IMXRT_LPI2C_t* port = LPI2C_PORTS[_port];
+
+    _address = address;
+    _tx = tx;
+    _txLen = txLen;
+    _txIndex = 0;
+    _rx = rx;
+    _rxLen = rxLen;
+    _rxQueued = 0;
+    _rxIndex = 0;
+    _callback = callback;
+    _context = context;
+    _phase = (txLen > 0) ? PHASE_START_WRITE : PHASE_START_READ;
+    _startUs = micros();
+
+    // RDF as soon as one byte lands, TDF while the TX FIFO has room
+    _savedFifoControl = port->MFCR;
+    port->MFCR = LPI2C_MFCR_RXWATER(0) | LPI2C_MFCR_TXWATER(LPI2C_FIFO_DEPTH - 1);
+    port->MCR |= LPI2C_MCR_RTF | LPI2C_MCR_RRF;
+    port->MSR = 0x7F00;  // clear all write-1-to-clear status flags
+
+    port->MIER = LPI2C_MIER_TDIE | LPI2C_MIER_RDIE | LPI2C_MIER_SDIE |
+                 LPI2C_MIER_NDIE | LPI2C_MIER_ALIE | LPI2C_MIER_FEIE |
+                 LPI2C_MIER_PLTIE;
+    return true;
+}
+
+bool AsyncI2C::transferBlocking(uint8_t address, const uint8_t* tx, uint8_t txLen,
+                                uint8_t* rx, uint16_t rxLen, uint32_t timeoutUs) {
+    uint32_t before = _completed;
+    if (!startTransfer(address, tx, txLen, rx, rxLen, nullptr, nullptr)) {
+        return false;
+    }
+    uint32_t start = micros();
+    while (_completed == before) {
+        if (micros() - start > timeoutUs) {
+            __disable_irq();
+            if (_phase != PHASE_IDLE) {
+                abort();
+            }
+            __enable_irq();
+            return false;
+        }
+    }
+    return _lastOk;
+}
+
+HOT_CODE bool AsyncI2C::nextCommand(uint32_t& command) {
+    switch (_phase) {
+        case PHASE_START_WRITE:
+            command = LPI2C_MTDR_CMD_START | (uint32_t)(_address << 1);
+            _phase = PHASE_TX;
+            return true;
+
+        case PHASE_TX:
+            command = LPI2C_MTDR_CMD_TRANSMIT | _tx[_txIndex++];
+            if (_txIndex >= _txLen) {
+                _phase = (_rxLen > 0) ? PHASE_START_READ : PHASE_STOP;
+            }
+            return true;
+
+        case PHASE_START_READ:
+            command = LPI2C_MTDR_CMD_START | (uint32_t)(_address << 1) | 1;
+            _phase = PHASE_RX;
+            return true;
+
+        case PHASE_RX: {
+            uint16_t chunk = _rxLen - _rxQueued;
+            if (chunk > 256) {
+                chunk = 256;
+            }
+            command = LPI2C_MTDR_CMD_RECEIVE | (uint32_t)(chunk - 1);
+            _rxQueued += chunk;
+            if (_rxQueued >= _rxLen) {
+                _phase = PHASE_STOP;
+            }
+            return true;
+        }
+
+        case PHASE_STOP:
+            command = LPI2C_MTDR_CMD_STOP;
+            _phase = PHASE_WAIT_STOP;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+HOT_CODE void AsyncI2C::handleInterrupt() {
+    IMXRT_LPI2C_t* port = LPI2C_PORTS[_port];
+    uint32_t status = port->MSR;
+
+    if (_phase == PHASE_IDLE) {
+        port->MIER = 0;
+        port->MSR = status & 0x7F00;
+        return;
+    }
+
+    if (status & MSR_ERROR_FLAGS) {
+        port->MCR |= LPI2C_MCR_RTF | LPI2C_MCR_RRF;
+        port->MSR = status & 0x7F00;
+        if (port->MSR & LPI2C_MSR_MBF) {
+            port->MTDR = LPI2C_MTDR_CMD_STOP;
+        }
+        finish(false);
+        return;
+    }
+
+    // Drain whatever the RX FIFO holds
+    uint32_t rxCount = (port->MFSR >> 16) & 0x07;
+    while (rxCount--) {
+        uint8_t data = (uint8_t)port->MRDR;
+        if (_rxIndex < _rxLen) {
+            _rx[_rxIndex++] = data;
+        }
+    }
+
+    // Refill the TX FIFO with the next commands
+    uint32_t txCount = port->MFSR & 0x07;
+    uint32_t command;
+    while (txCount < LPI2C_FIFO_DEPTH && nextCommand(command)) {
+        port->MTDR = command;
+        txCount++;
+    }
+    if (_phase == PHASE_WAIT_STOP) {
+        port->MIER &= ~LPI2C_MIER_TDIE;
+    }
+
+    if (status & LPI2C_MSR_SDF) {
+        port->MSR = LPI2C_MSR_SDF;
+        finish(_rxIndex == _rxLen);
+    }
+}
+
+HOT_CODE void AsyncI2C::finish(bool ok) {
+    IMXRT_LPI2C_t* port = LPI2C_PORTS[_port];
+    port->MIER = 0;
+    port->MFCR = _savedFifoControl;
+
+    _phase = PHASE_IDLE;
+    _lastOk = ok;
+    if (!ok) {
+        _errors = _errors + 1;
+    }
+    _completed = _completed + 1;
+
+    if (_callback) {
+        _callback(_context, ok);
+    }
+}
+
+// Interrupts off: the ISR must not see the transfer half torn down
+void AsyncI2C::abort() {
+    IMXRT_LPI2C_t* port = LPI2C_PORTS[_port];
+    port->MCR |= LPI2C_MCR_RTF | LPI2C_MCR_RRF;
+    port->MSR = 0x7F00;
+    if (port->MSR & LPI2C_MSR_MBF) {
+        port->MTDR = LPI2C_MTDR_CMD_STOP;
+    }
+    _timeouts = _timeouts + 1;
+    finish(false);
+}
+
+bool AsyncI2C::checkTimeout(uint32_t timeoutUs) {
+    bool aborted = false;
+    __disable_irq();
+    if (_phase != PHASE_IDLE && micros() - _startUs > timeoutUs) {
+        abort();
+        aborted = true;
+    }
+    __enable_irq();
+    return aborted;
+}
+
+bool AsyncI2C::isBusy() const {
+    return _phase != PHASE_IDLE;
+}
+
+uint32_t AsyncI2C::getCompletedCount() const {
+    return _completed;
+}
+
+uint32_t AsyncI2C::getErrorCount() const {
+    return _errors;
+}
+
+uint32_t AsyncI2C::getTimeoutCount() const {
+    return _timeouts;
+}
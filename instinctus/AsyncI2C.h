@@ -0,0 +1,145 @@
+#ifndef ASYNC_I2C_H
+#define ASYNC_I2C_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+/**
+ * AsyncI2C.h - Interrupt-Driven I2C Master Transactions for the i.MX RT1062
+ *
+ * TwoWire on the Teensy 4 polls the LPI2C status register until a transfer
+ * is done, so every read stalls the caller for the full bus time. AsyncI2C
+ * drives the same LPI2C peripheral from its interrupt instead: a transfer
+ * is started with one call, the FIFO is fed and drained by the ISR, and a
+ * completion callback fires when the STOP has gone out.
+ *
+ * Supported transfer shape (all a register-mapped sensor needs):
+ *   START addr+W, txLen bytes, [repeated START addr+R, rxLen bytes], STOP
+ *
+ * Ports:
+ *   0 = Wire (LPI2C1), 1 = Wire1 (LPI2C3), 2 = Wire2 (LPI2C4)
+ * Each port has its own instance and interrupt, so transfers on different
+ * ports run concurrently; bus assignments live in BoardConfig.h.
+ *
+ * Notes:
+ * - The port must already be configured by TwoWire::begin() (pins, clock,
+ *   bus timing). AsyncI2C only issues commands; it never reprograms timing.
+ * - TwoWire and AsyncI2C may share a port as long as they never overlap a
+ *   transfer (see I2CBusGuard).
+ * - The completion callback runs in the LPI2C ISR. Keep it short.
+ * - A transfer the peripheral never finishes (e.g. a slave holding SCL
+ *   low below the pin low timeout) stays in flight until checkTimeout()
+ *   aborts it; the callback then runs with ok = false.
+ *
+ * Usage:
+ *   AsyncI2C bus(0);
+ *   bus.begin(64);
+ *   bus.startTransfer(0x69, &reg, 1, buf, 12, onDone, this);
+ */
+class AsyncI2C {
+public:
+    typedef void (*Callback)(void* context, bool ok);
+
+    static constexpr uint8_t NUM_PORTS = 3;
+
+private:
+    enum Phase : uint8_t {
+        PHASE_IDLE,
+        PHASE_START_WRITE,
+        PHASE_TX,
+        PHASE_START_READ,
+        PHASE_RX,
+        PHASE_STOP,
+        PHASE_WAIT_STOP
+    };
+
+    uint8_t _port;
+    volatile Phase _phase;
+    uint8_t _address;
+    const uint8_t* _tx;
+    uint8_t _txLen;
+    uint8_t _txIndex;
+    uint8_t* _rx;
+    uint16_t _rxLen;
+    uint16_t _rxQueued;     // bytes requested via RECEIVE commands so far
+    uint16_t _rxIndex;      // bytes drained from the RX FIFO so far
+    uint32_t _savedFifoControl;
+    Callback _callback;
+    void* _context;
+
+    volatile uint32_t _completed;
+    volatile uint32_t _errors;
+    volatile uint32_t _timeouts;
+    uint32_t _startUs;
+    volatile bool _lastOk;
+
+    static AsyncI2C* _instances[NUM_PORTS];
+    static void isr0();
+    static void isr1();
+    static void isr2();
+
+    bool nextCommand(uint32_t& command);
+    void handleInterrupt();
+    void finish(bool ok);
+    void abort();
+
+public:
+    /**
+     * Constructor
+     * @param port - 0 = Wire, 1 = Wire1, 2 = Wire2
+     */
+    explicit AsyncI2C(uint8_t port);
+
+    /**
+     * Install the interrupt handler
+     * @param priority - NVIC priority for the LPI2C interrupt
+     * @return false if the port number is invalid
+     */
+    bool begin(uint8_t priority);
+
+    /**
+     * Bring up the port's TwoWire (pins, timing) at clockHz, then install
+     * the interrupt handler
+     */
+    bool begin(uint8_t priority, uint32_t clockHz);
+
+    /**
+     * TwoWire instance for a port, for drivers built on the Wire API
+     * @return nullptr if the port number is invalid
+     */
+    static TwoWire* wireForPort(uint8_t port);
+
+    /**
+     * Start a transfer without waiting for it.
+     * @param address - 7-bit device address
+     * @param tx, txLen - bytes to write first (usually the register address)
+     * @param rx, rxLen - destination for the read phase (rxLen 0 = write only)
+     * @param callback - called from the ISR on completion (may be null)
+     * @param context - passed through to callback
+     * @return false if a transfer is already in flight or the arguments are bad
+     */
+    bool startTransfer(uint8_t address, const uint8_t* tx, uint8_t txLen,
+                       uint8_t* rx, uint16_t rxLen,
+                       Callback callback, void* context);
+
+    /**
+     * Start a transfer and spin until it finishes. Setup code only.
+     * @return true if the transfer completed without NACK/arbitration errors
+     */
+    bool transferBlocking(uint8_t address, const uint8_t* tx, uint8_t txLen,
+                          uint8_t* rx, uint16_t rxLen, uint32_t timeoutUs = 5000);
+
+    /**
+     * Abort the transfer in flight if it started more than timeoutUs ago.
+     * Loop context.
+     * @return true if a transfer was aborted
+     */
+    bool checkTimeout(uint32_t timeoutUs);
+
+    bool isBusy() const;
+    uint32_t getCompletedCount() const;
+    uint32_t getErrorCount() const;      // includes timeouts
+    uint32_t getTimeoutCount() const;
+};
+
+#endif // ASYNC_I2C_H
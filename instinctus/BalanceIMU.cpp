@@ -0,0 +1,208 @@
+/**
+ * BalanceIMU.cpp - Main Balance Control IMU System Implementation
+ * 
+ * This file contains the implementation of the BalanceIMU class, which processes
+ * IMU sensor data and calculates tilt angles for real-time balance control.
+ * It combines accelerometer and gyroscope data through a TiltEstimator
+ * (Mahony in the Teensy sketch, the built-in complementary filter when
+ * none is set) to provide smooth, accurate tilt measurements.
+ * 
+ * Key Implementation Details:
+ * - updateBatch() runs in the 1 kHz balance ISR and integrates every sample
+ *   drained from the IMU FIFO since the previous tick
+ * - The built-in complementary filter uses atan2(accelX, accelZ) for the
+ *   forward/backward balance axis (X-forward), evaluated with
+ *   FastMath::fastAtan2 so the whole filter stays in single precision
+ * - Events published on significant changes (>1° since the last tilt
+ *   event) and emergencies (>45°)
+ * - Time-based integration of gyroscope data for drift compensation
+ * - dt comes from per-sample microsecond timestamps, not the loop clock,
+ *   so it stays accurate at kHz rates (millis() would quantize it to 1 ms)
+ * 
+ * Update Algorithm:
+ * 1. Compute dt from the sample timestamp and clamp it
+ * 2. Fuse the sample with the active TiltEstimator (MahonyTiltEstimator,
+ *    or ComplementaryTiltEstimator with alpha rescaled to the sample dt)
+ * 3. Check for significant changes and emergency conditions
+ * 4. Publish tilt / emergency events on the EventBus
+ * 
+ * Performance Characteristics:
+ * - updateBatch() execution time: a few microseconds per sample on Teensy 4.1
+ * - Memory usage: ~64 bytes for sensor data and state
+ * - Designed for real-time operation with minimal latency
+ * 
+ * Error Handling:
+ * - Gracefully handles sensor read failures (skip update cycle)
+ * - Null pointer protection in constructor (fail-fast design)
+ * - Time delta calculation handles micros() overflow (unsigned subtraction)
+ * - dt is clamped to Config::MAX_FILTER_DT_S so a stall or the first sample
+ *   after initialize() cannot fling the integrated angle
+ */
+
+#include "BalanceIMU.h"
+#include "MemoryPlacement.h"
+#include <Arduino.h>
+#include <BalanceConfig.h>
+#include <math.h>
+
+BalanceIMU::BalanceIMU(IMUInterface* imuHardware)
+    : imu(imuHardware), _bus(nullptr),
+      _defaultEstimator(), _estimator(&_defaultEstimator), _params(nullptr),
+      accelX(0), accelY(0), accelZ(0),
+      gyroX(0), gyroY(0), gyroZ(0),
+      currentTiltAngle(0), _lastPublishedTilt(0),
+      _emergencyActive(false), _emergencyQueuedUs(0),
+      lastSampleTimeUs(0), _batchCount(0) {
+}
+
+void BalanceIMU::setEventBus(EventBus* bus) {
+    _bus = bus;
+}
+
+void BalanceIMU::setEstimator(TiltEstimator* estimator) {
+    _estimator = estimator ? estimator : &_defaultEstimator;
+    _estimator->reset();
+}
+
+void BalanceIMU::setParams(const ParamStore* params) {
+    _params = params;
+    _defaultEstimator.setParams(params);
+}
+
+COLD_CODE bool BalanceIMU::initialize() {
+    if (!imu) {
+        return false;
+    }
+    
+    if (!imu->initialize()) {
+        return false;
+    }
+    
+    lastSampleTimeUs = micros();
+    _estimator->reset();
+    _lastPublishedTilt = currentTiltAngle;
+    _emergencyActive = false;
+    return true;
+}
+
+
+void BalanceIMU::update() {
+    // Read sensor data
+    IMUSample& sample = _batch[0];
+    _batchCount = 0;
+    if (!imu->readSensors(sample.accelX, sample.accelY, sample.accelZ,
+                          sample.gyroX, sample.gyroY, sample.gyroZ)) {
+        return; // Failed to read sensors
+    }
+    
+    sample.timestampUs = micros();
+    _batchCount = 1;
+
+    integrateSample(sample);
+    publishEvents(currentTiltAngle);
+}
+
+HOT_CODE void BalanceIMU::updateBatch() {
+    uint8_t count = imu->readBatch(_batch, Config::IMU_FIFO_MAX_BATCH);
+    _batchCount = count;
+    if (count == 0) {
+        return; // Nothing new since last tick
+    }
+
+    float peakTilt = currentTiltAngle;
+    for (uint8_t i = 0; i < count; i++) {
+        integrateSample(_batch[i]);
+        if (fabsf(currentTiltAngle) > fabsf(peakTilt)) {
+            peakTilt = currentTiltAngle;
+        }
+    }
+
+    publishEvents(peakTilt);
+}
+
+HOT_CODE void BalanceIMU::integrateSample(const IMUSample& sample) {
+    // Per-sample dt from acquisition timestamps
+    float deltaTime = (uint32_t)(sample.timestampUs - lastSampleTimeUs) * 1e-6f;
+    if (deltaTime > Config::MAX_FILTER_DT_S) {
+        deltaTime = Config::MAX_FILTER_DT_S;
+    }
+    lastSampleTimeUs = sample.timestampUs;
+
+    accelX = sample.accelX;
+    accelY = sample.accelY;
+    accelZ = sample.accelZ;
+    gyroX = sample.gyroX;
+    gyroY = sample.gyroY;
+    gyroZ = sample.gyroZ;
+
+    currentTiltAngle = _estimator->update(sample, deltaTime);
+}
+
+HOT_CODE void BalanceIMU::publishEvents(float peakTilt) {
+    if (!_bus) {
+        return;
+    }
+
+    float emergencyTilt = Config::EMERGENCY_TILT_ANGLE;
+    float changeThreshold = Config::TILT_CHANGE_THRESHOLD;
+    if (_params) {
+        const ParamBlock& params = _params->active();
+        emergencyTilt = params.emergencyTiltDeg;
+        changeThreshold = params.tiltChangeThresholdDeg;
+    }
+
+    // Emergency first: its immediate subscribers stop the motors, every
+    // tick. Deferred ones get the rising edge and a periodic reassert.
+    // The check uses the worst sample, not just the last one.
+    if (fabsf(peakTilt) > emergencyTilt) {
+        BalanceEmergencyEvent event = { lastSampleTimeUs, peakTilt };
+        uint32_t sinceQueuedUs = lastSampleTimeUs - _emergencyQueuedUs;
+        if (!_emergencyActive || sinceQueuedUs >= Config::EMERGENCY_REASSERT_MS * 1000UL) {
+            _bus->emergency.publish(event);
+            _emergencyQueuedUs = lastSampleTimeUs;
+        } else {
+            _bus->emergency.publishImmediate(event);
+        }
+        _emergencyActive = true;
+    } else {
+        _emergencyActive = false;
+    }
+
+    // Check for significant tilt change since the last TiltEvent, not the
+    // last tick: at 1 kHz a tick's change is far below any threshold
+    float tiltChange = fabsf(currentTiltAngle - _lastPublishedTilt);
+    if (tiltChange > changeThreshold) {
+        TiltEvent event = { lastSampleTimeUs, currentTiltAngle, 1 };
+        _bus->tilt.publish(event);
+        _lastPublishedTilt = currentTiltAngle;
+    }
+}
+
+uint8_t BalanceIMU::getLastBatch(const IMUSample*& samples) const {
+    samples = _batch;
+    return _batchCount;
+}
+
+uint32_t BalanceIMU::getLastSampleTimeUs() const {
+    return lastSampleTimeUs;
+}
+
+bool BalanceIMU::usesBuiltInEstimator() const {
+    return _estimator == &_defaultEstimator;
+}
+
+float BalanceIMU::getTiltAngle() const {
+    return currentTiltAngle;
+}
+
+void BalanceIMU::getAcceleration(float& x, float& y, float& z) const {
+    x = accelX;
+    y = accelY;
+    z = accelZ;
+}
+
+void BalanceIMU::getAngularVelocity(float& x, float& y, float& z) const {
+    x = gyroX;
+    y = gyroY;
+    z = gyroZ;
+}
\ No newline at end of file
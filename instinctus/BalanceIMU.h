@@ -0,0 +1,191 @@
+#ifndef BALANCE_IMU_H
+#define BALANCE_IMU_H
+
+#include <Arduino.h>
+#include <IMUConfig.h>
+#include "IMUInterface.h"
+#include "TiltEstimator.h"
+#include "ComplementaryTiltEstimator.h"
+#include "EventBus.h"
+
+/**
+ * BalanceIMU.h - Main Balance Control IMU System
+ * 
+ * This is the core balance control class that processes IMU sensor data and
+ * calculates tilt angles for balance control. It fuses accelerometer and
+ * gyroscope data through a TiltEstimator to provide smooth, accurate
+ * tilt measurements for real-time balance control.
+ * 
+ * Key Features:
+ * - Hardware abstraction via IMUInterface (works with any IMU chip)
+ * - Pluggable TiltEstimator for smooth, drift-free tilt calculation
+ * - Publishes tilt and emergency events on the EventBus
+ * - Runs every tick of the Config::BALANCE_LOOP_HZ (1 kHz) balance ISR,
+ *   draining the IMU FIFO each time
+ * - Emergency tilt detection for safety systems
+ * 
+ * Technical Details:
+ * - Teensy sketch fuses with MahonyTiltEstimator (Config::TILT_USE_MAHONY);
+ *   the complementary filter is built in as the fallback
+ * - Calculates tilt angle from Y-axis (forward/backward for balance robot)
+ * - Publishes on significant changes (>1°) and emergencies (>45°); any
+ *   number of subscribers (motor control, telemetry, logging) per topic
+ * - Maintains minimal state for fast processing
+ * 
+ * Coordinate System (X-Forward Convention):
+ * - X: Forward/Backward (primary balance axis)
+ * - Y: Left/Right (not used for balance)
+ * - Z: Up/Down (gravity reference)
+ * - Tilt angle: Positive = forward tilt, Negative = backward tilt
+ * 
+ * Usage Pattern:
+ *   ICM20948AsyncInterface imuHardware(&imuBus, &imuBusGuard,
+ *       Config::IMU_I2C_ADDRESS, Config::IMU_INT_PIN);   // FIFO-backed
+ *   MahonyTiltEstimator mahonyEstimator;
+ *   EventBus eventBus;
+ *   
+ *   BalanceIMU balanceIMU(&imuHardware);
+ *   balanceIMU.setEventBus(&eventBus);
+ *   
+ *   balanceIMU.setEstimator(&mahonyEstimator);
+ *   balanceIMU.initialize();
+ *
+ *   void balanceTask() {              // PIT ISR at Config::BALANCE_LOOP_HZ
+ *       balanceIMU.updateBatch();     // every sample buffered since last tick
+ *   }
+ *
+ * Estimator:
+ *   Sensor fusion is delegated to a TiltEstimator. The legacy
+ *   complementary filter is built in and used when none is set;
+ *   setEstimator() swaps in another before the loop starts. The Teensy
+ *   sketch sets MahonyTiltEstimator unless Config::TILT_USE_MAHONY is false.
+ *
+ * Batch Mode:
+ *   With a FIFO-backed IMUInterface, call updateBatch() instead of update().
+ *   Every buffered sample is run through the filter with its own dt, so the
+ *   filter sees the full gyro ODR (Config::IMU_GYRO_ODR_HZ) while the
+ *   caller runs at the balance loop rate. Events are published once per
+ *   batch.
+ *
+ * Timing:
+ *   dt is always the difference between sample acquisition timestamps in
+ *   microseconds (IMUSample::timestampUs), never the caller's loop period.
+ * 
+ * Performance:
+ * - updateBatch() is called once per balance tick (1 ms) from the ISR
+ * - A tick's batch (about one sample) takes a few microseconds on
+ *   Teensy 4.1 (host/replay_harness reports the estimator cost)
+ * - Immediate subscribers run synchronously within updateBatch(); deferred
+ *   ones run later from loop() (see EventBus)
+ */
+class BalanceIMU {
+private:
+    IMUInterface* imu;
+    EventBus* _bus;
+    ComplementaryTiltEstimator _defaultEstimator;
+    TiltEstimator* _estimator;
+    const ParamStore* _params;
+
+    // Current sensor readings
+    float accelX, accelY, accelZ;
+    float gyroX, gyroY, gyroZ;
+
+    // Calculated balance values
+    float currentTiltAngle;
+    float _lastPublishedTilt;   // tilt carried by the last TiltEvent
+    bool _emergencyActive;      // last tick was over the emergency tilt
+    uint32_t _emergencyQueuedUs; // last emergency queued for deferred subscribers
+
+    uint32_t lastSampleTimeUs;  // acquisition time of the last filtered sample
+
+    // Samples integrated by the last update() / updateBatch()
+    IMUSample _batch[Config::IMU_FIFO_MAX_BATCH];
+    uint8_t _batchCount;
+
+    // Internal calculation methods
+    void integrateSample(const IMUSample& sample);
+    void publishEvents(float peakTilt);
+
+public:
+    /**
+     * Constructor - only IMU hardware required, event bus set separately
+     * @param imuHardware - pointer to IMU hardware implementation
+     */
+    BalanceIMU(IMUInterface* imuHardware);
+
+    /**
+     * Set the bus that tilt and emergency events are published on
+     * @param bus - event bus, or nullptr to publish nothing
+     */
+    void setEventBus(EventBus* bus);
+
+    /**
+     * Replace the tilt estimator. Not safe while the balance task runs.
+     * @param estimator - estimator to use, or nullptr for the built-in
+     *                    complementary filter
+     */
+    void setEstimator(TiltEstimator* estimator);
+
+    /**
+     * Take the event thresholds (and the built-in filter's alpha) from
+     * runtime parameters
+     * @param params - parameter store, or nullptr for the Config values
+     */
+    void setParams(const ParamStore* params);
+    
+    
+    /**
+     * Initialize the IMU system
+     * @return true if initialization successful
+     */
+    bool initialize();
+    
+    /**
+     * Update sensor readings and calculate balance state
+     * Call this regularly (e.g., every 10ms) for real-time balance control
+     */
+    void update();
+
+    /**
+     * Drain every buffered IMU sample and integrate each one in order,
+     * with dt taken from consecutive sample timestamps.
+     * Call once per control tick in place of update().
+     */
+    void updateBatch();
+    
+    /**
+     * Samples integrated by the last update() or updateBatch(), oldest
+     * first. Valid until the next update; balance ISR only.
+     * @param samples - set to the internal array
+     * @return number of samples (0 if the last tick brought nothing new)
+     */
+    uint8_t getLastBatch(const IMUSample*& samples) const;
+
+    /**
+     * True while the built-in complementary filter is the estimator
+     */
+    bool usesBuiltInEstimator() const;
+
+    /**
+     * Get current tilt angle in degrees
+     * @return tilt angle (-90 to +90 degrees, 0 = upright)
+     */
+    float getTiltAngle() const;
+    
+    /**
+     * Acquisition time (micros()) of the sample behind getTiltAngle()
+     */
+    uint32_t getLastSampleTimeUs() const;
+
+    /**
+     * Get raw accelerometer readings
+     */
+    void getAcceleration(float& x, float& y, float& z) const;
+    
+    /**
+     * Get raw gyroscope readings  
+     */
+    void getAngularVelocity(float& x, float& y, float& z) const;
+};
+
+#endif // BALANCE_IMU_H
\ No newline at end of file
@@ -0,0 +1,209 @@
+/**
+ * BalanceMotorController.cpp - Fixed-Rate Cascaded Balance Controller Implementation
+ *
+ * State owned by update() is only written from the balance ISR. The loop
+ * side talks to it through _state, _resetPending and _velocityTarget
+ * (single words), and report() snapshots the rest with interrupts off.
+ */
+
+#include "BalanceMotorController.h"
+#include "MemoryPlacement.h"
+#include <BalanceConfig.h>
+#include <MotorConfig.h>
+
+using namespace Telemetry;
+
+static const PidGains TILT_GAINS = {
+    Config::TILT_KP, Config::TILT_KI, Config::TILT_KD,
+    -Config::MAX_WHEEL_SPEED_REV_S, Config::MAX_WHEEL_SPEED_REV_S,
+    Config::TILT_DERIVATIVE_TAU
+};
+
+static const PidGains VELOCITY_GAINS = {
+    Config::VELOCITY_KP, Config::VELOCITY_KI, 0.0f,
+    -Config::MAX_LEAN_SETPOINT_DEG, Config::MAX_LEAN_SETPOINT_DEG,
+    0.0f
+};
+
+BalanceMotorController::BalanceMotorController(BalanceIMU* imu, DriveCoordinator* drive)
+    : _imu(imu), _drive(drive), _tiltLoop(TILT_GAINS), _velocityLoop(VELOCITY_GAINS),
+      _state(STATE_DISARMED), _resetPending(false), _velocityTarget(0),
+      _lastSampleUs(0), _velocityTick(0), _velocityDt(0),
+      _lean(0), _leanSetpoint(0), _wheelSpeed(0), _wheelCommand(0),
+      _dtUs(0), _ticks(0), _setpointFailures(0),
+      _latencyLastUs(0), _latencyMaxUs(0), _latencySumUs(0), _latencyCount(0) {
+}
+
+HOT_CODE void BalanceMotorController::halt(State state) {
+    if (!_drive->stop()) {
+        _setpointFailures++;
+    }
+    _wheelCommand = 0;
+    _state = state;
+}
+
+HOT_CODE void BalanceMotorController::update() {
+    uint32_t sampleUs = _imu->getLastSampleTimeUs();
+    if (sampleUs == _lastSampleUs) {
+        return;  // No new IMU data; the ODrives hold the last setpoint
+    }
+    float dt = (uint32_t)(sampleUs - _lastSampleUs) * 1e-6f;
+    _lastSampleUs = sampleUs;
+
+    _lean = _imu->getTiltAngle() * Config::BALANCE_FORWARD_TILT_SIGN;
+
+    if (_state != STATE_ARMED) {
+        return;
+    }
+
+    float leftRevS, rightRevS;
+    uint32_t feedbackUs;
+    if (!_drive->getWheelSpeeds(leftRevS, rightRevS, feedbackUs) ||
+        (uint32_t)(micros() - feedbackUs) > Config::ODRIVE_FEEDBACK_TIMEOUT_US) {
+        halt(STATE_FEEDBACK_LOST);
+        return;
+    }
+    _wheelSpeed = 0.5f * (leftRevS + rightRevS);
+
+    if (_resetPending) {
+        // Fresh start: this sample only seeds the loops' dt and derivative
+        _tiltLoop.reset();
+        _velocityLoop.reset();
+        _velocityTick = 0;
+        _velocityDt = 0;
+        _leanSetpoint = 0;
+        _resetPending = false;
+        dt = 1.0f / Config::BALANCE_LOOP_HZ;
+    }
+    if (dt > Config::MAX_FILTER_DT_S) {
+        dt = Config::MAX_FILTER_DT_S;
+    }
+    _dtUs = (uint32_t)(dt * 1e6f);
+
+    // Outer loop at a divided rate, with its own accumulated dt
+    _velocityDt += dt;
+    if (++_velocityTick >= Config::BALANCE_VELOCITY_LOOP_DIVIDER) {
+        _leanSetpoint = _velocityLoop.update(_velocityTarget, _wheelSpeed, _velocityDt);
+        _velocityTick = 0;
+        _velocityDt = 0;
+    }
+
+    // The PID output restores the lean towards the setpoint; the wheels
+    // must run under the lean to do that, hence the sign flip
+    _wheelCommand = -_tiltLoop.update(_leanSetpoint, _lean, dt);
+    if (!_drive->setMotorSpeeds(_wheelCommand, _wheelCommand)) {
+        _setpointFailures++;
+    }
+    _ticks++;
+
+    uint32_t latency = micros() - sampleUs;
+    _latencyLastUs = latency;
+    _latencySumUs += latency;
+    _latencyCount++;
+    if (latency > _latencyMaxUs) {
+        _latencyMaxUs = latency;
+    }
+}
+
+HOT_CODE bool BalanceMotorController::onBalanceEmergency(const BalanceEmergencyEvent&) {
+    // Latch even when disarmed, so a fallen robot can't be re-armed
+    // without an explicit reset
+    if (_state == STATE_ARMED) {
+        halt(STATE_EMERGENCY_STOP);
+    } else {
+        _state = STATE_EMERGENCY_STOP;
+    }
+    return true;
+}
+
+bool BalanceMotorController::arm() {
+    if (_state == STATE_EMERGENCY_STOP) {
+        return false;
+    }
+    if (!_drive->enable()) {
+        return false;
+    }
+    _resetPending = true;
+    _state = STATE_ARMED;
+    return true;
+}
+
+void BalanceMotorController::disarm() {
+    _state = STATE_DISARMED;
+    _drive->stop();
+    _drive->disable();
+}
+
+void BalanceMotorController::setVelocityTarget(float revS) {
+    _velocityTarget = revS;
+}
+
+float BalanceMotorController::getVelocityTarget() const {
+    return _velocityTarget;
+}
+
+bool BalanceMotorController::setGains(const PidGains& tilt, const PidGains& velocity) {
+    if (_state != STATE_DISARMED) {
+        return false;
+    }
+    _tiltLoop.setGains(tilt);
+    _velocityLoop.setGains(velocity);
+    return true;
+}
+
+void BalanceMotorController::getGains(PidGains& tilt, PidGains& velocity) const {
+    tilt = _tiltLoop.getGains();
+    velocity = _velocityLoop.getGains();
+}
+
+void BalanceMotorController::resetEmergencyStop() {
+    if (_state == STATE_EMERGENCY_STOP) {
+        _state = STATE_DISARMED;
+    }
+}
+
+bool BalanceMotorController::isEmergencyStopped() const {
+    return _state == STATE_EMERGENCY_STOP;
+}
+
+BalanceMotorController::State BalanceMotorController::getState() const {
+    return _state;
+}
+
+float BalanceMotorController::getLeanSetpoint() const {
+    return _leanSetpoint;
+}
+
+float BalanceMotorController::getWheelSpeed() const {
+    return _wheelSpeed;
+}
+
+float BalanceMotorController::getWheelCommand() const {
+    return _wheelCommand;
+}
+
+void BalanceMotorController::report(TelemetryWriter& telemetry) {
+    BalanceControlPayload snapshot;
+    __disable_irq();
+    snapshot.state = _state;
+    snapshot.saturated = (_tiltLoop.isSaturated() ? 0x01 : 0) | (_velocityLoop.isSaturated() ? 0x02 : 0);
+    snapshot.leanDeg = _lean;
+    snapshot.leanSetpointDeg = _leanSetpoint;
+    snapshot.wheelSpeedRevS = _wheelSpeed;
+    snapshot.wheelCommandRevS = _wheelCommand;
+    snapshot.velocityTargetRevS = _velocityTarget;
+    snapshot.dtUs = _dtUs;
+    snapshot.ticks = _ticks;
+    snapshot.setpointFailures = _setpointFailures;
+    snapshot.latencyLastUs = _latencyLastUs;
+    snapshot.latencyMeanUs = _latencyCount ? _latencySumUs / _latencyCount : 0;
+    snapshot.latencyMaxUs = _latencyMaxUs;
+    _latencyMaxUs = 0;
+    _latencySumUs = 0;
+    _latencyCount = 0;
+    __enable_irq();
+
+    BalanceControlPayload* p = telemetry.begin<BalanceControlPayload>(FRAME_BALANCE_CONTROL, micros());
+    *p = snapshot;
+    telemetry.commit();
+}
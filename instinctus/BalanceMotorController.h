@@ -0,0 +1,163 @@
+#ifndef BALANCE_MOTOR_CONTROLLER_H
+#define BALANCE_MOTOR_CONTROLLER_H
+
+#include <Arduino.h>
+#include "BalanceIMU.h"
+#include "DriveCoordinator.h"
+#include "EventBus.h"
+#include "PidController.h"
+#include "TelemetryWriter.h"
+
+/**
+ * BalanceMotorController.h - Fixed-Rate Cascaded Balance Controller
+ *
+ * Replaces the legacy event-driven observer (which only ran when the tilt
+ * moved by more than TILT_CHANGE_THRESHOLD and assumed dt = 0.01). update()
+ * is called on every balance tick, right after BalanceIMU::updateBatch(),
+ * and runs:
+ *
+ *   outer (every BALANCE_VELOCITY_LOOP_DIVIDER ticks):
+ *     velocity target - mean wheel speed (ODrive encoders) -> PI -> lean setpoint
+ *   inner (every tick):
+ *     lean setpoint - lean angle (BalanceIMU) -> PID -> wheel speed command
+ *
+ * The velocity integrator doubles as position hold: with a zero target,
+ * distance rolled away is integrated back out. Both loops use measured dt
+ * (IMU sample timestamps), derivative on measurement and conditional
+ * integration; see PidController.
+ *
+ * Angles are handled as "lean", positive when leaning forward
+ * (getTiltAngle() * BALANCE_FORWARD_TILT_SIGN). The wheels have to drive
+ * towards the lean to catch it.
+ *
+ * Latency:
+ * - Measured from the acquisition timestamp of the newest IMU sample to
+ *   the moment both Set_Input_Vel frames have been queued. The controller
+ *   runs in the balance ISR straight after the FIFO drain and the frames
+ *   go into CAN mailboxes without waiting, so this is IMU-to-wire minus
+ *   the CAN frame time. report() sends last/mean/max.
+ *
+ * Safety:
+ * - Disarmed by default; arm() from loop(). Disarmed or faulted, update()
+ *   sends nothing.
+ * - onBalanceEmergency(), an IMMEDIATE EventBus subscriber, zeroes the
+ *   setpoints inside the same batch that tripped EMERGENCY_TILT_ANGLE and
+ *   latches the emergency stop until resetEmergencyStop().
+ * - Encoder feedback missing or older than ODRIVE_FEEDBACK_TIMEOUT_US:
+ *   zero setpoints and disarm.
+ *
+ * Contexts: update() in the balance ISR; everything else from loop().
+ *
+ * Usage:
+ *   BalanceMotorController controller(&balanceIMU, &drive);
+ *   eventBus.emergency.subscribe<BalanceMotorController,
+ *       &BalanceMotorController::onBalanceEmergency>(&controller, Dispatch::IMMEDIATE);
+ *   controller.arm();                 // loop
+ *   controller.update();              // balance ISR, every tick
+ *   controller.report(telemetry);     // loop slot
+ */
+class BalanceMotorController {
+public:
+    enum State : uint8_t {
+        STATE_DISARMED       = 0,
+        STATE_ARMED          = 1,
+        STATE_EMERGENCY_STOP = 2,
+        STATE_FEEDBACK_LOST  = 3
+    };
+
+private:
+    BalanceIMU* _imu;
+    DriveCoordinator* _drive;
+    PidController _tiltLoop;
+    PidController _velocityLoop;
+
+    volatile State _state;
+    volatile bool _resetPending;      // set by arm(), consumed by update()
+    volatile float _velocityTarget;   // rev/s, positive = forward
+
+    uint32_t _lastSampleUs;
+    uint8_t _velocityTick;
+    float _velocityDt;
+
+    // Latest values, for report()
+    float _lean;
+    float _leanSetpoint;
+    float _wheelSpeed;
+    float _wheelCommand;
+    uint32_t _dtUs;
+    uint32_t _ticks;
+    uint32_t _setpointFailures;
+
+    // Latency window, cleared by report()
+    uint32_t _latencyLastUs;
+    uint32_t _latencyMaxUs;
+    uint32_t _latencySumUs;
+    uint32_t _latencyCount;
+
+    void halt(State state);
+
+public:
+    /**
+     * Constructor
+     * @param imu - tilt source, updated earlier in the same tick
+     * @param drive - wheel pair to command and read speeds from
+     */
+    BalanceMotorController(BalanceIMU* imu, DriveCoordinator* drive);
+
+    /**
+     * One control tick. Balance ISR, after BalanceIMU::updateBatch().
+     * Does nothing if no new IMU sample arrived since the last tick.
+     */
+    void update();
+
+    /**
+     * Immediate emergency handler. Balance ISR (publisher's context).
+     */
+    bool onBalanceEmergency(const BalanceEmergencyEvent& event);
+
+    /**
+     * Put the axes in closed loop and start controlling from a fresh
+     * integrator state. Refused while the emergency stop is latched.
+     * @return false if refused or the enable frames could not be queued
+     */
+    bool arm();
+
+    /**
+     * Stop controlling and idle both axes
+     */
+    void disarm();
+
+    /**
+     * Wheel speed to hold while balancing (rev/s, positive = forward)
+     */
+    void setVelocityTarget(float revS);
+    float getVelocityTarget() const;
+
+    /**
+     * Replace the loop gains (runtime tuning). Only while disarmed: the
+     * balance ISR doesn't touch the loops then, so no tick sees half an
+     * update.
+     * @return false if armed or emergency stopped
+     */
+    bool setGains(const PidGains& tilt, const PidGains& velocity);
+    void getGains(PidGains& tilt, PidGains& velocity) const;
+
+    void resetEmergencyStop();
+    bool isEmergencyStopped() const;
+    State getState() const;
+
+    /**
+     * Values from the last update(). Balance ISR (e.g. the black box).
+     */
+    float getLeanSetpoint() const;
+    float getWheelSpeed() const;
+    float getWheelCommand() const;
+
+    /**
+     * Send FRAME_BALANCE_CONTROL and start a new latency window.
+     * Loop context only.
+     */
+    void report(TelemetryWriter& telemetry);
+};
+
+#endif // BALANCE_MOTOR_CONTROLLER_H
@@ -0,0 +1,52 @@
+#ifndef BLACK_BOX_FORMAT_H
+#define BLACK_BOX_FORMAT_H
+
+#include <stdint.h>
+
+/**
+ * BlackBoxFormat.h - On-Card Layout of .BBX Flight Recordings
+ *
+ * A file is one BlackBoxFileHeader (512 bytes) followed by BlackBoxRecords,
+ * little endian, no padding. Shared by BlackBoxRecorder and the host
+ * tools that read recordings back (host/replay_harness.cpp), so it only
+ * depends on <stdint.h>.
+ */
+
+static constexpr char BLACKBOX_MAGIC[8] = { 'C', 'A', 'L', 'V', 'I', 'N', 'B', 'B' };
+static constexpr uint16_t BLACKBOX_FORMAT_VERSION = 1;
+
+/**
+ * One balance tick. Must stay 64 bytes: the ring and the SD chunks are
+ * sized in whole records.
+ */
+struct __attribute__((packed)) BlackBoxRecord {
+    uint32_t timestampUs;          // IMU sample time
+    float    accel[3];             // m/s², robot frame
+    float    gyro[3];              // rad/s, robot frame
+    float    tiltDeg;
+    float    leanSetpointDeg;
+    float    wheelSpeedRevS;
+    float    wheelCommandRevS;
+    float    iqMeasured[2];        // A, left then right
+    int16_t  frontMm;
+    int16_t  rearMm;
+    uint8_t  controllerState;      // BalanceMotorController::State
+    uint8_t  reserved[7];
+};
+
+static_assert(sizeof(BlackBoxRecord) == 64, "black-box record layout is part of the file format");
+
+struct __attribute__((packed)) BlackBoxFileHeader {
+    char     magic[8];             // BLACKBOX_MAGIC, not NUL terminated
+    uint16_t version;
+    uint16_t recordSize;
+    uint32_t sampleRateHz;
+    uint32_t recordCount;          // snapshot: records in file, stream: 0
+    uint32_t triggerRecord;        // snapshot: index of the trigger record, stream: UINT32_MAX
+    uint32_t triggerTimestampUs;
+    uint8_t  reserved[484];
+};
+
+static_assert(sizeof(BlackBoxFileHeader) == 512, "header is one sector");
+
+#endif // BLACK_BOX_FORMAT_H
@@ -0,0 +1,263 @@
+/**
+ * BlackBoxRecorder.cpp - Full-Rate Flight Recorder Implementation
+ *
+ * Ownership of _state: the ISR moves RECORDING -> TRIGGERED -> SAVING,
+ * loop() moves SAVING -> RECORDING once the snapshot is on the card.
+ * Neither side ever writes a state the other one owns, so a plain
+ * volatile byte is enough. _triggerLatched is set by the ISR with the
+ * trigger and cleared by either side; a rearm() racing a new trigger
+ * only decides whether that trigger is taken.
+ *
+ * Ring indices are free-running uint32_t, like SpscRing. The SD library
+ * drives SDIO in FIFO mode (CPU copies out of the ring), so DMAMEM's
+ * write-back cache needs no maintenance here.
+ */
+
+#include "BlackBoxRecorder.h"
+#include "MemoryPlacement.h"
+#include <BalanceConfig.h>
+
+using namespace Telemetry;
+
+#ifdef INSTINCTUS_BLACKBOX_PSRAM
+static constexpr uint32_t RING_RECORDS = 16384;   // 1 MB of the 8 MB PSRAM
+EXTMEM alignas(32) static BlackBoxRecord ringStorage[RING_RECORDS];
+#else
+static constexpr uint32_t RING_RECORDS = 2048;    // 128 KB of OCRAM
+BULK_DATA alignas(32) static BlackBoxRecord ringStorage[RING_RECORDS];
+#endif
+
+static constexpr uint32_t PRE_TRIGGER_RECORDS =
+    (uint32_t)Config::BLACKBOX_PRE_TRIGGER_MS * Config::BALANCE_LOOP_HZ / 1000;
+static constexpr uint32_t POST_TRIGGER_RECORDS =
+    (uint32_t)Config::BLACKBOX_POST_TRIGGER_MS * Config::BALANCE_LOOP_HZ / 1000;
+static constexpr uint32_t REARM_RECORDS =
+    (uint32_t)Config::BLACKBOX_REARM_MS * Config::BALANCE_LOOP_HZ / 1000;
+
+static_assert((RING_RECORDS & (RING_RECORDS - 1)) == 0, "ring must be a power of two");
+static_assert(Config::BLACKBOX_CHUNK_BYTES % 512 == 0, "chunks must be whole sectors");
+static_assert(RING_RECORDS % BlackBoxRecorder::CHUNK_RECORDS == 0, "ring must be whole chunks");
+// The snapshot start is rounded down to a chunk boundary, hence + one chunk
+static_assert(PRE_TRIGGER_RECORDS + POST_TRIGGER_RECORDS + BlackBoxRecorder::CHUNK_RECORDS <= RING_RECORDS,
+              "black-box trigger windows don't fit in the ring");
+
+BlackBoxRecorder::BlackBoxRecorder()
+    : _ring(ringStorage), _capacity(RING_RECORDS), _mask(RING_RECORDS - 1),
+      _head(0), _state(STATE_OFF), _triggerIndex(0), _triggerTimestampUs(0),
+      _triggerLatched(false), _lastEmergencyIndex(0), _dropped(0),
+      _snapshot(), _snapshotNext(0), _snapshotEnd(0), _nextSnapshotNumber(0), _snapshotsSaved(0),
+      _stream(), _streaming(false), _streamTail(0), _chunksSinceFlush(0), _streamOverruns(0),
+      _writeErrors(0), _maxWriteUs(0) {
+}
+
+COLD_CODE bool BlackBoxRecorder::begin() {
+    if (!Config::BLACKBOX_ENABLED || !SD.begin(BUILTIN_SDCARD)) {
+        return false;
+    }
+
+    // The only full scan; later snapshots resume from here
+    _nextSnapshotNumber = nextFreeNumber("FALL", 1);
+
+    if (Config::BLACKBOX_STREAM_ENABLED) {
+        uint16_t number = nextFreeNumber("REC", 1);
+        char name[16];
+        makeName(name, "REC", number);
+        _stream = number ? SD.open(name, FILE_WRITE_BEGIN) : File();
+        _streaming = _stream && writeHeader(_stream, 0, UINT32_MAX, 0);
+        if (!_streaming) {
+            _writeErrors++;
+        }
+    }
+
+    _streamTail = _head;
+    _state = STATE_RECORDING;
+    return true;
+}
+
+HOT_CODE void BlackBoxRecorder::record(const BlackBoxRecord& r) {
+    State state = _state;
+    if (state == STATE_OFF) {
+        return;
+    }
+    if (state == STATE_SAVING) {
+        _dropped = _dropped + 1;   // Frozen until the snapshot is saved
+        return;
+    }
+
+    uint32_t head = _head;
+    _ring[head & _mask] = r;
+    _head = head + 1;
+
+    if (state == STATE_TRIGGERED && head + 1 - _triggerIndex >= POST_TRIGGER_RECORDS) {
+        _state = STATE_SAVING;
+    } else if (state == STATE_RECORDING && _triggerLatched &&
+               head - _lastEmergencyIndex >= REARM_RECORDS) {
+        _triggerLatched = false;   // Emergency over: the next one is a new fall
+    }
+}
+
+HOT_CODE bool BlackBoxRecorder::onBalanceEmergency(const BalanceEmergencyEvent& event) {
+    _lastEmergencyIndex = _head;
+    if (_state == STATE_RECORDING && !_triggerLatched) {
+        // The record this tick is about to write is the trigger
+        _triggerIndex = _head;
+        _triggerTimestampUs = event.timestampUs;
+        _triggerLatched = true;
+        _state = STATE_TRIGGERED;
+    }
+    return true;
+}
+
+void BlackBoxRecorder::rearm() {
+    _triggerLatched = false;
+}
+
+void BlackBoxRecorder::service() {
+    if (_state == STATE_SAVING) {
+        if (!_snapshot) {
+            startSnapshot();
+        } else {
+            serviceSnapshot();
+        }
+        return;
+    }
+    if (_streaming) {
+        serviceStream();
+    }
+}
+
+void BlackBoxRecorder::startSnapshot() {
+    uint32_t trigger = _triggerIndex;
+    uint32_t start = (trigger > PRE_TRIGGER_RECORDS) ? trigger - PRE_TRIGGER_RECORDS : 0;
+    start -= start % CHUNK_RECORDS;
+    _snapshotNext = start;
+    _snapshotEnd = _head;
+
+    // Normally a single exists() check: the cached number is still free
+    uint16_t number = _nextSnapshotNumber ? nextFreeNumber("FALL", _nextSnapshotNumber) : 0;
+    char name[16];
+    makeName(name, "FALL", number);
+    if (number) {
+        _snapshot = SD.open(name, FILE_WRITE_BEGIN);
+        _nextSnapshotNumber = (number < 9999) ? number + 1 : 0;
+    }
+    if (!_snapshot || !writeHeader(_snapshot, _snapshotEnd - start, trigger - start, _triggerTimestampUs)) {
+        _writeErrors++;
+        if (_snapshot) {
+            _snapshot.close();
+        }
+        _state = STATE_RECORDING;   // Give up on this one, keep recording
+        return;
+    }
+}
+
+void BlackBoxRecorder::serviceSnapshot() {
+    // Chunk-aligned start and a whole-chunk ring: never crosses the ring end
+    uint32_t remaining = _snapshotEnd - _snapshotNext;
+    uint32_t count = (remaining < CHUNK_RECORDS) ? remaining : CHUNK_RECORDS;
+    bool ok = writeRecords(_snapshot, _snapshotNext, count);
+    _snapshotNext += count;
+
+    if (!ok || _snapshotNext == _snapshotEnd) {
+        _snapshot.close();
+        if (ok) {
+            _snapshotsSaved++;
+        }
+        _state = STATE_RECORDING;
+    }
+}
+
+void BlackBoxRecorder::serviceStream() {
+    uint32_t head = _head;
+
+    // Keep half a ring between the card and the ISR; a card that falls
+    // further behind loses the oldest data instead of reading torn records
+    if (head - _streamTail > _capacity / 2) {
+        uint32_t skipTo = head - _capacity / 2;
+        skipTo -= skipTo % CHUNK_RECORDS;
+        _streamOverruns += skipTo - _streamTail;
+        _streamTail = skipTo;
+    }
+    if (head - _streamTail < CHUNK_RECORDS) {
+        return;
+    }
+
+    if (!writeRecords(_stream, _streamTail, CHUNK_RECORDS)) {
+        _stream.close();
+        _streaming = false;
+        return;
+    }
+    _streamTail += CHUNK_RECORDS;
+
+    if (++_chunksSinceFlush >= STREAM_FLUSH_CHUNKS) {
+        _chunksSinceFlush = 0;
+        _stream.flush();
+    }
+}
+
+bool BlackBoxRecorder::writeHeader(File& file, uint32_t recordCount, uint32_t triggerRecord,
+                                   uint32_t triggerTimestampUs) {
+    BlackBoxFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BLACKBOX_MAGIC, sizeof(header.magic));
+    header.version = BLACKBOX_FORMAT_VERSION;
+    header.recordSize = sizeof(BlackBoxRecord);
+    header.sampleRateHz = Config::BALANCE_LOOP_HZ;
+    header.recordCount = recordCount;
+    header.triggerRecord = triggerRecord;
+    header.triggerTimestampUs = triggerTimestampUs;
+    if (file.write((const uint8_t*)&header, sizeof(header)) != sizeof(header)) {
+        return false;
+    }
+    return true;
+}
+
+bool BlackBoxRecorder::writeRecords(File& file, uint32_t from, uint32_t count) {
+    size_t bytes = count * sizeof(BlackBoxRecord);
+    uint32_t start = micros();
+    size_t written = file.write((const uint8_t*)&_ring[from & _mask], bytes);
+    uint32_t elapsed = micros() - start;
+    if (elapsed > _maxWriteUs) {
+        _maxWriteUs = elapsed;
+    }
+    if (written != bytes) {
+        _writeErrors++;
+        return false;
+    }
+    return true;
+}
+
+uint16_t BlackBoxRecorder::nextFreeNumber(const char* prefix, uint16_t from) const {
+    char name[16];
+    for (uint16_t number = from ? from : 1; number <= 9999; number++) {
+        makeName(name, prefix, number);
+        if (!SD.exists(name)) {
+            return number;
+        }
+    }
+    return 0;
+}
+
+void BlackBoxRecorder::makeName(char* name, const char* prefix, uint16_t number) const {
+    snprintf(name, 16, "%s%04u.BBX", prefix, (unsigned)number);
+}
+
+BlackBoxRecorder::State BlackBoxRecorder::getState() const {
+    return _state;
+}
+
+void BlackBoxRecorder::report(TelemetryWriter& telemetry) {
+    BlackBoxPayload* p = telemetry.begin<BlackBoxPayload>(FRAME_BLACKBOX, micros());
+    p->state = _state;
+    p->streaming = _streaming;
+    p->ringRecords = _capacity;
+    p->recordsCaptured = _head;
+    p->streamBacklog = _streaming ? _head - _streamTail : 0;
+    p->snapshotsSaved = _snapshotsSaved;
+    p->recordsDropped = _dropped;
+    p->streamOverruns = _streamOverruns;
+    p->writeErrors = _writeErrors;
+    p->maxWriteUs = _maxWriteUs;
+    telemetry.commit();
+    _maxWriteUs = 0;
+}
@@ -0,0 +1,146 @@
+#ifndef BLACK_BOX_RECORDER_H
+#define BLACK_BOX_RECORDER_H
+
+#include <Arduino.h>
+#include <SD.h>
+#include <BlackBoxConfig.h>
+#include "BlackBoxFormat.h"
+#include "EventBus.h"
+#include "TelemetryWriter.h"
+
+/**
+ * BlackBoxRecorder.h - Full-Rate Flight Recorder on the Built-In SD Card
+ *
+ * The balance ISR writes one BlackBoxRecord per tick into a RAM ring
+ * (DMAMEM, or PSRAM with -DINSTINCTUS_BLACKBOX_PSRAM). loop() moves data
+ * from the ring to the SD card in BLACKBOX_CHUNK_BYTES writes, one write
+ * per service() call, so the ISR never waits for the card.
+ *
+ * Buffering:
+ * - The ring is a multiple of the chunk size and every write starts on a
+ *   chunk boundary, so each SD write is one contiguous, sector-aligned
+ *   block. While a chunk is written, the ISR fills the next one (the
+ *   ring is a multi-buffer generalization of a double buffer).
+ * - Files start with a 512-byte header (BlackBoxFileHeader), so records
+ *   stay sector-aligned in the file too.
+ *
+ * Emergency Snapshot:
+ * - onBalanceEmergency() (IMMEDIATE EventBus subscriber) marks the
+ *   trigger record. The ISR keeps recording for BLACKBOX_POST_TRIGGER_MS,
+ *   then freezes the ring; loop() writes BLACKBOX_PRE_TRIGGER_MS before
+ *   to POST after the trigger to FALLnnnn.BBX and unfreezes. Records
+ *   produced while frozen are dropped and counted.
+ * - A trigger latches: further emergencies are ignored, during the
+ *   snapshot and after it, until none has been published for
+ *   BLACKBOX_REARM_MS (tilt back under the limit) or rearm() is called
+ *   (CMD_RESET_ESTOP). A robot lying on the floor produces one file per
+ *   fall.
+ * - File numbers are found once in begin(), which may take a while on a
+ *   card with many files; snapshots continue from the cached number.
+ *
+ * Streaming (BLACKBOX_STREAM_ENABLED):
+ * - Every record also goes to RECnnnn.BBX. If the card falls more than
+ *   a ring behind, the oldest data is skipped and counted as an overrun.
+ *
+ * Only one instance can exist (the ring is a static buffer, because
+ * DMAMEM/EXTMEM placement needs a file-scope object).
+ *
+ * Usage:
+ *   BlackBoxRecorder blackBox;
+ *   blackBox.begin();                  // setup, after Serial
+ *   blackBox.record(r);                // balance ISR, every tick
+ *   blackBox.service();                // loop slot
+ */
+class BlackBoxRecorder {
+public:
+    enum State : uint8_t {
+        STATE_OFF       = 0,       // no card, or disabled
+        STATE_RECORDING = 1,
+        STATE_TRIGGERED = 2,       // collecting the post-trigger window
+        STATE_SAVING    = 3        // ring frozen, writing the snapshot
+    };
+
+    static constexpr uint32_t CHUNK_RECORDS = Config::BLACKBOX_CHUNK_BYTES / sizeof(BlackBoxRecord);
+
+private:
+    // Stream file flush interval, in chunks (directory entry update)
+    static constexpr uint8_t STREAM_FLUSH_CHUNKS = 16;
+
+    BlackBoxRecord* _ring;
+    uint32_t _capacity;            // records, power of two
+    uint32_t _mask;
+
+    volatile uint32_t _head;       // next record to write (ISR)
+    volatile State _state;
+    volatile uint32_t _triggerIndex;
+    volatile uint32_t _triggerTimestampUs;
+    volatile bool _triggerLatched;         // set by a trigger, cleared by re-arming
+    volatile uint32_t _lastEmergencyIndex; // _head at the newest emergency (ISR)
+    volatile uint32_t _dropped;    // records lost while frozen
+
+    // Snapshot progress (loop)
+    File _snapshot;
+    uint32_t _snapshotNext;
+    uint32_t _snapshotEnd;
+    uint16_t _nextSnapshotNumber;  // 0: no free number left
+    uint32_t _snapshotsSaved;
+
+    // Stream progress (loop)
+    File _stream;
+    bool _streaming;
+    uint32_t _streamTail;
+    uint8_t _chunksSinceFlush;
+    uint32_t _streamOverruns;
+
+    uint32_t _writeErrors;
+    uint32_t _maxWriteUs;
+
+    bool writeHeader(File& file, uint32_t recordCount, uint32_t triggerRecord, uint32_t triggerTimestampUs);
+    bool writeRecords(File& file, uint32_t from, uint32_t count);
+    uint16_t nextFreeNumber(const char* prefix, uint16_t from) const;
+    void makeName(char* name, const char* prefix, uint16_t number) const;
+    void startSnapshot();
+    void serviceSnapshot();
+    void serviceStream();
+
+public:
+    BlackBoxRecorder();
+
+    /**
+     * Mount the SD card, find the next free FALLnnnn.BBX and, if
+     * streaming, open a new RECnnnn.BBX. Scans the card: call before the
+     * watchdog is started.
+     * @return false if disabled or no card (recorder stays off)
+     */
+    bool begin();
+
+    /**
+     * Append one record. Balance ISR, once per tick.
+     */
+    void record(const BlackBoxRecord& r);
+
+    /**
+     * Immediate emergency handler: mark the trigger. Balance ISR.
+     */
+    bool onBalanceEmergency(const BalanceEmergencyEvent& event);
+
+    /**
+     * Release the trigger latch, so the next emergency takes a new
+     * snapshot. Loop context.
+     */
+    void rearm();
+
+    /**
+     * At most one SD write. Loop slot.
+     */
+    void service();
+
+    State getState() const;
+
+    /**
+     * Send FRAME_BLACKBOX. Loop context.
+     */
+    void report(TelemetryWriter& telemetry);
+};
+
+#endif // BLACK_BOX_RECORDER_H
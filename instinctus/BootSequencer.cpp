@@ -0,0 +1,143 @@
+/**
+ * BootSequencer.cpp - Non-Blocking, Overlapped Startup Implementation
+ *
+ * Tracks are only ever advanced from run(), so a step function may take
+ * as long as its driver needs without any re-entrancy concerns; a paused
+ * track simply gets skipped until its resume time.
+ */
+
+#include "BootSequencer.h"
+#include "TelemetryWriter.h"
+#include "MemoryPlacement.h"
+
+using namespace Telemetry;
+
+BootSequencer::BootSequencer()
+    : _steps(), _count(0), _current(), _resumeUs(), _paused(),
+      _startUs(0), _totalUs(0), _started(false), _finished(false) {
+}
+
+COLD_CODE int8_t BootSequencer::addStep(uint8_t track, const char* name, StepFn fn, int8_t after) {
+    if (_started || _count >= MAX_STEPS || track >= MAX_TRACKS || !fn || after >= (int8_t)_count) {
+        return -1;
+    }
+    Step& s = _steps[_count];
+    s.name = name;
+    s.fn = fn;
+    s.track = track;
+    s.after = after;
+    s.status = STATUS_PENDING;
+    return (int8_t)_count++;
+}
+
+uint8_t BootSequencer::nextOnTrack(uint8_t track, uint8_t from) const {
+    while (from < _count && _steps[from].track != track) {
+        from++;
+    }
+    return from;
+}
+
+bool BootSequencer::isFinished(int8_t step) const {
+    return step >= 0 && step < (int8_t)_count &&
+           (_steps[step].status == STATUS_OK || _steps[step].status == STATUS_FAILED);
+}
+
+COLD_CODE void BootSequencer::start() {
+    for (uint8_t t = 0; t < MAX_TRACKS; t++) {
+        _current[t] = nextOnTrack(t, 0);
+        _paused[t] = false;
+    }
+    _startUs = micros();
+    _started = true;
+}
+
+COLD_CODE bool BootSequencer::run() {
+    if (!_started || _finished) {
+        return false;
+    }
+
+    bool remaining = false;
+    for (uint8_t t = 0; t < MAX_TRACKS; t++) {
+        uint8_t i = _current[t];
+        if (i >= _count) {
+            continue;
+        }
+        remaining = true;
+
+        uint32_t now = micros();
+        if (_paused[t] && (int32_t)(now - _resumeUs[t]) < 0) {
+            continue;
+        }
+        _paused[t] = false;
+
+        Step& s = _steps[i];
+        if (s.after >= 0 && !isFinished(s.after)) {
+            continue;
+        }
+        if (s.status == STATUS_PENDING) {
+            s.status = STATUS_RUNNING;
+            s.startUs = now - _startUs;
+        }
+
+        uint32_t waitUs = 0;
+        StepResult result = s.fn(waitUs);
+        uint32_t endUs = micros();
+        if (waitUs > 0) {
+            _paused[t] = true;
+            _resumeUs[t] = endUs + waitUs;
+        }
+        if (result == STEP_WAIT) {
+            continue;
+        }
+
+        s.status = (result == STEP_DONE) ? STATUS_OK : STATUS_FAILED;
+        s.durationUs = (endUs - _startUs) - s.startUs;
+        _current[t] = nextOnTrack(t, i + 1);
+    }
+
+    if (remaining) {
+        for (uint8_t t = 0; t < MAX_TRACKS; t++) {
+            if (_current[t] < _count) {
+                return false;
+            }
+        }
+    }
+    _finished = true;
+    _totalUs = micros() - _startUs;
+    return true;
+}
+
+bool BootSequencer::isDone() const {
+    return _finished;
+}
+
+bool BootSequencer::isStepDone(int8_t step) const {
+    return isFinished(step);
+}
+
+uint8_t BootSequencer::getFailureCount() const {
+    uint8_t failures = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_steps[i].status == STATUS_FAILED) {
+            failures++;
+        }
+    }
+    return failures;
+}
+
+COLD_CODE void BootSequencer::report(TelemetryWriter& telemetry) {
+    BootPayload* p = telemetry.begin<BootPayload>(FRAME_BOOT, micros());
+    p->setupUs = _startUs;
+    p->totalUs = _totalUs;
+    p->failures = getFailureCount();
+    p->stepCount = _count;
+    for (uint8_t i = 0; i < _count; i++) {
+        BootStepRecord& r = p->steps[i];
+        memset(r.name, 0, sizeof(r.name));
+        strncpy(r.name, _steps[i].name, sizeof(r.name));
+        r.startUs = _steps[i].startUs;
+        r.durationUs = _steps[i].durationUs;
+        r.status = _steps[i].status;
+    }
+    telemetry.commit(offsetof(BootPayload, steps) + _count * sizeof(BootStepRecord));
+}
@@ -0,0 +1,117 @@
+#ifndef BOOT_SEQUENCER_H
+#define BOOT_SEQUENCER_H
+
+#include <Arduino.h>
+#include "TelemetryFrame.h"
+
+class TelemetryWriter;
+
+/**
+ * BootSequencer.h - Non-Blocking, Overlapped Startup
+ *
+ * Replaces the straight-line setup() where every device waited for the
+ * previous one, and every reset or boot time was a delay(). Startup is a
+ * list of steps on independent tracks (one per bus, say) that loop()
+ * advances with run() while the scheduler is already servicing its slots.
+ *
+ * Steps:
+ * - A step is a function returning STEP_DONE, STEP_WAIT (call again
+ *   after waitUs, e.g. polling for a device) or STEP_FAILED. On STEP_DONE
+ *   it may set waitUs to pause its track before the next step, which is
+ *   how a reset or power-up time overlaps with the other tracks
+ * - Steps of a track run in the order added; a step can also wait for a
+ *   step on another track (after), e.g. slow sensor firmware loads only
+ *   once the balance loop is running
+ * - A failed step does not stop its track; the step logs its own error,
+ *   as setup() did
+ *
+ * Each run() calls at most one step per track, so waits overlap but a
+ * step that blocks (a driver call) still holds up the others while it
+ * runs. Per-step start and duration, relative to start(), go out as
+ * FRAME_BOOT once everything has finished.
+ *
+ * Loop context only.
+ *
+ * Usage:
+ *   BootSequencer boot;
+ *   int8_t imu = boot.addStep(0, "imuInit", imuInitStep);
+ *   boot.addStep(1, "tofInit", tofInitStep, imu);
+ *   boot.start();
+ *   void loop() { scheduler.runPending(); if (boot.run()) { ... } }
+ */
+class BootSequencer {
+public:
+    enum StepResult : uint8_t {
+        STEP_DONE,
+        STEP_WAIT,
+        STEP_FAILED
+    };
+
+    enum StepStatus : uint8_t {
+        STATUS_PENDING,
+        STATUS_RUNNING,
+        STATUS_OK,
+        STATUS_FAILED
+    };
+
+    typedef StepResult (*StepFn)(uint32_t& waitUs);
+
+    static constexpr uint8_t MAX_STEPS = Telemetry::MAX_BOOT_STEPS;
+    static constexpr uint8_t MAX_TRACKS = 3;
+
+private:
+    struct Step {
+        const char* name;
+        StepFn fn;
+        uint8_t track;
+        int8_t after;              // step that must finish first, -1 = none
+        StepStatus status;
+        uint32_t startUs;          // since start()
+        uint32_t durationUs;
+    };
+
+    Step _steps[MAX_STEPS];
+    uint8_t _count;
+    uint8_t _current[MAX_TRACKS];  // next unfinished step of each track
+    uint32_t _resumeUs[MAX_TRACKS];
+    bool _paused[MAX_TRACKS];
+    uint32_t _startUs;
+    uint32_t _totalUs;
+    bool _started;
+    bool _finished;
+
+    uint8_t nextOnTrack(uint8_t track, uint8_t from) const;
+    bool isFinished(int8_t step) const;
+
+public:
+    BootSequencer();
+
+    /**
+     * Append a step to a track. Setup only, before start().
+     * @param after - index of a step (on any track) that must finish first
+     * @return the step's index, or -1 if full or track out of range
+     */
+    int8_t addStep(uint8_t track, const char* name, StepFn fn, int8_t after = -1);
+
+    /**
+     * Start the clock; the first run() begins every track
+     */
+    void start();
+
+    /**
+     * Advance each track by at most one step call
+     * @return true once, on the call that finished the last step
+     */
+    bool run();
+
+    bool isDone() const;
+    bool isStepDone(int8_t step) const;
+    uint8_t getFailureCount() const;
+
+    /**
+     * Per-step timings as FRAME_BOOT
+     */
+    void report(TelemetryWriter& telemetry);
+};
+
+#endif // BOOT_SEQUENCER_H
@@ -0,0 +1,50 @@
+/**
+ * CANBusMonitor.cpp - CAN Bus Load and Error Accounting Implementation
+ *
+ * Counter deltas use unsigned subtraction, so the 32-bit counters
+ * wrapping is harmless as long as a window is shorter than a wrap
+ * (hours, even at full load).
+ */
+
+#include "CANBusMonitor.h"
+
+using namespace Telemetry;
+
+CANBusMonitor::CANBusMonitor(CANInterface* can, uint32_t bitrate)
+    : _can(can), _bitrate(bitrate), _last(), _lastReportUs(0) {
+}
+
+void CANBusMonitor::report(TelemetryWriter& telemetry) {
+    CANBusStats now;
+    _can->getStats(now);
+    uint32_t nowUs = micros();
+    uint32_t windowUs = nowUs - _lastReportUs;
+    if (_lastReportUs == 0 || windowUs == 0) {
+        // First call only sets the baseline
+        _last = now;
+        _lastReportUs = nowUs;
+        return;
+    }
+
+    float windowS = windowUs * 1e-6f;
+    uint32_t rxFrames = now.rxFrames - _last.rxFrames;
+    uint32_t txFrames = now.txFrames - _last.txFrames;
+    uint32_t bits = (now.rxBits - _last.rxBits) + (now.txBits - _last.txBits);
+
+    CANBusPayload* p = telemetry.begin<CANBusPayload>(FRAME_CAN_BUS, nowUs);
+    p->bitrate = _bitrate;
+    p->windowMs = windowUs / 1000;
+    p->rxFramesPerS = (uint16_t)(rxFrames / windowS + 0.5f);
+    p->txFramesPerS = (uint16_t)(txFrames / windowS + 0.5f);
+    p->busLoadPermille = (uint16_t)(bits / windowS * 1000.0f / _bitrate + 0.5f);
+    p->txDropped = now.txDropped - _last.txDropped;
+    p->txErrorCounter = now.txErrorCounter;
+    p->rxErrorCounter = now.rxErrorCounter;
+    p->errorState = now.errorState;
+    p->txQueueDepth = now.txQueueDepth;
+    p->txQueueHighWater = now.txQueueHighWater;
+    telemetry.commit();
+
+    _last = now;
+    _lastReportUs = nowUs;
+}
@@ -0,0 +1,49 @@
+#ifndef CAN_BUS_MONITOR_H
+#define CAN_BUS_MONITOR_H
+
+#include <Arduino.h>
+#include "CANInterface.h"
+#include "TelemetryFrame.h"
+#include "TelemetryWriter.h"
+
+/**
+ * CANBusMonitor.h - CAN Bus Load and Error Accounting
+ *
+ * Turns the cumulative CANBusStats of a CANInterface into per-window
+ * rates and sends them as FRAME_CAN_BUS. Each report() covers the time
+ * since the previous one.
+ *
+ * Bus load is the worst-case frame length (canFrameBits, full stuffing)
+ * of everything sent and received in the window, divided by the bit
+ * rate. Real frames are a little shorter, so the figure errs high.
+ *
+ * Frames from other nodes that nobody receives (filtered out) are not
+ * counted; with only the ODrives on the bus that is nothing.
+ *
+ * Usage:
+ *   CANBusMonitor canMonitor(&canBus, Config::CAN_BUS_SPEED);
+ *   canMonitor.report(telemetry);   // from a slow loop slot
+ */
+class CANBusMonitor {
+private:
+    CANInterface* _can;
+    uint32_t _bitrate;
+    CANBusStats _last;
+    uint32_t _lastReportUs;
+
+public:
+    /**
+     * Constructor
+     * @param can - bus to monitor
+     * @param bitrate - nominal bit rate the bus was started with
+     */
+    CANBusMonitor(CANInterface* can, uint32_t bitrate);
+
+    /**
+     * Send FRAME_CAN_BUS for the window since the last call.
+     * Loop context only.
+     */
+    void report(TelemetryWriter& telemetry);
+};
+
+#endif // CAN_BUS_MONITOR_H
@@ -0,0 +1,106 @@
+#ifndef CAN_INTERFACE_H
+#define CAN_INTERFACE_H
+
+#include <Arduino.h>
+
+/**
+ * CANInterface.h - Hardware Abstraction Layer for a CAN Controller
+ *
+ * The motor drivers only need three things from CAN: send a classic frame
+ * without waiting, receive frames as they arrive, and bring the bus up.
+ * Keeping that behind an interface lets ODrive code run against a mock on
+ * the host as well as FlexCAN on the Teensy.
+ *
+ * Contract for implementations:
+ * - write() never blocks. It hands the frame to a free mailbox or a
+ *   software TX queue and returns false if both are full.
+ * - The receive handler runs in interrupt context, once per frame. Keep
+ *   it short.
+ *
+ * Usage:
+ *   FlexCANInterface can;
+ *   can.setReceiveHandler(onFrame, this);
+ *   can.begin(Config::CAN_BUS_SPEED);
+ *   can.write(frame);
+ */
+
+/**
+ * One classic CAN frame, standard or extended ID
+ * timestampUs: micros() when the frame was received (RX only)
+ */
+struct CANFrame {
+    uint32_t id;
+    uint8_t len;
+    bool extended;
+    uint8_t data[8];
+    uint32_t timestampUs;
+};
+
+/**
+ * Worst-case length on the wire of a classic data frame, including
+ * maximum bit stuffing, ACK, EOF and interframe space
+ * Standard ID: 47 + 8n fixed bits, 34 + 8n of them stuffable
+ * Extended ID: 67 + 8n fixed bits, 54 + 8n of them stuffable
+ */
+constexpr uint16_t canFrameBits(uint8_t len, bool extended) {
+    return extended ? (uint16_t)(67 + 8 * len + (53 + 8 * len) / 4)
+                    : (uint16_t)(47 + 8 * len + (33 + 8 * len) / 4);
+}
+
+/**
+ * Fault confinement state (ISO 11898-1)
+ */
+enum CANErrorState : uint8_t {
+    CAN_ERROR_ACTIVE  = 0,
+    CAN_ERROR_PASSIVE = 1,   // TEC or REC above 127
+    CAN_BUS_OFF       = 2    // TEC above 255, controller off the bus
+};
+
+/**
+ * Cumulative bus counters plus the controller's live error state.
+ * Counters never reset; take deltas to get rates.
+ */
+struct CANBusStats {
+    uint32_t rxFrames;
+    uint32_t txFrames;           // frames accepted by write()
+    uint32_t txDropped;          // frames refused by write()
+    uint32_t rxBits;             // canFrameBits() summed over rxFrames
+    uint32_t txBits;
+    uint8_t  txErrorCounter;     // TEC
+    uint8_t  rxErrorCounter;     // REC
+    CANErrorState errorState;
+    uint8_t  txQueueDepth;       // frames waiting for a mailbox right now
+    uint8_t  txQueueHighWater;
+};
+
+class CANInterface {
+public:
+    typedef void (*ReceiveHandler)(void* context, const CANFrame& frame);
+
+    /**
+     * Configure the controller and join the bus
+     * @param bitrate - nominal bit rate in bit/s
+     * @return true if the controller started
+     */
+    virtual bool begin(uint32_t bitrate) = 0;
+
+    /**
+     * Queue a frame for transmission. Never blocks.
+     * @return false if no mailbox or queue slot was free (frame dropped)
+     */
+    virtual bool write(const CANFrame& frame) = 0;
+
+    /**
+     * Register the callback for received frames (one per interface)
+     */
+    virtual void setReceiveHandler(ReceiveHandler handler, void* context) = 0;
+
+    /**
+     * Snapshot the bus counters. Loop context.
+     */
+    virtual void getStats(CANBusStats& stats) = 0;
+
+    virtual ~CANInterface() = default;
+};
+
+#endif // CAN_INTERFACE_H
@@ -0,0 +1,144 @@
+/**
+ * CollisionDetector.cpp - Impact Detection from IMU Jerk Implementation
+ *
+ * Quantization: jerk in JERK_LSB, angular acceleration in ANG_ACCEL_LSB.
+ * Both leave a uint16 far more range than the clipping at the threshold
+ * ever needs, and resolve the quiet baseline to a few percent.
+ */
+
+#include "CollisionDetector.h"
+#include "MemoryPlacement.h"
+#include <math.h>
+
+static constexpr float JERK_LSB = 0.5f;          // m/s³
+static constexpr float ANG_ACCEL_LSB = 0.05f;    // rad/s²
+
+static_assert(CollisionDetector::WINDOW >= 16, "COLLISION_WINDOW_SAMPLES too short for a baseline");
+static_assert(Config::COLLISION_JERK_FLOOR / JERK_LSB < 65535.0f &&
+              Config::COLLISION_ANG_ACCEL_FLOOR / ANG_ACCEL_LSB < 65535.0f,
+              "Collision floors exceed the window quantization range");
+
+// A sample grid step this much longer than nominal is a gap
+static constexpr uint32_t GAP_US = (uint32_t)(3.0f * 1e6f / CollisionDetector::SAMPLE_RATE_HZ);
+
+void CollisionDetector::WindowStats::reset() {
+    head = 0;
+    fill = 0;
+    sum = 0;
+    sumSq = 0;
+}
+
+HOT_CODE void CollisionDetector::WindowStats::push(uint16_t value) {
+    if (fill == WINDOW) {
+        uint16_t old = values[head];
+        sum -= old;
+        sumSq -= (uint32_t)old * old;
+    } else {
+        fill++;
+    }
+    values[head] = value;
+    sum += value;
+    sumSq += (uint32_t)value * value;
+    head = (head + 1) % WINDOW;
+}
+
+HOT_CODE float CollisionDetector::WindowStats::threshold(float lsb, float floor) const {
+    if (fill < WINDOW / 4) {
+        return floor;   // not enough baseline yet
+    }
+    float mean = (float)sum / fill;
+    float variance = (float)sumSq / fill - mean * mean;
+    float t = (mean + Config::COLLISION_SIGMA * sqrtf(variance > 0 ? variance : 0)) * lsb;
+    return t > floor ? t : floor;
+}
+
+static inline uint16_t quantize(float value, float lsb) {
+    float q = value / lsb + 0.5f;
+    return q < 65535.0f ? (uint16_t)q : 65535;
+}
+
+CollisionDetector::CollisionDetector()
+    : _bus(nullptr), _havePrevious(false), _previous(), _holdoffUntilUs(0), _holdoff(false),
+      _peakJerk(0), _peakAngularAccel(0), _collisions(0) {
+    _jerk.reset();
+    _angularAccel.reset();
+}
+
+void CollisionDetector::setEventBus(EventBus* bus) {
+    _bus = bus;
+}
+
+HOT_CODE void CollisionDetector::update(const IMUSample* samples, uint8_t count) {
+    if (!Config::COLLISION_ENABLED) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        const IMUSample& s = samples[i];
+        if (!_havePrevious || s.timestampUs - _previous.timestampUs > GAP_US) {
+            _previous = s;
+            _havePrevious = true;
+            continue;
+        }
+
+        float dax = s.accelX - _previous.accelX;
+        float day = s.accelY - _previous.accelY;
+        float daz = s.accelZ - _previous.accelZ;
+        float dgx = s.gyroX - _previous.gyroX;
+        float dgy = s.gyroY - _previous.gyroY;
+        float dgz = s.gyroZ - _previous.gyroZ;
+        _previous = s;
+
+        float jerk = sqrtf(dax * dax + day * day + daz * daz) * SAMPLE_RATE_HZ;
+        float angularAccel = sqrtf(dgx * dgx + dgy * dgy + dgz * dgz) * SAMPLE_RATE_HZ;
+
+        // Thresholds from the baseline before this sample
+        float jerkLimit = _jerk.threshold(JERK_LSB, Config::COLLISION_JERK_FLOOR);
+        float angularLimit = _angularAccel.threshold(ANG_ACCEL_LSB, Config::COLLISION_ANG_ACCEL_FLOOR);
+        _jerk.push(quantize(jerk < jerkLimit ? jerk : jerkLimit, JERK_LSB));
+        _angularAccel.push(quantize(angularAccel < angularLimit ? angularAccel : angularLimit, ANG_ACCEL_LSB));
+
+        if (jerk > _peakJerk) {
+            _peakJerk = jerk;
+        }
+        if (angularAccel > _peakAngularAccel) {
+            _peakAngularAccel = angularAccel;
+        }
+
+        if (_holdoff) {
+            if ((int32_t)(s.timestampUs - _holdoffUntilUs) < 0) {
+                continue;
+            }
+            _holdoff = false;
+        }
+
+        float score = jerk / jerkLimit;
+        float angularScore = angularAccel / angularLimit;
+        if (angularScore > score) {
+            score = angularScore;
+        }
+        if (score < 1.0f) {
+            continue;
+        }
+
+        _collisions++;
+        _holdoff = true;
+        _holdoffUntilUs = s.timestampUs + Config::COLLISION_HOLDOFF_MS * 1000UL;
+        if (_bus) {
+            CollisionEvent event = { s.timestampUs, score, jerk, angularAccel };
+            _bus->collision.publish(event);
+        }
+    }
+}
+
+uint32_t CollisionDetector::getCollisionCount() const {
+    return _collisions;
+}
+
+float CollisionDetector::getPeakJerk() const {
+    return _peakJerk;
+}
+
+float CollisionDetector::getPeakAngularAccel() const {
+    return _peakAngularAccel;
+}
@@ -0,0 +1,89 @@
+#ifndef COLLISION_DETECTOR_H
+#define COLLISION_DETECTOR_H
+
+#include <Arduino.h>
+#include <IMUConfig.h>
+#include "IMUInterface.h"
+#include "EventBus.h"
+
+/**
+ * CollisionDetector.h - Impact Detection from IMU Jerk
+ *
+ * Watches the full-rate FIFO stream for the step in acceleration an impact
+ * causes, and publishes a CollisionEvent on the bus from the balance ISR,
+ * in the same tick the sample was drained: within one control period of
+ * the impact, where the 30 Hz ToF would see it tens of ms later.
+ *
+ * Per sample:
+ * - jerk = |a[n] - a[n-1]| x rate and angular acceleration = |ω[n] - ω[n-1]|
+ *   x rate, over all three axes (independent of mounting)
+ * - Each is compared with its own threshold: mean + COLLISION_SIGMA x std
+ *   of the last COLLISION_WINDOW_SAMPLES values, at least the floor. The
+ *   window adapts to vibration (rough floor, motor noise) instead of a
+ *   fixed limit that is either deaf or jumpy.
+ * - Score = the larger of value / threshold; an event fires at score >= 1,
+ *   then the detector holds off for COLLISION_HOLDOFF_MS.
+ *
+ * Constant time: the windows keep quantized values with integer running
+ * sums, so mean and variance cost the same every sample and never drift.
+ * Values are clipped to the threshold before entering the window, so an
+ * impact doesn't raise the baseline it is measured against. A gap in the
+ * sample grid (FIFO reset) restarts the differences.
+ *
+ * Usage:
+ *   CollisionDetector collision;
+ *   collision.setEventBus(&eventBus);
+ *   collision.update(batch, batchCount);   // balance ISR, after updateBatch()
+ */
+class CollisionDetector {
+public:
+    static constexpr uint8_t WINDOW = Config::COLLISION_WINDOW_SAMPLES;
+    static constexpr float SAMPLE_RATE_HZ = Config::IMU_GYRO_ODR_HZ;   // the sample grid
+
+private:
+    // Sliding mean / variance over uint16 values, exact integer sums
+    struct WindowStats {
+        uint16_t values[WINDOW];
+        uint8_t head;
+        uint8_t fill;
+        uint32_t sum;
+        uint64_t sumSq;
+
+        void reset();
+        void push(uint16_t value);
+        float threshold(float lsb, float floor) const;
+    };
+
+    EventBus* _bus;
+    WindowStats _jerk;
+    WindowStats _angularAccel;
+
+    bool _havePrevious;
+    IMUSample _previous;
+    uint32_t _holdoffUntilUs;
+    bool _holdoff;
+
+    float _peakJerk;               // largest seen since construction
+    float _peakAngularAccel;
+    uint32_t _collisions;
+
+public:
+    CollisionDetector();
+
+    /**
+     * Publish CollisionEvents on a bus
+     * @param bus - event bus, or nullptr to only count
+     */
+    void setEventBus(EventBus* bus);
+
+    /**
+     * Feed the samples of one FIFO drain. Balance ISR only.
+     */
+    void update(const IMUSample* samples, uint8_t count);
+
+    uint32_t getCollisionCount() const;
+    float getPeakJerk() const;
+    float getPeakAngularAccel() const;
+};
+
+#endif // COLLISION_DETECTOR_H
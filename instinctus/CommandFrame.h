@@ -0,0 +1,144 @@
+#ifndef COMMAND_FRAME_H
+#define COMMAND_FRAME_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * CommandFrame.h - Binary Command Wire Format (Jetson -> Teensy)
+ *
+ * The return direction of TelemetryFrame.h, replacing the newline-delimited
+ * JSON planned for the cogitator link: parsing JSON on the control MCU is
+ * variable time, this is a fixed amount of work per byte.
+ *
+ * A command is a packet, COBS encoded and terminated by a single 0x00:
+ *
+ *   offset  size  field (decoded packet)
+ *   0       1     command type (CommandType)
+ *   1       1     sequence number, echoed in FRAME_COMMAND_ACK
+ *   2       4     send time, low 32 bits of the Jetson's microsecond clock
+ *   6       n     payload (one of the *Payload structs below, may be empty)
+ *   6+n     2     CRC-16/CCITT-FALSE over bytes 0 .. 6+n-1, little-endian
+ *
+ * COBS (Consistent Overhead Byte Stuffing) removes every 0x00 from the
+ * packet at a cost of one byte per 254, so 0x00 only ever means "end of
+ * packet". A receiver that starts mid-packet, or sees a bad CRC, loses
+ * that one packet and is back in sync at the next 0x00. Senders may also
+ * send a 0x00 before each packet to flush line noise.
+ *
+ * Every well-formed command (valid CRC, known type, correct payload
+ * length) is answered with FRAME_COMMAND_ACK carrying its type, sequence
+ * and CommandStatus. Malformed packets get no answer; they are counted
+ * in FRAME_LINK_HEALTH.
+ *
+ * The send time is what command latency is measured from (TimeSync.h);
+ * it must come from the same clock as the CMD_TIME_SYNC replies.
+ *
+ * Same conventions as telemetry: little-endian, IEEE-754 floats.
+ */
+
+namespace Commands {
+
+constexpr uint8_t MAX_PAYLOAD_SIZE = 16;
+constexpr uint8_t HEADER_SIZE = 6;                  // type, sequence, send time
+constexpr uint8_t MAX_PACKET_SIZE = HEADER_SIZE + MAX_PAYLOAD_SIZE + 2;
+
+enum CommandType : uint8_t {
+    CMD_PING            = 0x00,   // no payload, just acknowledged
+    CMD_SET_VELOCITY    = 0x01,   // SetVelocityPayload
+    CMD_ARM             = 0x02,
+    CMD_DISARM          = 0x03,
+    CMD_RESET_ESTOP     = 0x04,
+    CMD_TIME_SYNC       = 0x05,   // TimeSyncPayload, reply to FRAME_TIME_SYNC
+    CMD_SET_PARAM       = 0x10,   // SetParamPayload
+    CMD_SAVE_PARAMS     = 0x11,   // persist the current parameters (disarmed only)
+    CMD_RESET_PARAMS    = 0x12,   // back to the Config defaults, not persisted
+    CMD_GET_PARAMS      = 0x13    // answered with FRAME_PARAMS as well
+};
+
+enum CommandStatus : uint8_t {
+    STATUS_OK           = 0,
+    STATUS_REFUSED      = 1,      // valid, but not in the current state
+    STATUS_BAD_VALUE    = 2       // unknown parameter or value out of range
+};
+
+// Parameters for CMD_SET_PARAM (ParamStore). Gains are applied only
+// while disarmed; the rest take effect from the next control tick.
+enum ParamId : uint8_t {
+    PARAM_TILT_KP       = 0x01,
+    PARAM_TILT_KI       = 0x02,
+    PARAM_TILT_KD       = 0x03,
+    PARAM_VELOCITY_KP   = 0x04,
+    PARAM_VELOCITY_KI   = 0x05,
+    PARAM_TILT_ALPHA    = 0x10,   // complementary filter gyro weight
+    PARAM_TILT_CHANGE_THRESHOLD = 0x11,   // degrees
+    PARAM_EMERGENCY_TILT_ANGLE  = 0x12,   // degrees
+    PARAM_TOF_FRONT_WARN_MM     = 0x20,
+    PARAM_TOF_REAR_WARN_MM      = 0x21,
+    PARAM_TOF_BUDGET_IDLE_US    = 0x28,   // TOF_RANGING_PROFILES timing budgets
+    PARAM_TOF_BUDGET_CRUISE_US  = 0x29,
+    PARAM_TOF_BUDGET_FAST_US    = 0x2A
+};
+
+// CMD_SET_VELOCITY: wheel speed target, positive = forward
+struct __attribute__((packed)) SetVelocityPayload {
+    float revS;
+};
+
+// CMD_SET_PARAM
+struct __attribute__((packed)) SetParamPayload {
+    uint8_t paramId;               // ParamId
+    float   value;
+};
+
+// CMD_TIME_SYNC: Jetson half of a clock exchange, Jetson clock in µs
+struct __attribute__((packed)) TimeSyncPayload {
+    uint32_t teensyTxUs;           // t1, echoed from FRAME_TIME_SYNC
+    uint32_t jetsonRxUs;           // when that frame arrived
+    uint32_t jetsonTxUs;           // when this command was sent
+};
+
+/**
+ * Decoded, checked command as handed to the sketch
+ */
+struct Command {
+    uint8_t type;                  // CommandType
+    uint8_t sequence;
+    uint32_t sentUs;               // Jetson clock, from the packet
+    uint32_t receivedUs;           // Teensy micros() when the packet ended
+    union {
+        SetVelocityPayload velocity;
+        SetParamPayload param;
+        TimeSyncPayload timeSync;
+        uint8_t raw[MAX_PAYLOAD_SIZE];
+    };
+};
+
+/**
+ * Payload length a command type must carry
+ * @return length, or -1 for an unknown type
+ */
+inline int payloadSize(uint8_t type) {
+    switch (type) {
+        case CMD_PING:
+        case CMD_ARM:
+        case CMD_DISARM:
+        case CMD_RESET_ESTOP:
+        case CMD_SAVE_PARAMS:
+        case CMD_RESET_PARAMS:
+        case CMD_GET_PARAMS:
+            return 0;
+        case CMD_SET_VELOCITY:
+            return sizeof(SetVelocityPayload);
+        case CMD_SET_PARAM:
+            return sizeof(SetParamPayload);
+        case CMD_TIME_SYNC:
+            return sizeof(TimeSyncPayload);
+        default:
+            return -1;
+    }
+}
+
+} // namespace Commands
+
+#endif // COMMAND_FRAME_H
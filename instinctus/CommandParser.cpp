@@ -0,0 +1,96 @@
+/**
+ * CommandParser.cpp - Incremental COBS + CRC Command Decoder Implementation
+ *
+ * COBS block structure: a code byte n (1..255) is followed by n-1 data
+ * bytes; the block stands for those bytes plus an implied 0x00, except
+ * when n is 255 (a full block without a zero) or at the end of the packet.
+ * The implied zero is therefore only emitted when the next code byte
+ * arrives, which makes the end of the packet need no look-ahead.
+ */
+
+#include "CommandParser.h"
+#include "TelemetryFrame.h"
+
+using namespace Commands;
+
+CommandParser::CommandParser()
+    : _length(0), _blockRemaining(0), _zeroPending(false), _discard(false), _crc(0xFFFF),
+      _commands(), _accepted(0), _errors(0) {
+}
+
+void CommandParser::emit(uint8_t byte) {
+    if (_length >= MAX_PACKET_SIZE) {
+        _discard = true;   // longer than any command
+        return;
+    }
+    _buffer[_length++] = byte;
+    if (_length > 2) {
+        _crc = Telemetry::crc16(&_buffer[_length - 3], 1, _crc);
+    }
+}
+
+void CommandParser::feed(uint8_t byte) {
+    if (byte == 0x00) {
+        endPacket();
+        return;
+    }
+    if (_discard) {
+        return;
+    }
+
+    if (_blockRemaining == 0) {
+        // Code byte: close the previous block, start the next
+        if (_zeroPending) {
+            emit(0x00);
+        }
+        _blockRemaining = byte - 1;
+        _zeroPending = (byte != 0xFF);
+        return;
+    }
+
+    emit(byte);
+    _blockRemaining--;
+}
+
+void CommandParser::endPacket() {
+    bool valid = !_discard && _blockRemaining == 0 && _length >= HEADER_SIZE + 2;
+    if (valid) {
+        uint16_t received = (uint16_t)(_buffer[_length - 2] | (_buffer[_length - 1] << 8));
+        int payload = payloadSize(_buffer[0]);
+        valid = received == _crc && payload >= 0 && _length == HEADER_SIZE + payload + 2;
+        if (valid) {
+            Command command;
+            command.type = _buffer[0];
+            command.sequence = _buffer[1];
+            memcpy(&command.sentUs, &_buffer[2], sizeof(command.sentUs));
+            command.receivedUs = micros();
+            memcpy(command.raw, &_buffer[HEADER_SIZE], payload);
+            _accepted++;
+            if (!_commands.push(command)) {
+                _errors++;
+            }
+        }
+    }
+    // A lone delimiter (empty packet) is padding, not an error
+    if (!valid && (_length > 0 || _blockRemaining > 0 || _discard)) {
+        _errors++;
+    }
+
+    _length = 0;
+    _blockRemaining = 0;
+    _zeroPending = false;
+    _discard = false;
+    _crc = 0xFFFF;
+}
+
+bool CommandParser::pop(Command& command) {
+    return _commands.pop(command);
+}
+
+uint32_t CommandParser::getAcceptedCount() const {
+    return _accepted;
+}
+
+uint32_t CommandParser::getErrorCount() const {
+    return _errors;
+}
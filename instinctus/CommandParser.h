@@ -0,0 +1,77 @@
+#ifndef COMMAND_PARSER_H
+#define COMMAND_PARSER_H
+
+#include <Arduino.h>
+#include "CommandFrame.h"
+#include "SpscRing.h"
+
+/**
+ * CommandParser.h - Incremental COBS + CRC Command Decoder
+ *
+ * Byte-at-a-time state machine for the CommandFrame.h format. feed() does
+ * a bounded amount of work per byte (at most two decoded bytes, two CRC
+ * nibble steps each) and never allocates, so it can run from a UART RX
+ * interrupt or over a DMA buffer as well as from loop(). Checked commands
+ * go into an SPSC ring; the consumer pops them in loop().
+ *
+ * - COBS is undone on the fly: each decoded byte is stored as it arrives,
+ *   into a buffer of MAX_PACKET_SIZE
+ * - The CRC is computed on the fly too, lagging two bytes behind, so the
+ *   trailing CRC field never enters it and the packet end costs nothing
+ * - Any error (overlong packet, bad COBS, bad CRC, unknown type, wrong
+ *   payload length) drops the packet, counts it, and resyncs at the next
+ *   0x00
+ *
+ * Usage:
+ *   CommandParser parser;
+ *   while (Serial.available() > 0) {
+ *       parser.feed(Serial.read());        // producer: loop or RX ISR
+ *   }
+ *   Commands::Command cmd;
+ *   while (parser.pop(cmd)) {              // consumer: loop
+ *       execute(cmd);
+ *   }
+ */
+class CommandParser {
+private:
+    uint8_t _buffer[Commands::MAX_PACKET_SIZE];
+    uint8_t _length;               // decoded bytes so far
+    uint8_t _blockRemaining;       // data bytes left in the COBS block, 0 = next byte is a code
+    bool _zeroPending;             // current block ends in an implied 0x00
+    bool _discard;                 // error seen, skip to the next 0x00
+    uint16_t _crc;                 // over _buffer[0 .. _length - 3]
+
+    SpscRing<Commands::Command, 8, RingPolicy::DROP_NEWEST> _commands;
+
+    uint32_t _accepted;
+    uint32_t _errors;
+
+    void emit(uint8_t byte);
+    void endPacket();
+
+public:
+    CommandParser();
+
+    /**
+     * Consume one received byte. Single producer context.
+     */
+    void feed(uint8_t byte);
+
+    /**
+     * Take the next checked command. Loop context.
+     * @return false if none is waiting
+     */
+    bool pop(Commands::Command& command);
+
+    /**
+     * Packets turned into commands (including ones dropped on a full ring)
+     */
+    uint32_t getAcceptedCount() const;
+
+    /**
+     * Packets dropped as malformed, plus commands lost to a full ring
+     */
+    uint32_t getErrorCount() const;
+};
+
+#endif // COMMAND_PARSER_H
@@ -0,0 +1,48 @@
+/**
+ * ComplementaryTiltEstimator.cpp - Legacy Complementary Filter Implementation
+ *
+ * Filter Algorithm:
+ * 1. Calculate instantaneous tilt from accelerometer (atan2 method)
+ * 2. Integrate the pitch rate (-gyroY, the balance axis) over time delta
+ * 3. Blend: alpha * gyro_angle + (1 - alpha) * accel_angle, with alpha
+ *    rescaled from TILT_ALPHA at TILT_ALPHA_REFERENCE_DT
+ */
+
+#include "ComplementaryTiltEstimator.h"
+#include "MemoryPlacement.h"
+#include "FastMath.h"
+#include <BalanceConfig.h>
+
+ComplementaryTiltEstimator::ComplementaryTiltEstimator()
+    : _tiltAngle(0), _params(nullptr) {
+}
+
+void ComplementaryTiltEstimator::setParams(const ParamStore* params) {
+    _params = params;
+}
+
+void ComplementaryTiltEstimator::reset() {
+    _tiltAngle = 0;
+}
+
+HOT_CODE float ComplementaryTiltEstimator::update(const IMUSample& sample, float deltaTime) {
+    // Tilt around the Y axis: forward/back lean in robot frame (X=forward, Z=up)
+    float accelTilt = FastMath::toDegrees(FastMath::fastAtan2(sample.accelX, sample.accelZ));
+
+    // High-pass filter on gyro, low-pass filter on accelerometer
+    // alpha is rescaled from the reference interval so the time constant
+    // tau = alpha * dt / (1 - alpha) does not shrink as the sample rate rises
+    constexpr float defaultTau = Config::TILT_ALPHA * Config::TILT_ALPHA_REFERENCE_DT /
+                                 (1.0f - Config::TILT_ALPHA);
+    float tau = _params ? _params->active().tiltTauS : defaultTau;
+    float alpha = tau / (tau + deltaTime);
+
+    // Rate about the same axis: body pitch about +Y is -tilt in this convention
+    float gyroAngle = _tiltAngle + FastMath::toDegrees(-sample.gyroY) * deltaTime;
+    _tiltAngle = alpha * gyroAngle + (1.0f - alpha) * accelTilt;
+    return _tiltAngle;
+}
+
+const char* ComplementaryTiltEstimator::getName() const {
+    return "complementary";
+}
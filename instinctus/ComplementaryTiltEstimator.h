@@ -0,0 +1,40 @@
+#ifndef COMPLEMENTARY_TILT_ESTIMATOR_H
+#define COMPLEMENTARY_TILT_ESTIMATOR_H
+
+#include "TiltEstimator.h"
+#include "ParamStore.h"
+
+/**
+ * ComplementaryTiltEstimator.h - Legacy Complementary Filter
+ *
+ * The filter BalanceIMU has always used, moved behind TiltEstimator:
+ * accelerometer tilt atan2(accelX, accelZ) blended with the integrated
+ * pitch rate -gyroY (rotation about +Y is negative tilt in BalanceIMU's
+ * convention), with Config::TILT_ALPHA rescaled per sample so the time
+ * constant does not depend on the IMU rate.
+ *
+ * Cheap (one atan2, a handful of multiplies) but single-axis, and any
+ * linear acceleration along X leaks straight into accelTilt.
+ *
+ * With a ParamStore attached the time constant follows PARAM_TILT_ALPHA.
+ */
+class ComplementaryTiltEstimator : public TiltEstimator {
+private:
+    float _tiltAngle;
+    const ParamStore* _params;
+
+public:
+    ComplementaryTiltEstimator();
+
+    /**
+     * Take alpha from runtime parameters
+     * @param params - parameter store, or nullptr for Config::TILT_ALPHA
+     */
+    void setParams(const ParamStore* params);
+
+    void reset() override;
+    float update(const IMUSample& sample, float deltaTime) override;
+    const char* getName() const override;
+};
+
+#endif // COMPLEMENTARY_TILT_ESTIMATOR_H
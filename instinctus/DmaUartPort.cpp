@@ -0,0 +1,88 @@
+/**
+ * DmaUartPort.cpp - Serial1 eDMA Transmit Implementation
+ *
+ * Handoff between loop and ISR: the loop copies into the fill half with
+ * _writing set, so a completion landing mid-copy only marks the channel
+ * idle and leaves the half alone; the loop then starts it itself. Every
+ * swap of halves happens with interrupts off, in kick().
+ */
+
+#include "DmaUartPort.h"
+#include "MemoryPlacement.h"
+#include <BoardConfig.h>
+
+static constexpr uint16_t HALF_BYTES = Config::LINK_UART_DMA_BUFFER_BYTES;
+
+// Cache-line aligned so the cache flush covers exactly the buffers
+BULK_DATA alignas(32) static uint8_t stagingBuffers[2][HALF_BYTES];
+
+static DmaUartPort* instance = nullptr;
+
+DmaUartPort::DmaUartPort()
+    : _dma(), _fillHalf(0), _fillCount(0), _busy(false), _writing(false), _started(false) {
+}
+
+COLD_CODE bool DmaUartPort::begin(uint32_t baud) {
+    if (instance && instance != this) {
+        return false;
+    }
+    instance = this;
+
+    Serial1.begin(baud);
+    _dma.begin();
+    _dma.destination(*(volatile uint8_t*)&LPUART6_DATA);
+    _dma.triggerAtHardwareEvent(DMAMUX_SOURCE_LPUART6_TX);
+    _dma.disableOnCompletion();
+    _dma.interruptAtCompletion();
+    _dma.attachInterrupt(completeIsr);
+    LPUART6_BAUD |= LPUART_BAUD_TDMAE;
+    _started = true;
+    return true;
+}
+
+HOT_CODE void DmaUartPort::kick() {
+    if (_busy || _fillCount == 0) {
+        return;
+    }
+    uint8_t* half = stagingBuffers[_fillHalf];
+    arm_dcache_flush(half, _fillCount);
+    _dma.sourceBuffer(half, _fillCount);
+    _dma.enable();
+    _busy = true;
+    _fillHalf ^= 1;
+    _fillCount = 0;
+}
+
+HOT_CODE void DmaUartPort::completeIsr() {
+    instance->_dma.clearInterrupt();
+    instance->_busy = false;
+    if (!instance->_writing) {
+        instance->kick();
+    }
+}
+
+size_t DmaUartPort::write(uint8_t b) {
+    return write(&b, 1);
+}
+
+size_t DmaUartPort::write(const uint8_t* buffer, size_t size) {
+    if (!_started) {
+        return 0;
+    }
+    _writing = true;
+    size_t room = HALF_BYTES - _fillCount;
+    if (size > room) {
+        size = room;
+    }
+    memcpy(stagingBuffers[_fillHalf] + _fillCount, buffer, size);
+    __disable_irq();
+    _fillCount += size;
+    _writing = false;
+    kick();
+    __enable_irq();
+    return size;
+}
+
+int DmaUartPort::availableForWrite() {
+    return _started ? HALF_BYTES - _fillCount : 0;
+}
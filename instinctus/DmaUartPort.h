@@ -0,0 +1,56 @@
+#ifndef DMA_UART_PORT_H
+#define DMA_UART_PORT_H
+
+#include <Arduino.h>
+#include <DMAChannel.h>
+
+/**
+ * DmaUartPort.h - Serial1 (LPUART6) Transmit Through eDMA
+ *
+ * A Print that sends on Serial1 without a byte-per-interrupt TX ISR: at
+ * multi-megabaud rates HardwareSerial's TX interrupt would fire every few
+ * microseconds. Bytes are staged in one half of a double buffer while
+ * the DMA channel streams the other half to LPUART6_DATA, paced by the
+ * UART's TX DMA request; the completion interrupt starts the next half.
+ *
+ * - availableForWrite() is the space left in the staging half, so
+ *   TelemetryLink never hands over more than fits (write never blocks)
+ * - Staging halves live in OCRAM and are flushed from the data cache
+ *   before each transfer
+ * - RX stays with HardwareSerial (Serial1.read() as usual)
+ *
+ * One instance (Serial1 and its buffers are fixed). Loop context, except
+ * the completion ISR.
+ *
+ * Usage:
+ *   DmaUartPort uartPort;
+ *   uartPort.begin(Config::LINK_UART_BAUD);
+ *   link.setPort(1, &uartPort);
+ */
+class DmaUartPort : public Print {
+private:
+    DMAChannel _dma;
+    volatile uint8_t _fillHalf;         // half being staged by the loop
+    volatile uint16_t _fillCount;
+    volatile bool _busy;                // a transfer is running
+    volatile bool _writing;             // loop is copying into the fill half
+    bool _started;
+
+    void kick();                        // interrupts must be off
+    static void completeIsr();
+
+public:
+    DmaUartPort();
+
+    /**
+     * Start Serial1 and the TX DMA channel. Setup only.
+     * @return false if a second instance was started
+     */
+    bool begin(uint32_t baud);
+
+    size_t write(uint8_t b) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    int availableForWrite() override;
+};
+
+#endif // DMA_UART_PORT_H
@@ -0,0 +1,55 @@
+/**
+ * DriveCoordinator.cpp - Left/Right Wheel Pair Implementation
+ *
+ * The motors are mounted mirror-image, so one of them turns backwards for
+ * forward travel; Config::MOTOR_*.direction holds the sign.
+ */
+
+#include "DriveCoordinator.h"
+#include "MemoryPlacement.h"
+#include <MotorConfig.h>
+
+DriveCoordinator::DriveCoordinator(ODriveAxis* left, ODriveAxis* right)
+    : _left(left), _right(right) {
+}
+
+HOT_CODE bool DriveCoordinator::setMotorSpeeds(float leftRevS, float rightRevS) {
+    // Evaluate both: a failed left frame must not skip the right one
+    bool leftOk = _left->setInputVelocity(leftRevS * Config::MOTOR_LEFT.direction);
+    bool rightOk = _right->setInputVelocity(rightRevS * Config::MOTOR_RIGHT.direction);
+    return leftOk && rightOk;
+}
+
+HOT_CODE bool DriveCoordinator::stop() {
+    return setMotorSpeeds(0.0f, 0.0f);
+}
+
+bool DriveCoordinator::enable() {
+    bool ok = _left->clearErrors();
+    ok = _right->clearErrors() && ok;
+    ok = _left->requestState(ODriveAxis::AXIS_STATE_CLOSED_LOOP_CONTROL) && ok;
+    ok = _right->requestState(ODriveAxis::AXIS_STATE_CLOSED_LOOP_CONTROL) && ok;
+    return ok;
+}
+
+bool DriveCoordinator::disable() {
+    bool leftOk = _left->requestState(ODriveAxis::AXIS_STATE_IDLE);
+    bool rightOk = _right->requestState(ODriveAxis::AXIS_STATE_IDLE);
+    return leftOk && rightOk;
+}
+
+bool DriveCoordinator::getWheelSpeeds(float& leftRevS, float& rightRevS) const {
+    uint32_t oldestUs;
+    return getWheelSpeeds(leftRevS, rightRevS, oldestUs);
+}
+
+HOT_CODE bool DriveCoordinator::getWheelSpeeds(float& leftRevS, float& rightRevS, uint32_t& oldestUs) const {
+    ODriveAxis::EncoderEstimate left, right;
+    if (!_left->getEncoderEstimate(left) || !_right->getEncoderEstimate(right)) {
+        return false;
+    }
+    leftRevS = left.velocityRevS * Config::MOTOR_LEFT.direction;
+    rightRevS = right.velocityRevS * Config::MOTOR_RIGHT.direction;
+    oldestUs = ((int32_t)(left.timestampUs - right.timestampUs) < 0) ? left.timestampUs : right.timestampUs;
+    return true;
+}
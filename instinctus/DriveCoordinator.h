@@ -0,0 +1,69 @@
+#ifndef DRIVE_COORDINATOR_H
+#define DRIVE_COORDINATOR_H
+
+#include "ODriveAxis.h"
+
+/**
+ * DriveCoordinator.h - Left/Right Wheel Pair on Two ODrive Axes
+ *
+ * The interface BalanceMotorController drives: speeds for both wheels in
+ * robot terms (positive = forward), converted to per-axis velocity
+ * setpoints with each motor's mounting direction applied.
+ *
+ * Batched Setpoints:
+ * - setMotorSpeeds() queues both Set_Input_Vel frames back to back in the
+ *   same call, so both wheels are updated in the same control tick and
+ *   the frames normally leave in adjacent mailbox slots.
+ * - Never blocks: if the bus cannot take a frame right now it is counted
+ *   (ODriveAxis::getTxFailureCount) and the next tick's setpoint
+ *   supersedes it.
+ *
+ * Usage:
+ *   DriveCoordinator drive(&leftAxis, &rightAxis);
+ *   drive.enable();                // closed loop on both axes
+ *   drive.setMotorSpeeds(1.0f, 1.0f);
+ *   drive.stop();
+ */
+class DriveCoordinator {
+private:
+    ODriveAxis* _left;
+    ODriveAxis* _right;
+
+public:
+    DriveCoordinator(ODriveAxis* left, ODriveAxis* right);
+
+    /**
+     * Command both wheel speeds in the same tick
+     * @param leftRevS, rightRevS - wheel speeds in rev/s, positive = forward
+     * @return true if both frames were queued
+     */
+    bool setMotorSpeeds(float leftRevS, float rightRevS);
+
+    /**
+     * Zero both velocity setpoints (axes stay in closed loop, holding)
+     */
+    bool stop();
+
+    /**
+     * Clear latched errors and put both axes into closed-loop control
+     */
+    bool enable();
+
+    /**
+     * Put both axes into IDLE (motors unpowered, wheels coast)
+     */
+    bool disable();
+
+    /**
+     * Wheel speeds in robot terms (positive = forward) from the encoders
+     * @return false until both axes have reported an estimate
+     */
+    bool getWheelSpeeds(float& leftRevS, float& rightRevS) const;
+
+    /**
+     * As above, plus the arrival time of the older of the two estimates
+     */
+    bool getWheelSpeeds(float& leftRevS, float& rightRevS, uint32_t& oldestUs) const;
+};
+
+#endif // DRIVE_COORDINATOR_H
@@ -0,0 +1,493 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <Arduino.h>
+#include <BalanceConfig.h>
+#include "SpscRing.h"
+#include "TelemetryFrame.h"
+
+/**
+ * EventBus.h - Typed, Statically Allocated Publish/Subscribe Bus
+ *
+ * Replaces the single-pointer observers (BalanceObserver, ObstacleObserver,
+ * CollisionObserver). Each event type has its own Topic with a fixed
+ * subscriber table and a fixed deferred queue; nothing is allocated and
+ * publishing never blocks.
+ *
+ * Dispatch Modes:
+ * - IMMEDIATE: called inside publish(), in the publisher's context (the
+ *   balance ISR for balance topics). For safety reactions only: no
+ *   Serial, no waiting, a few microseconds at most.
+ * - DEFERRED: publish() copies the event into the topic's queue once;
+ *   dispatchDeferred() delivers it from loop(). For telemetry, logging,
+ *   anything slow. A full queue drops the new event and counts it.
+ *
+ * Coalescing Topics:
+ * - Topics whose events repeat while a condition lasts (tilt wobble, an
+ *   obstacle in range) are CoalescingTopics. Instead of a queue they keep
+ *   one slot per key (coalesceKey(), e.g. sensor side); publishing into a
+ *   pending slot replaces its value and bumps its count.
+ * - A token bucket limits how many events per second leave for the
+ *   deferred subscribers; the rest of the time slots keep merging. So link
+ *   traffic and storage stay bounded however fast the publisher fires,
+ *   and subscribers see the latest value plus how many it stands for.
+ * - Immediate subscribers still see every event. Emergency and collision
+ *   are plain Topics: never merged, never rate limited by the bus. The
+ *   emergency publisher queues for deferred subscribers only on the rising
+ *   edge and at Config::EMERGENCY_REASSERT_MS while it lasts, and
+ *   publishImmediate()s the ticks in between.
+ *
+ * Deferred handlers return false to say "not now" (e.g. link full): the
+ * event stays queued and delivery resumes at that subscriber on the next
+ * dispatchDeferred(), so subscribers before it don't see it twice.
+ * Immediate handlers' return values are ignored.
+ *
+ * Publishers decide what is worth publishing (thresholds live with the
+ * sensor); subscribers get every event on their topic.
+ *
+ * Rules:
+ * - Subscribe during setup(), before any publisher runs.
+ * - One publishing context per topic (the deferred queue is SPSC; the
+ *   coalescing slots assume a publisher that loop() can mask), and
+ *   dispatchDeferred() from loop() only.
+ *
+ * Usage:
+ *   eventBus.emergency.subscribe<BalanceMotorController,
+ *       &BalanceMotorController::onBalanceEmergency>(&controller, Dispatch::IMMEDIATE);
+ *   eventBus.tilt.subscribe<JetsonBridge, &JetsonBridge::onTilt>(&bridge, Dispatch::DEFERRED);
+ *   eventBus.tilt.publish(event);      // balance ISR
+ *   eventBus.dispatchDeferred(8);      // loop slot
+ */
+
+enum class Dispatch : uint8_t {
+    IMMEDIATE,
+    DEFERRED
+};
+
+template <typename Event, uint8_t MaxSubscribers, size_t QueueDepth>
+class Topic {
+public:
+    typedef bool (*Handler)(void* context, const Event& event);
+
+private:
+    struct Subscriber {
+        Handler handler;
+        void* context;
+        Dispatch mode;
+    };
+
+    template <typename T, bool (T::*Method)(const Event&)>
+    static bool invoke(void* context, const Event& event) {
+        return (static_cast<T*>(context)->*Method)(event);
+    }
+
+    Subscriber _subscribers[MaxSubscribers];
+    uint8_t _count;
+    uint8_t _deferredCount;
+    uint8_t _resumeAt;             // next subscriber for the head event
+    SpscRing<Event, QueueDepth, RingPolicy::DROP_NEWEST> _queue;
+
+public:
+    Topic() : _subscribers(), _count(0), _deferredCount(0), _resumeAt(0), _queue() {}
+
+    /**
+     * Add a subscriber. Setup only.
+     * @return false if the subscriber table is full
+     */
+    bool subscribe(Handler handler, void* context, Dispatch mode) {
+        if (!handler || _count >= MaxSubscribers) {
+            return false;
+        }
+        _subscribers[_count].handler = handler;
+        _subscribers[_count].context = context;
+        _subscribers[_count].mode = mode;
+        _count++;
+        if (mode == Dispatch::DEFERRED) {
+            _deferredCount++;
+        }
+        return true;
+    }
+
+    /**
+     * Subscribe a member function, bound at compile time
+     */
+    template <typename T, bool (T::*Method)(const Event&)>
+    bool subscribe(T* object, Dispatch mode) {
+        return subscribe(&invoke<T, Method>, object, mode);
+    }
+
+    /**
+     * Run immediate subscribers now and queue the event once for the
+     * deferred ones. Never blocks.
+     */
+    void publish(const Event& event) {
+        for (uint8_t i = 0; i < _count; i++) {
+            if (_subscribers[i].mode == Dispatch::IMMEDIATE) {
+                _subscribers[i].handler(_subscribers[i].context, event);
+            }
+        }
+        if (_deferredCount) {
+            _queue.push(event);
+        }
+    }
+
+    /**
+     * Run immediate subscribers only, for a repeat the deferred ones
+     * already have (see BalanceIMU's emergency reassert). Never blocks.
+     */
+    void publishImmediate(const Event& event) {
+        for (uint8_t i = 0; i < _count; i++) {
+            if (_subscribers[i].mode == Dispatch::IMMEDIATE) {
+                _subscribers[i].handler(_subscribers[i].context, event);
+            }
+        }
+    }
+
+    /**
+     * Deliver up to budget queued events to the deferred subscribers.
+     * Loop context only.
+     * @return events fully delivered
+     */
+    uint8_t dispatchDeferred(uint8_t budget) {
+        uint8_t delivered = 0;
+        Event event;
+        while (delivered < budget && _queue.peek(event)) {
+            for (; _resumeAt < _count; _resumeAt++) {
+                const Subscriber& s = _subscribers[_resumeAt];
+                if (s.mode == Dispatch::DEFERRED && !s.handler(s.context, event)) {
+                    return delivered;  // Subscriber busy, retry from here next time
+                }
+            }
+            _resumeAt = 0;
+            _queue.pop(event);
+            delivered++;
+        }
+        return delivered;
+    }
+
+    uint8_t getSubscriberCount() const {
+        return _count;
+    }
+
+    uint32_t getDropCount() const {
+        return _queue.getDropCount();
+    }
+
+    uint32_t getHighWater() const {
+        return _queue.getHighWater();
+    }
+};
+
+/**
+ * Rate limiter for deferred delivery: up to burst events at once, refilled
+ * at rateHz. Credit is kept in microseconds, no floats. Loop context.
+ */
+class TokenBucket {
+private:
+    uint32_t _costUs;              // credit per token
+    uint32_t _capacityUs;
+    uint32_t _creditUs;
+    uint32_t _lastUs;
+
+public:
+    TokenBucket(uint16_t rateHz, uint8_t burst)
+        : _costUs(1000000UL / rateHz), _capacityUs(_costUs * burst),
+          _creditUs(_costUs * burst), _lastUs(0) {}
+
+    /**
+     * Take one token if available
+     */
+    bool take(uint32_t nowUs) {
+        uint32_t elapsed = nowUs - _lastUs;
+        _lastUs = nowUs;
+        _creditUs = (elapsed >= _capacityUs - _creditUs) ? _capacityUs : _creditUs + elapsed;
+        if (_creditUs < _costUs) {
+            return false;
+        }
+        _creditUs -= _costUs;
+        return true;
+    }
+};
+
+/**
+ * Topic with "latest value wins" slots instead of a deferred queue, see
+ * Coalescing Topics above. Event needs a uint16_t count field (set on
+ * delivery) and a coalesceKey(const Event&) overload returning < Keys.
+ */
+template <typename Event, uint8_t MaxSubscribers, uint8_t Keys>
+class CoalescingTopic {
+public:
+    typedef bool (*Handler)(void* context, const Event& event);
+
+private:
+    struct Subscriber {
+        Handler handler;
+        void* context;
+        Dispatch mode;
+    };
+
+    struct Slot {
+        Event event;
+        uint16_t count;            // publishes merged into event
+        bool pending;
+    };
+
+    template <typename T, bool (T::*Method)(const Event&)>
+    static bool invoke(void* context, const Event& event) {
+        return (static_cast<T*>(context)->*Method)(event);
+    }
+
+    Subscriber _subscribers[MaxSubscribers];
+    uint8_t _count;
+    uint8_t _deferredCount;
+    Slot _slots[Keys];             // written by the publisher, taken by loop()
+    TokenBucket _bucket;
+
+    Event _inFlight;               // taken from a slot, being delivered
+    bool _inFlightValid;
+    uint8_t _resumeAt;             // next subscriber for _inFlight
+    uint8_t _nextKey;              // round robin between keys
+    uint8_t _highWater;            // most slots pending at once
+    uint32_t _coalesced;           // publishes merged into a pending event
+
+    // Move the next pending slot into _inFlight, if a token allows it
+    bool takePending(uint32_t nowUs) {
+        bool taken = false;
+        __disable_irq();
+        for (uint8_t i = 0; i < Keys; i++) {
+            uint8_t key = (_nextKey + i) % Keys;
+            if (_slots[key].pending) {
+                if (_bucket.take(nowUs)) {
+                    _inFlight = _slots[key].event;
+                    _inFlight.count = _slots[key].count;
+                    _slots[key].pending = false;
+                    _nextKey = (key + 1) % Keys;
+                    taken = true;
+                }
+                break;
+            }
+        }
+        __enable_irq();
+        return taken;
+    }
+
+public:
+    CoalescingTopic(uint16_t rateHz, uint8_t burst)
+        : _subscribers(), _count(0), _deferredCount(0), _slots(), _bucket(rateHz, burst),
+          _inFlight(), _inFlightValid(false), _resumeAt(0), _nextKey(0), _highWater(0), _coalesced(0) {}
+
+    /**
+     * Add a subscriber. Setup only.
+     * @return false if the subscriber table is full
+     */
+    bool subscribe(Handler handler, void* context, Dispatch mode) {
+        if (!handler || _count >= MaxSubscribers) {
+            return false;
+        }
+        _subscribers[_count].handler = handler;
+        _subscribers[_count].context = context;
+        _subscribers[_count].mode = mode;
+        _count++;
+        if (mode == Dispatch::DEFERRED) {
+            _deferredCount++;
+        }
+        return true;
+    }
+
+    /**
+     * Subscribe a member function, bound at compile time
+     */
+    template <typename T, bool (T::*Method)(const Event&)>
+    bool subscribe(T* object, Dispatch mode) {
+        return subscribe(&invoke<T, Method>, object, mode);
+    }
+
+    /**
+     * Run immediate subscribers now and merge the event into its key's
+     * slot for the deferred ones. Never blocks.
+     */
+    void publish(const Event& event) {
+        for (uint8_t i = 0; i < _count; i++) {
+            if (_subscribers[i].mode == Dispatch::IMMEDIATE) {
+                _subscribers[i].handler(_subscribers[i].context, event);
+            }
+        }
+        if (!_deferredCount) {
+            return;
+        }
+
+        uint8_t key = coalesceKey(event);
+        Slot& slot = _slots[key < Keys ? key : Keys - 1];
+        if (slot.pending) {
+            if (slot.count < 0xFFFF) {
+                slot.count++;
+            }
+            _coalesced++;
+        } else {
+            slot.count = 1;
+        }
+        slot.event = event;
+        slot.pending = true;
+
+        uint8_t pending = 0;
+        for (uint8_t i = 0; i < Keys; i++) {
+            pending += _slots[i].pending;
+        }
+        if (pending > _highWater) {
+            _highWater = pending;
+        }
+    }
+
+    /**
+     * Deliver up to budget merged events, as far as the token bucket
+     * allows. Loop context only.
+     * @return events fully delivered
+     */
+    uint8_t dispatchDeferred(uint8_t budget) {
+        uint8_t delivered = 0;
+        uint32_t now = micros();
+        while (delivered < budget) {
+            if (!_inFlightValid) {
+                if (!takePending(now)) {
+                    break;
+                }
+                _inFlightValid = true;
+            }
+            for (; _resumeAt < _count; _resumeAt++) {
+                const Subscriber& s = _subscribers[_resumeAt];
+                if (s.mode == Dispatch::DEFERRED && !s.handler(s.context, _inFlight)) {
+                    return delivered;  // Subscriber busy, retry from here next time
+                }
+            }
+            _resumeAt = 0;
+            _inFlightValid = false;
+            delivered++;
+        }
+        return delivered;
+    }
+
+    uint8_t getSubscriberCount() const {
+        return _count;
+    }
+
+    /**
+     * Always 0: a full slot merges, it never drops
+     */
+    uint32_t getDropCount() const {
+        return 0;
+    }
+
+    uint32_t getHighWater() const {
+        return _highWater;
+    }
+
+    /**
+     * Publishes merged into an already pending event
+     */
+    uint32_t getCoalescedCount() const {
+        return _coalesced;
+    }
+};
+
+/**
+ * Event payloads. timestampUs is when the condition was detected; for a
+ * coalesced event it and the values are the latest merged in, count says
+ * how many publishes it stands for.
+ */
+struct TiltEvent {
+    uint32_t timestampUs;
+    float angle;                   // degrees, BalanceIMU convention
+    uint16_t count;                // set by the topic
+};
+
+struct BalanceEmergencyEvent {
+    uint32_t timestampUs;
+    float angle;                   // worst tilt in the batch that tripped it
+};
+
+struct ObstacleEvent {
+    uint32_t timestampUs;
+    Telemetry::SensorId sensorId;
+    float distanceMm;              // tracked, nearest confirmed target
+    float closingMmS;              // positive = approaching
+    float timeToContactS;          // Config::TOF_NO_CONTACT_S if not closing
+    uint16_t count;                // set by the topic
+};
+
+struct CollisionEvent {
+    uint32_t timestampUs;
+    float magnitude;               // detector-specific severity, >= 1 = over threshold
+    float jerkMS3;                 // |da/dt| of the triggering sample
+    float angularAccelRadS2;       // |dω/dt| of the triggering sample
+};
+
+// Coalescing keys: one slot per thing whose latest state matters
+inline uint8_t coalesceKey(const TiltEvent&) {
+    return 0;
+}
+
+inline uint8_t coalesceKey(const ObstacleEvent& event) {
+    return event.sensorId;
+}
+
+/**
+ * The sketch's topics. Publishing contexts:
+ * - tilt, emergency, collision: balance ISR
+ * - obstacle: loop (ToF slot)
+ */
+struct EventBus {
+    static constexpr uint8_t MAX_SUBSCRIBERS = 4;
+
+    Topic<BalanceEmergencyEvent, MAX_SUBSCRIBERS, 8> emergency;
+    Topic<CollisionEvent, MAX_SUBSCRIBERS, 8> collision;
+    CoalescingTopic<TiltEvent, MAX_SUBSCRIBERS, 1> tilt;
+    CoalescingTopic<ObstacleEvent, MAX_SUBSCRIBERS, 2> obstacle;   // key: SensorId
+
+    EventBus()
+        : tilt(Config::TILT_EVENT_RATE_HZ, Config::TILT_EVENT_BURST),
+          obstacle(Config::OBSTACLE_EVENT_RATE_HZ, Config::OBSTACLE_EVENT_BURST) {}
+
+    /**
+     * Deliver deferred events, most urgent topic first, up to budget
+     * events in total. Loop context only.
+     */
+    uint8_t dispatchDeferred(uint8_t budget) {
+        uint8_t delivered = emergency.dispatchDeferred(budget);
+        delivered += collision.dispatchDeferred(budget - delivered);
+        delivered += tilt.dispatchDeferred(budget - delivered);
+        delivered += obstacle.dispatchDeferred(budget - delivered);
+        return delivered;
+    }
+
+    /**
+     * Deferred events dropped on full queues, all topics
+     */
+    uint32_t getDropCount() const {
+        return emergency.getDropCount() + collision.getDropCount() +
+               tilt.getDropCount() + obstacle.getDropCount();
+    }
+
+    /**
+     * Events merged on the coalescing topics, all topics
+     */
+    uint32_t getCoalescedCount() const {
+        return tilt.getCoalescedCount() + obstacle.getCoalescedCount();
+    }
+
+    /**
+     * Deepest deferred queue occupancy seen on any topic
+     */
+    uint32_t getHighWater() const {
+        uint32_t levels[] = { emergency.getHighWater(), collision.getHighWater(),
+                              tilt.getHighWater(), obstacle.getHighWater() };
+        uint32_t high = 0;
+        for (uint32_t level : levels) {
+            if (level > high) {
+                high = level;
+            }
+        }
+        return high;
+    }
+};
+
+#endif // EVENT_BUS_H
@@ -0,0 +1,72 @@
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include <math.h>
+
+/**
+ * FastMath.h - Single-Precision Math for the Balance Path
+ *
+ * The i.MX RT1062's FPU does handle doubles in hardware, but double divides
+ * and multiplies cost several times their float equivalents, and libm's
+ * atan2() is a long double-precision routine. Arduino's PI and RAD_TO_DEG
+ * are double literals, so "x * 180.0 / PI" quietly promotes the whole
+ * expression. Everything here stays in float.
+ *
+ * fastAtan2:
+ * - Octant reduction to |z| <= 1 plus a 6-term odd minimax polynomial
+ * - Max error about 2e-6 rad (1e-4 deg), far below accelerometer noise
+ * - Branches only on signs and |y| vs |x|; no division by zero for (0, 0)
+ *
+ * CMSIS-DSP's arm_atan2_f32 only exists in newer CMSIS-DSP releases than
+ * the one bundled with Teensyduino, so it is not used.
+ */
+namespace FastMath {
+
+constexpr float PI_F         = 3.14159265358979f;
+constexpr float HALF_PI_F    = 1.57079632679490f;
+constexpr float RAD_TO_DEG_F = 57.2957795130823f;
+constexpr float DEG_TO_RAD_F = 0.0174532925199433f;
+
+/**
+ * atan(z) for |z| <= 1
+ */
+inline float atanUnit(float z) {
+    float z2 = z * z;
+    return z * (0.99997726f + z2 * (-0.33262347f + z2 * (0.19354346f +
+               z2 * (-0.11643287f + z2 * (0.05265332f + z2 * -0.01172120f)))));
+}
+
+/**
+ * Float atan2 matching atan2f() to about 2e-6 rad, (0, 0) returns 0
+ */
+inline float fastAtan2(float y, float x) {
+    float ax = fabsf(x);
+    float ay = fabsf(y);
+    if (ax == 0.0f && ay == 0.0f) {
+        return 0.0f;
+    }
+
+    float angle;
+    if (ay <= ax) {
+        angle = atanUnit(ay / ax);
+    } else {
+        angle = HALF_PI_F - atanUnit(ax / ay);
+    }
+
+    if (x < 0.0f) {
+        angle = PI_F - angle;
+    }
+    return (y < 0.0f) ? -angle : angle;
+}
+
+inline float toDegrees(float radians) {
+    return radians * RAD_TO_DEG_F;
+}
+
+inline float toRadians(float degrees) {
+    return degrees * DEG_TO_RAD_F;
+}
+
+} // namespace FastMath
+
+#endif // FAST_MATH_H
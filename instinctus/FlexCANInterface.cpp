@@ -0,0 +1,108 @@
+/**
+ * FlexCANInterface.cpp - CANInterface on FlexCAN_T4 Implementation
+ *
+ * The library's onReceive callback carries no context, so a single static
+ * instance pointer routes it back to the object, the same way the
+ * ICM20948 data-ready ISR does.
+ */
+
+#include "FlexCANInterface.h"
+#include "MemoryPlacement.h"
+
+FlexCANInterface* FlexCANInterface::_instance = nullptr;
+
+FlexCANInterface::FlexCANInterface(uint8_t irqPriority)
+    : _can(), _handler(nullptr), _context(nullptr),
+      _irqPriority(irqPriority), _txDropped(0), _txFrames(0), _txBits(0),
+      _rxFrames(0), _rxBits(0), _txQueueHighWater(0) {
+}
+
+COLD_CODE bool FlexCANInterface::begin(uint32_t bitrate) {
+    if (_instance && _instance != this) {
+        return false;
+    }
+    _instance = this;
+
+    _can.begin();
+    _can.setBaudRate(bitrate);
+    _can.setMaxMB(MAILBOXES);
+    _can.enableFIFO();
+    _can.enableFIFOInterrupt();
+    _can.onReceive(onReceive);
+    _can.enableMBInterrupts();
+    NVIC_SET_PRIORITY(IRQ_CAN3, _irqPriority);
+    return true;
+}
+
+HOT_CODE bool FlexCANInterface::write(const CANFrame& frame) {
+    CAN_message_t message;
+    message.id = frame.id;
+    message.flags.extended = frame.extended;
+    message.len = frame.len;
+    memcpy(message.buf, frame.data, frame.len);
+
+    // Setpoints come from the balance ISR, commands from loop(); the
+    // library's TX ring is not reentrant, so the write is a short critical
+    // section (a mailbox or ring slot store, no waiting)
+    __disable_irq();
+    bool queued = _can.write(message) > 0;
+    if (queued) {
+        _txFrames++;
+        _txBits += canFrameBits(frame.len, frame.extended);
+        uint8_t depth = (uint8_t)_can.getTXQueueCount();
+        if (depth > _txQueueHighWater) {
+            _txQueueHighWater = depth;
+        }
+    } else {
+        _txDropped++;
+    }
+    __enable_irq();
+    return queued;
+}
+
+void FlexCANInterface::setReceiveHandler(ReceiveHandler handler, void* context) {
+    _context = context;
+    _handler = handler;
+}
+
+void FlexCANInterface::getStats(CANBusStats& stats) {
+    stats.rxFrames = _rxFrames;
+    stats.txFrames = _txFrames;
+    stats.txDropped = _txDropped;
+    stats.rxBits = _rxBits;
+    stats.txBits = _txBits;
+
+    uint32_t ecr = FLEXCANb_ECR(CAN3);
+    stats.txErrorCounter = (uint8_t)(ecr & 0xFF);
+    stats.rxErrorCounter = (uint8_t)((ecr >> 8) & 0xFF);
+
+    uint32_t faultConfinement = (FLEXCANb_ESR1(CAN3) >> 4) & 0x3;
+    stats.errorState = (faultConfinement == 0) ? CAN_ERROR_ACTIVE
+                     : (faultConfinement == 1) ? CAN_ERROR_PASSIVE
+                     : CAN_BUS_OFF;
+
+    stats.txQueueDepth = (uint8_t)_can.getTXQueueCount();
+    stats.txQueueHighWater = _txQueueHighWater;
+}
+
+HOT_CODE void FlexCANInterface::onReceive(const CAN_message_t& message) {
+    FlexCANInterface* self = _instance;
+    if (!self || !self->_handler) {
+        return;
+    }
+
+    CANFrame frame;
+    frame.id = message.id;
+    frame.len = (message.len <= 8) ? message.len : 8;
+    frame.extended = message.flags.extended;
+    memcpy(frame.data, message.buf, frame.len);
+    frame.timestampUs = micros();
+
+    self->_rxFrames = self->_rxFrames + 1;
+    self->_rxBits = self->_rxBits + canFrameBits(frame.len, frame.extended);
+    self->_handler(self->_context, frame);
+}
+
+uint32_t FlexCANInterface::getTxDroppedCount() const {
+    return _txDropped;
+}
@@ -0,0 +1,68 @@
+#ifndef FLEXCAN_INTERFACE_H
+#define FLEXCAN_INTERFACE_H
+
+#include <FlexCAN_T4.h>
+#include "CANInterface.h"
+
+/**
+ * FlexCANInterface.h - CANInterface on the i.MX RT1062 FlexCAN (FlexCAN_T4)
+ *
+ * Hardware Details:
+ * - Controller: CAN3 (TX pin 31, RX pin 30), classic CAN frames. CAN1's
+ *   RX pin 23 is the front ToF XSHUT and CAN2 would take Serial1's pins.
+ * - Transceiver on the board; ODrive S1s on the same bus
+ *
+ * Interrupt-Driven Mailboxes:
+ * - RX goes through the hardware FIFO with its interrupt enabled. The
+ *   sketch never calls FlexCAN_T4::events(), so the library calls the
+ *   receive callback straight from the CAN ISR, with no loop() polling.
+ * - TX: write() loads a free TX mailbox immediately, otherwise the frame
+ *   goes into FlexCAN_T4's TX ring, which the mailbox interrupt drains.
+ *   Nothing ever waits for a transmission to finish.
+ *
+ * Bus accounting:
+ * - RX counters are bumped in the ISR, TX counters in write(); both are
+ *   single 32-bit stores, so getStats() needs no lock.
+ * - TEC/REC come from the ECR register and the error state from ESR1
+ *   FLTCONF. The controller recovers from bus-off by itself.
+ *
+ * Only one instance can exist (the library callback has no context).
+ */
+class FlexCANInterface : public CANInterface {
+public:
+    static constexpr uint8_t MAILBOXES = 16;
+
+private:
+    FlexCAN_T4<CAN3, RX_SIZE_256, TX_SIZE_32> _can;
+    ReceiveHandler _handler;
+    void* _context;
+    uint8_t _irqPriority;
+    uint32_t _txDropped;
+    uint32_t _txFrames;
+    uint32_t _txBits;
+    volatile uint32_t _rxFrames;
+    volatile uint32_t _rxBits;
+    uint8_t _txQueueHighWater;
+
+    static FlexCANInterface* _instance;
+    static void onReceive(const CAN_message_t& message);
+
+public:
+    /**
+     * Constructor
+     * @param irqPriority - NVIC priority for the CAN interrupt
+     */
+    explicit FlexCANInterface(uint8_t irqPriority);
+
+    bool begin(uint32_t bitrate) override;
+    bool write(const CANFrame& frame) override;
+    void setReceiveHandler(ReceiveHandler handler, void* context) override;
+    void getStats(CANBusStats& stats) override;
+
+    /**
+     * Frames refused by write() because mailboxes and queue were full
+     */
+    uint32_t getTxDroppedCount() const;
+};
+
+#endif // FLEXCAN_INTERFACE_H
@@ -0,0 +1,159 @@
+/**
+ * HealthMonitor.cpp - Loop Health, Watchdog Feeding and Safe-State Escalation Implementation
+ *
+ * Missed balance ticks are found by comparing the runs the scheduler
+ * counted with the runs the elapsed time calls for; one tick of slack
+ * absorbs the phase between the PIT and this window.
+ */
+
+#include "HealthMonitor.h"
+#include "TelemetryWriter.h"
+#include "RtWatchdog.h"
+#include "MemoryPlacement.h"
+#include <BalanceConfig.h>
+#include <BoardConfig.h>
+
+using namespace Telemetry;
+
+HealthMonitor::HealthMonitor(RtWatchdog* watchdog)
+    : _watchdog(watchdog), _started(false), _level(LEVEL_OK), _faults(0), _safeStateFaults(0),
+      _faultyWindows(0), _runFaults(0), _watchdogReset(false), _last(), _lastUpdateUs(0),
+      _lastImuStaleTicks(0), _imuStaleTicks(0),
+      _windows(0), _degradedWindows(0), _deadlineMisses(0), _tofStaleWindows(0),
+      _i2cTimeouts(0), _canTxFailures(0), _feedsWithheld(0) {
+}
+
+HOT_CODE void HealthMonitor::balanceTick(uint32_t imuSampleUs) {
+    if ((uint32_t)(micros() - imuSampleUs) > Config::HEALTH_IMU_STALE_US) {
+        _imuStaleTicks = _imuStaleTicks + 1;
+    }
+}
+
+COLD_CODE void HealthMonitor::start(const Inputs& inputs) {
+    _last = inputs;
+    _lastUpdateUs = micros();
+    _lastImuStaleTicks = _imuStaleTicks;
+    _watchdogReset = RtWatchdog::causedLastReset();
+    _started = true;
+    if (_watchdog) {
+        _watchdog->feed();
+    }
+}
+
+bool HealthMonitor::update(const Inputs& inputs) {
+    if (!_started) {
+        return false;
+    }
+    uint32_t now = micros();
+    uint32_t elapsedUs = now - _lastUpdateUs;
+    _lastUpdateUs = now;
+    uint8_t faults = 0;
+
+    uint32_t runs = inputs.balanceRuns - _last.balanceRuns;
+    uint32_t expected = (uint32_t)((uint64_t)elapsedUs * Config::BALANCE_LOOP_HZ / 1000000);
+    uint32_t skipped = (expected > runs + 1) ? expected - runs - 1 : 0;
+    uint32_t misses = (inputs.balanceOverruns - _last.balanceOverruns) + skipped;
+    if (misses > 0) {
+        _deadlineMisses += misses;
+        faults |= FAULT_DEADLINE;
+    }
+
+    uint32_t imuStaleTicks = _imuStaleTicks;
+    if (imuStaleTicks != _lastImuStaleTicks) {
+        _lastImuStaleTicks = imuStaleTicks;
+        faults |= FAULT_IMU_STALE;
+    }
+
+    for (uint8_t i = 0; i < TOF_SENSORS; i++) {
+        uint32_t measuredUs = inputs.tofMeasurementUs[i];
+        if (measuredUs != 0 && now - measuredUs > Config::HEALTH_TOF_STALE_MS * 1000UL) {
+            faults |= FAULT_TOF_STALE;
+        }
+    }
+    if (faults & FAULT_TOF_STALE) {
+        _tofStaleWindows++;
+    }
+
+    uint32_t i2cTimeouts = inputs.i2cTimeouts - _last.i2cTimeouts;
+    if (i2cTimeouts > 0) {
+        _i2cTimeouts += i2cTimeouts;
+        faults |= FAULT_I2C_TIMEOUT;
+    }
+
+    uint32_t canTxFailures = inputs.canTxFailures - _last.canTxFailures;
+    if (canTxFailures > 0) {
+        _canTxFailures += canTxFailures;
+        faults |= FAULT_CAN_TX;
+    }
+    _last = inputs;
+
+    // The watchdog vouches for the balance task only
+    if (_watchdog) {
+        if (runs > 0 && misses <= Config::HEALTH_DEADLINE_MISS_LIMIT) {
+            _watchdog->feed();
+        } else {
+            _feedsWithheld++;
+        }
+    }
+
+    _windows++;
+    _faults = faults;
+    if (faults) {
+        _degradedWindows++;
+        _runFaults |= faults;
+        if (_faultyWindows < UINT8_MAX) {
+            _faultyWindows++;
+        }
+    } else {
+        _runFaults = 0;
+        _faultyWindows = 0;
+    }
+
+    Level previous = _level;
+    if (_level != LEVEL_SAFE_STATE) {
+        if (_faultyWindows >= Config::HEALTH_SAFE_STATE_WINDOWS) {
+            _level = LEVEL_SAFE_STATE;
+            _safeStateFaults = _runFaults;
+        } else {
+            _level = faults ? LEVEL_DEGRADED : LEVEL_OK;
+        }
+    }
+    return _level != previous;
+}
+
+bool HealthMonitor::clearSafeState() {
+    if (_level != LEVEL_SAFE_STATE) {
+        return true;
+    }
+    if (_faults) {
+        return false;
+    }
+    _level = LEVEL_OK;
+    _safeStateFaults = 0;
+    return true;
+}
+
+HealthMonitor::Level HealthMonitor::getLevel() const {
+    return _level;
+}
+
+bool HealthMonitor::isSafeState() const {
+    return _level == LEVEL_SAFE_STATE;
+}
+
+void HealthMonitor::report(TelemetryWriter& telemetry) const {
+    HealthPayload* p = telemetry.begin<HealthPayload>(FRAME_HEALTH, micros());
+    p->level = _level;
+    p->faults = _faults;
+    p->safeStateFaults = _safeStateFaults;
+    p->watchdogReset = _watchdogReset ? 1 : 0;
+    p->windows = _windows;
+    p->degradedWindows = _degradedWindows;
+    p->deadlineMisses = _deadlineMisses;
+    p->imuStaleTicks = _imuStaleTicks;
+    p->tofStaleWindows = _tofStaleWindows;
+    p->i2cTimeouts = _i2cTimeouts;
+    p->canTxFailures = _canTxFailures;
+    p->feedsWithheld = _feedsWithheld;
+    telemetry.commit();
+}
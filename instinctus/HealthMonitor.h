@@ -0,0 +1,139 @@
+#ifndef HEALTH_MONITOR_H
+#define HEALTH_MONITOR_H
+
+#include <Arduino.h>
+#include "TelemetryFrame.h"
+
+class TelemetryWriter;
+class RtWatchdog;
+
+/**
+ * HealthMonitor.h - Loop Health, Watchdog Feeding and Safe-State Escalation
+ *
+ * Judges the robot's real-time health once per window (update() from a
+ * loop slot) and turns it into three reactions:
+ * - Report: FRAME_HEALTH on every level change, so a problem shows up on
+ *   the Jetson the moment it starts, not only as a black-box entry.
+ * - Feed: the hardware watchdog is fed after a window only if the balance
+ *   task ran and kept its deadline misses within HEALTH_DEADLINE_MISS_LIMIT.
+ *   A balance ISR that has stopped, or a loop() that has hung, is reset
+ *   by the hardware.
+ * - Escalate: HEALTH_SAFE_STATE_WINDOWS faulty windows in a row latch the
+ *   safe state: the sketch stops driving (velocity target 0, velocity
+ *   commands refused) while balance continues. clearSafeState() releases
+ *   it once a window is clean again.
+ *
+ * Faults, per window:
+ * - FAULT_DEADLINE: balance executions longer than a period, plus ticks
+ *   that should have run in the window and didn't
+ * - FAULT_IMU_STALE: balance ticks whose newest IMU sample was older than
+ *   HEALTH_IMU_STALE_US (counted in the ISR by balanceTick())
+ * - FAULT_TOF_STALE: a ToF sensor that has ranged before has not for
+ *   HEALTH_TOF_STALE_MS (sensors that never came up are not judged)
+ * - FAULT_I2C_TIMEOUT: async I2C transfers aborted for hanging
+ * - FAULT_CAN_TX: motor setpoints the CAN driver refused
+ *
+ * Counters live in ordinary globals, i.e. DTCM (MemoryPlacement.h): no
+ * cache, no wait states for the ISR-side increment. The ISR side is
+ * balanceTick() only; everything else is loop context.
+ *
+ * Usage:
+ *   HealthMonitor health(&watchdog);
+ *   health.balanceTick(balanceIMU.getLastSampleTimeUs());   // balance ISR
+ *   health.start(inputs);                  // once the boot sequence is done
+ *   if (health.update(inputs)) { ... }     // loop slot, every HEALTH_WINDOW_MS
+ *   health.report(telemetry);
+ */
+class HealthMonitor {
+public:
+    enum Level : uint8_t {
+        LEVEL_OK,
+        LEVEL_DEGRADED,            // faults in the last window
+        LEVEL_SAFE_STATE           // latched until clearSafeState()
+    };
+
+    enum Fault : uint8_t {
+        FAULT_DEADLINE    = 0x01,
+        FAULT_IMU_STALE   = 0x02,
+        FAULT_TOF_STALE   = 0x04,
+        FAULT_I2C_TIMEOUT = 0x08,
+        FAULT_CAN_TX      = 0x10
+    };
+
+    static constexpr uint8_t TOF_SENSORS = 2;   // indexed by Telemetry::SensorId
+
+    /**
+     * Cumulative counters from the rest of the system, read by the sketch
+     */
+    struct Inputs {
+        uint32_t balanceRuns;          // TaskScheduler balance stats
+        uint32_t balanceOverruns;
+        uint32_t i2cTimeouts;          // AsyncI2C::getTimeoutCount
+        uint32_t canTxFailures;        // both ODriveAxis::getTxFailureCount
+        uint32_t tofMeasurementUs[TOF_SENSORS];   // ToFSensor::getLastMeasurementUs
+    };
+
+private:
+    RtWatchdog* _watchdog;
+    bool _started;
+    Level _level;
+    uint8_t _faults;
+    uint8_t _safeStateFaults;
+    uint8_t _faultyWindows;        // in a row
+    uint8_t _runFaults;            // seen over those windows
+    bool _watchdogReset;
+
+    Inputs _last;
+    uint32_t _lastUpdateUs;
+    uint32_t _lastImuStaleTicks;
+
+    volatile uint32_t _imuStaleTicks;   // balance ISR
+
+    uint32_t _windows;
+    uint32_t _degradedWindows;
+    uint32_t _deadlineMisses;
+    uint32_t _tofStaleWindows;
+    uint32_t _i2cTimeouts;
+    uint32_t _canTxFailures;
+    uint32_t _feedsWithheld;
+
+public:
+    /**
+     * Constructor
+     * @param watchdog - fed after every healthy window, or nullptr for none
+     */
+    explicit HealthMonitor(RtWatchdog* watchdog);
+
+    /**
+     * Once per balance tick, after the controller. Balance ISR.
+     * @param imuSampleUs - acquisition time of the newest IMU sample
+     */
+    void balanceTick(uint32_t imuSampleUs);
+
+    /**
+     * Take the baselines and start judging (and feeding the watchdog)
+     */
+    void start(const Inputs& inputs);
+
+    /**
+     * Judge the window since the last call. Loop context.
+     * @return true if the level changed
+     */
+    bool update(const Inputs& inputs);
+
+    /**
+     * Leave the safe state
+     * @return false if the last window was still faulty
+     */
+    bool clearSafeState();
+
+    Level getLevel() const;
+    bool isSafeState() const;
+
+    /**
+     * Send FRAME_HEALTH
+     */
+    void report(TelemetryWriter& telemetry) const;
+};
+
+#endif // HEALTH_MONITOR_H
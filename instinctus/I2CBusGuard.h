@@ -0,0 +1,56 @@
+#ifndef I2C_BUS_GUARD_H
+#define I2C_BUS_GUARD_H
+
+#include <Arduino.h>
+
+/**
+ * I2CBusGuard.h - Ownership Flag for an I2C Bus Shared Across Priorities
+ *
+ * The balance task runs in a timer ISR and can preempt loop() in the
+ * middle of a Wire transaction. Two masters talking over each other on the
+ * same bus corrupts both transfers, so each user claims the bus first.
+ *
+ * Rules:
+ * - Every user calls tryAcquire() before touching the bus and release()
+ *   when done. On failure, skip the transfer and retry later; never spin,
+ *   since the holder may be unable to run until the caller returns.
+ * - Asynchronous transfers (AsyncI2C) hold the bus from start until their
+ *   completion callback, so loop-context users can also find it busy.
+ */
+class I2CBusGuard {
+private:
+    volatile bool _busy;
+    volatile uint32_t _contentions;
+
+public:
+    I2CBusGuard() : _busy(false), _contentions(0) {}
+
+    /**
+     * Claim the bus without waiting
+     * @return true if the caller now owns the bus
+     */
+    bool tryAcquire() {
+        __disable_irq();
+        bool acquired = !_busy;
+        if (acquired) {
+            _busy = true;
+        } else {
+            _contentions = _contentions + 1;
+        }
+        __enable_irq();
+        return acquired;
+    }
+
+    void release() {
+        _busy = false;
+    }
+
+    /**
+     * Number of tryAcquire() calls that found the bus already taken
+     */
+    uint32_t getContentionCount() const {
+        return _contentions;
+    }
+};
+
+#endif // I2C_BUS_GUARD_H
@@ -0,0 +1,499 @@
+/**
+ * ICM20948AsyncInterface.cpp - Interrupt-Driven ICM20948 Implementation
+ *
+ * Data-ready sample path (no blocking anywhere):
+ *   INT1 rising edge -> dataReadyIsr() -> AsyncI2C burst read (12 bytes)
+ *   -> sampleReadComplete() -> publishBatch(1) -> readSensors()
+ *
+ * FIFO drain path, started from readBatch() in the balance task:
+ *   FIFO_COUNTH/L read -> fifoCountComplete() -> FIFO_R_W burst read of
+ *   N whole gyro records -> fifoDataComplete() -> ACCEL_XOUT read
+ *   -> fifoAccelComplete() -> publishBatch(N)
+ *   A misaligned or near-full count triggers an async FIFO reset instead.
+ *
+ * Register Map (bank 0 unless noted):
+ * - 0x00 WHO_AM_I (0xEA), 0x03 USER_CTRL, 0x06/0x07 PWR_MGMT_1/2
+ * - 0x0F INT_PIN_CFG, 0x11 INT_ENABLE_1, 0x2D..0x38 ACCEL/GYRO_OUT
+ * - 0x67 FIFO_EN_2, 0x68 FIFO_RST, 0x69 FIFO_MODE, 0x70/0x71 FIFO_COUNTH/L,
+ *   0x72 FIFO_R_W
+ * - bank 2: 0x00 GYRO_SMPLRT_DIV, 0x01 GYRO_CONFIG_1, 0x09 ODR_ALIGN_EN,
+ *   0x10/0x11 ACCEL_SMPLRT_DIV_1/2, 0x14 ACCEL_CONFIG
+ * - 0x7F REG_BANK_SEL (any bank)
+ *
+ * Error Handling:
+ * - initialize() returns false on a bus error or wrong WHO_AM_I
+ * - A failed burst read is counted and dropped; the next edge/tick retries
+ */
+
+#include "ICM20948AsyncInterface.h"
+#include "MemoryPlacement.h"
+#include <IMUConfig.h>
+#include <BalanceConfig.h>
+
+namespace {
+    constexpr uint8_t REG_WHO_AM_I       = 0x00;
+    constexpr uint8_t REG_USER_CTRL      = 0x03;
+    constexpr uint8_t REG_PWR_MGMT_1     = 0x06;
+    constexpr uint8_t REG_PWR_MGMT_2     = 0x07;
+    constexpr uint8_t REG_INT_PIN_CFG    = 0x0F;
+    constexpr uint8_t REG_INT_ENABLE_1   = 0x11;
+    constexpr uint8_t REG_ACCEL_XOUT_H   = 0x2D;
+    constexpr uint8_t REG_FIFO_EN_2      = 0x67;
+    constexpr uint8_t REG_FIFO_RST       = 0x68;
+    constexpr uint8_t REG_FIFO_MODE      = 0x69;
+    constexpr uint8_t REG_FIFO_COUNTH    = 0x70;
+    constexpr uint8_t REG_FIFO_R_W       = 0x72;
+    constexpr uint8_t REG_BANK_SEL       = 0x7F;
+
+    constexpr uint8_t REG2_GYRO_SMPLRT_DIV    = 0x00;
+    constexpr uint8_t REG2_GYRO_CONFIG_1      = 0x01;
+    constexpr uint8_t REG2_ODR_ALIGN_EN       = 0x09;
+    constexpr uint8_t REG2_ACCEL_SMPLRT_DIV_1 = 0x10;
+    constexpr uint8_t REG2_ACCEL_SMPLRT_DIV_2 = 0x11;
+    constexpr uint8_t REG2_ACCEL_CONFIG       = 0x14;
+
+    constexpr uint8_t WHO_AM_I_VALUE     = 0xEA;
+    constexpr uint8_t PWR_RESET          = 0x80;
+    constexpr uint8_t PWR_CLKSEL_AUTO    = 0x01;
+    constexpr uint8_t INT_RAW_DATA_RDY   = 0x01;
+    constexpr uint8_t CONFIG_FCHOICE     = 0x01;  // enable DLPF so the rate divider applies
+    constexpr uint8_t USER_CTRL_FIFO_EN  = 0x40;
+    constexpr uint8_t FIFO_EN_GYRO       = 0x0E;  // GYRO_X/Y/Z
+    constexpr uint8_t FIFO_RST_ALL       = 0x1F;
+    constexpr uint16_t FIFO_SIZE         = 512;
+
+    constexpr float STANDARD_GRAVITY = 9.80665f;
+
+    // FS_SEL field and sensitivity for each supported range
+    uint8_t accelFsSel(uint8_t g, float& lsbPerG) {
+        switch (g) {
+            case 2:  lsbPerG = 16384.0f; return 0;
+            case 8:  lsbPerG = 4096.0f;  return 2;
+            case 16: lsbPerG = 2048.0f;  return 3;
+            case 4:
+            default: lsbPerG = 8192.0f;  return 1;
+        }
+    }
+
+    uint8_t gyroFsSel(uint16_t dps, float& lsbPerDps) {
+        switch (dps) {
+            case 250:  lsbPerDps = 131.0f; return 0;
+            case 1000: lsbPerDps = 32.8f;  return 2;
+            case 2000: lsbPerDps = 16.4f;  return 3;
+            case 500:
+            default:   lsbPerDps = 65.5f;  return 1;
+        }
+    }
+
+    inline int16_t be16(const uint8_t* p) {
+        return (int16_t)((p[0] << 8) | p[1]);
+    }
+
+    // The per-drain accel read interpolates between two real samples only
+    // if the accelerometer produces at least one per balance tick
+    static_assert(!Config::IMU_FIFO_ENABLED || Config::IMU_ACCEL_ODR_HZ >= Config::BALANCE_LOOP_HZ,
+                  "FIFO mode needs an accel ODR of at least the balance loop rate");
+}
+
+ICM20948AsyncInterface* ICM20948AsyncInterface::_instance = nullptr;
+
+ICM20948AsyncInterface::ICM20948AsyncInterface(AsyncI2C* bus, I2CBusGuard* guard,
+                                               uint8_t address, int intPin)
+    : _bus(bus), _guard(guard), _i2cAddress(address), _intPin(intPin),
+      _accelScale(0), _gyroScale(0), _samplePeriod(0),
+      _rawBuffer(), _countBuffer(), _accelBuffer(), _txBuffer(), _drainRecords(0),
+      _drainAvailable(0), _drainTimeUs(0), _edgeTimeUs(0), _lastTimestampUs(0),
+      _samplePeriodUs(0), _lastAccel(), _accelPrimed(false), _fifoStage(FIFO_IDLE),
+      _batches(), _batchSizes(), _published(0),
+      _batchCount(0), _lastReadCount(0),
+      _readPending(false), _deferredReads(0), _failedReads(0), _fifoResets(0),
+      _resetIssued(false), _resetUs(0) {
+}
+
+bool ICM20948AsyncInterface::writeRegister(uint8_t reg, uint8_t value) {
+    uint8_t tx[2] = {reg, value};
+    return _bus->transferBlocking(_i2cAddress, tx, 2, nullptr, 0);
+}
+
+bool ICM20948AsyncInterface::readRegister(uint8_t reg, uint8_t& value) {
+    return _bus->transferBlocking(_i2cAddress, &reg, 1, &value, 1);
+}
+
+bool ICM20948AsyncInterface::selectBank(uint8_t bank) {
+    return writeRegister(REG_BANK_SEL, (uint8_t)(bank << 4));
+}
+
+bool ICM20948AsyncInterface::resetFifo() {
+    return writeRegister(REG_FIFO_RST, FIFO_RST_ALL) &&
+           writeRegister(REG_FIFO_RST, 0x00);
+}
+
+COLD_CODE bool ICM20948AsyncInterface::reset() {
+    if (!_bus || !_guard || !_guard->tryAcquire()) {
+        return false;
+    }
+    bool ok = selectBank(0) && writeRegister(REG_PWR_MGMT_1, PWR_RESET);
+    _guard->release();
+    _resetIssued = ok;
+    _resetUs = micros();
+    return ok;
+}
+
+COLD_CODE bool ICM20948AsyncInterface::initialize() {
+    if (!_bus || !_guard) {
+        return false;
+    }
+    if (!_resetIssued && !reset()) {
+        return false;
+    }
+    // Setup only: whatever is left of the device reset time
+    uint32_t sinceReset = micros() - _resetUs;
+    if (sinceReset < Config::IMU_RESET_TIME_US) {
+        delayMicroseconds(Config::IMU_RESET_TIME_US - sinceReset);
+    }
+    _resetIssued = false;
+    if (!_guard->tryAcquire()) {
+        return false;
+    }
+
+    float lsbPerG, lsbPerDps;
+    uint8_t accelFs = accelFsSel(Config::IMU_ACCEL_RANGE_G, lsbPerG);
+    uint8_t gyroFs = gyroFsSel(Config::IMU_GYRO_RANGE_DPS, lsbPerDps);
+    _accelScale = STANDARD_GRAVITY / lsbPerG;
+    _gyroScale = (PI / 180.0f) / lsbPerDps;
+    _samplePeriod = 1.0f / Config::IMU_GYRO_ODR_HZ;
+    _samplePeriodUs = (uint32_t)(_samplePeriod * 1e6f + 0.5f);
+    _accelPrimed = false;
+
+    uint8_t whoAmI = 0;
+    bool ok = writeRegister(REG_PWR_MGMT_1, PWR_CLKSEL_AUTO)
+            && readRegister(REG_WHO_AM_I, whoAmI)
+            && whoAmI == WHO_AM_I_VALUE
+            && writeRegister(REG_PWR_MGMT_2, 0x00)     // accel + gyro on
+            && writeRegister(REG_USER_CTRL, 0x00);     // aux I2C master off
+
+    ok = ok && selectBank(2)
+            && writeRegister(REG2_GYRO_SMPLRT_DIV, Config::IMU_GYRO_RATE_DIVISOR)
+            && writeRegister(REG2_GYRO_CONFIG_1, (uint8_t)((gyroFs << 1) | CONFIG_FCHOICE))
+            && writeRegister(REG2_ACCEL_SMPLRT_DIV_1, (uint8_t)((Config::IMU_ACCEL_RATE_DIVISOR >> 8) & 0x0F))
+            && writeRegister(REG2_ACCEL_SMPLRT_DIV_2, (uint8_t)(Config::IMU_ACCEL_RATE_DIVISOR & 0xFF))
+            && writeRegister(REG2_ACCEL_CONFIG, (uint8_t)((accelFs << 1) | CONFIG_FCHOICE))
+            && writeRegister(REG2_ODR_ALIGN_EN, 0x01)
+            && selectBank(0);
+
+    if (Config::IMU_FIFO_ENABLED) {
+        // Stream mode: gyro records, no interrupt, drained per tick
+        ok = ok && writeRegister(REG_INT_ENABLE_1, 0x00)
+                && writeRegister(REG_FIFO_MODE, 0x00)
+                && writeRegister(REG_FIFO_EN_2, FIFO_EN_GYRO)
+                && resetFifo()
+                && writeRegister(REG_USER_CTRL, USER_CTRL_FIFO_EN);
+    } else {
+        // INT1: active high, push-pull, 50 us pulse; fire on every new sample
+        ok = ok && writeRegister(REG_INT_PIN_CFG, 0x00)
+                && writeRegister(REG_INT_ENABLE_1, INT_RAW_DATA_RDY);
+    }
+
+    _guard->release();
+    if (!ok) {
+        return false;
+    }
+
+    if (!Config::IMU_FIFO_ENABLED) {
+        _instance = this;
+        pinMode(_intPin, INPUT);
+        attachInterrupt(digitalPinToInterrupt(_intPin), dataReadyIsr, RISING);
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Data-ready mode
+// ---------------------------------------------------------------------------
+
+HOT_CODE void ICM20948AsyncInterface::dataReadyIsr() {
+    if (_instance) {
+        _instance->_edgeTimeUs = micros();
+        _instance->startSampleRead();
+    }
+}
+
+HOT_CODE void ICM20948AsyncInterface::startSampleRead() {
+    if (!_guard->tryAcquire()) {
+        _readPending = true;
+        _deferredReads = _deferredReads + 1;
+        return;
+    }
+    static const uint8_t reg = REG_ACCEL_XOUT_H;
+    if (!_bus->startTransfer(_i2cAddress, &reg, 1, _rawBuffer, SAMPLE_SIZE,
+                             sampleReadComplete, this)) {
+        _guard->release();
+        _readPending = true;
+        return;
+    }
+    _readPending = false;
+}
+
+HOT_CODE void ICM20948AsyncInterface::sampleReadComplete(void* context, bool ok) {
+    ICM20948AsyncInterface* self = static_cast<ICM20948AsyncInterface*>(context);
+    self->_guard->release();
+    if (!ok) {
+        self->_failedReads = self->_failedReads + 1;
+        return;
+    }
+    self->publishBatch(1, self->_edgeTimeUs, 0, false);
+}
+
+// ---------------------------------------------------------------------------
+// FIFO mode
+// ---------------------------------------------------------------------------
+
+HOT_CODE void ICM20948AsyncInterface::startFifoDrain() {
+    if (!_guard->tryAcquire()) {
+        _deferredReads = _deferredReads + 1;
+        return;
+    }
+    static const uint8_t reg = REG_FIFO_COUNTH;
+    _fifoStage = FIFO_READ_COUNT;
+    if (!_bus->startTransfer(_i2cAddress, &reg, 1, _countBuffer, 2,
+                             fifoCountComplete, this)) {
+        _fifoStage = FIFO_IDLE;
+        _guard->release();
+    }
+}
+
+HOT_CODE void ICM20948AsyncInterface::fifoCountComplete(void* context, bool ok) {
+    ICM20948AsyncInterface* self = static_cast<ICM20948AsyncInterface*>(context);
+    self->_drainTimeUs = micros();
+    if (!ok) {
+        self->_failedReads = self->_failedReads + 1;
+        self->_fifoStage = FIFO_IDLE;
+        self->_guard->release();
+        return;
+    }
+
+    uint16_t count = (uint16_t)(((self->_countBuffer[0] & 0x1F) << 8) | self->_countBuffer[1]);
+
+    // A partial record or a nearly full FIFO means stream mode may have
+    // overwritten data and the record boundaries can no longer be trusted.
+    if (count % RECORD_SIZE != 0 || count > FIFO_SIZE - RECORD_SIZE) {
+        self->startFifoReset();
+        return;
+    }
+
+    uint16_t available = count / RECORD_SIZE;
+    uint8_t records = (uint8_t)(available > MAX_BATCH ? MAX_BATCH : available);
+    if (records == 0) {
+        self->_fifoStage = FIFO_IDLE;
+        self->_guard->release();
+        return;
+    }
+
+    static const uint8_t reg = REG_FIFO_R_W;
+    self->_fifoStage = FIFO_READ_DATA;
+    self->_drainRecords = records;
+    self->_drainAvailable = available;
+    if (!self->_bus->startTransfer(self->_i2cAddress, &reg, 1, self->_rawBuffer,
+                                   (uint16_t)(records * RECORD_SIZE),
+                                   fifoDataComplete, self)) {
+        self->_fifoStage = FIFO_IDLE;
+        self->_guard->release();
+    }
+}
+
+HOT_CODE void ICM20948AsyncInterface::fifoDataComplete(void* context, bool ok) {
+    ICM20948AsyncInterface* self = static_cast<ICM20948AsyncInterface*>(context);
+    if (!ok) {
+        self->_failedReads = self->_failedReads + 1;
+        self->_fifoStage = FIFO_IDLE;
+        self->_guard->release();
+        return;
+    }
+
+    // Still holding the bus: the accel sample that ends this batch
+    static const uint8_t reg = REG_ACCEL_XOUT_H;
+    self->_fifoStage = FIFO_READ_ACCEL;
+    if (!self->_bus->startTransfer(self->_i2cAddress, &reg, 1, self->_accelBuffer, ACCEL_SIZE,
+                                   fifoAccelComplete, self)) {
+        fifoAccelComplete(self, false);
+    }
+}
+
+HOT_CODE void ICM20948AsyncInterface::fifoAccelComplete(void* context, bool ok) {
+    ICM20948AsyncInterface* self = static_cast<ICM20948AsyncInterface*>(context);
+    self->_fifoStage = FIFO_IDLE;
+    self->_guard->release();
+    if (!ok) {
+        self->_failedReads = self->_failedReads + 1;   // gyro still published, accel held
+    }
+    self->publishBatch(self->_drainRecords, self->_drainTimeUs,
+                       (uint16_t)(self->_drainAvailable - self->_drainRecords), ok);
+}
+
+HOT_CODE void ICM20948AsyncInterface::startFifoReset() {
+    _fifoStage = FIFO_RESET_ASSERT;
+    _txBuffer[0] = REG_FIFO_RST;
+    _txBuffer[1] = FIFO_RST_ALL;
+    if (!_bus->startTransfer(_i2cAddress, _txBuffer, 2, nullptr, 0,
+                             fifoResetComplete, this)) {
+        _fifoStage = FIFO_IDLE;
+        _guard->release();
+    }
+}
+
+HOT_CODE void ICM20948AsyncInterface::fifoResetComplete(void* context, bool ok) {
+    ICM20948AsyncInterface* self = static_cast<ICM20948AsyncInterface*>(context);
+    if (ok && self->_fifoStage == FIFO_RESET_ASSERT) {
+        self->_fifoStage = FIFO_RESET_RELEASE;
+        self->_txBuffer[1] = 0x00;
+        if (self->_bus->startTransfer(self->_i2cAddress, self->_txBuffer, 2, nullptr, 0,
+                                      fifoResetComplete, self)) {
+            return;
+        }
+        ok = false;
+    }
+    if (ok) {
+        self->_fifoResets = self->_fifoResets + 1;
+    } else {
+        self->_failedReads = self->_failedReads + 1;
+    }
+    self->_fifoStage = FIFO_IDLE;
+    self->_guard->release();
+}
+
+// ---------------------------------------------------------------------------
+// Sample publication
+// ---------------------------------------------------------------------------
+
+// Raw sensor axes into robot frame (X=forward, Y=left, Z=up)
+HOT_CODE void ICM20948AsyncInterface::decodeAccel(const uint8_t* raw, float& x, float& y, float& z) const {
+    float ax = be16(&raw[0]) * _accelScale;
+    float ay = be16(&raw[2]) * _accelScale;
+    float az = be16(&raw[4]) * _accelScale;
+    applyTransform<Config::BALANCE_IMU_TRANSFORM>(ax, ay, az, x, y, z);
+}
+
+HOT_CODE void ICM20948AsyncInterface::decodeGyro(const uint8_t* raw, IMUSample& sample) const {
+    float gx = be16(&raw[0]) * _gyroScale;
+    float gy = be16(&raw[2]) * _gyroScale;
+    float gz = be16(&raw[4]) * _gyroScale;
+    applyTransform<Config::BALANCE_IMU_TRANSFORM>(gx, gy, gz,
+                                                  sample.gyroX, sample.gyroY, sample.gyroZ);
+}
+
+HOT_CODE void ICM20948AsyncInterface::decodeRecord(const uint8_t* raw, IMUSample& sample) const {
+    decodeAccel(raw, sample.accelX, sample.accelY, sample.accelZ);
+    decodeGyro(raw + ACCEL_SIZE, sample);
+}
+
+// newestUs is the time of the newest record still in the FIFO when it was
+// counted; newerInFifo is how many records after this batch remain unread.
+// accelFresh: _accelBuffer holds the accel sample read after this batch.
+HOT_CODE void ICM20948AsyncInterface::publishBatch(uint8_t count, uint32_t newestUs, uint16_t newerInFifo,
+                                                   bool accelFresh) {
+    uint8_t next = _published ^ 1;
+
+    // FIFO mode: accel from the previous batch's end to this one's
+    float accel[3] = { _lastAccel[0], _lastAccel[1], _lastAccel[2] };
+    if (Config::IMU_FIFO_ENABLED && accelFresh) {
+        decodeAccel(_accelBuffer, accel[0], accel[1], accel[2]);
+        if (!_accelPrimed) {
+            _lastAccel[0] = accel[0];
+            _lastAccel[1] = accel[1];
+            _lastAccel[2] = accel[2];
+            _accelPrimed = true;
+        }
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        IMUSample& sample = _batches[next][i];
+        if (Config::IMU_FIFO_ENABLED) {
+            decodeGyro(&_rawBuffer[i * RECORD_SIZE], sample);
+            float f = (float)(i + 1) / count;
+            sample.accelX = _lastAccel[0] + (accel[0] - _lastAccel[0]) * f;
+            sample.accelY = _lastAccel[1] + (accel[1] - _lastAccel[1]) * f;
+            sample.accelZ = _lastAccel[2] + (accel[2] - _lastAccel[2]) * f;
+        } else {
+            decodeRecord(_rawBuffer, sample);
+        }
+
+        uint32_t stepsBack = (uint32_t)(count - 1 - i) + newerInFifo;
+        uint32_t timestamp = newestUs - stepsBack * _samplePeriodUs;
+
+        // Unread records from the previous drain were anchored to an older
+        // count; never let the reconstructed grid run backwards
+        if ((int32_t)(timestamp - _lastTimestampUs) <= 0 && _lastTimestampUs != 0) {
+            timestamp = _lastTimestampUs + _samplePeriodUs;
+        }
+        sample.timestampUs = timestamp;
+        _lastTimestampUs = timestamp;
+    }
+    _batchSizes[next] = count;
+    _lastAccel[0] = accel[0];
+    _lastAccel[1] = accel[1];
+    _lastAccel[2] = accel[2];
+
+    _published = next;
+    _batchCount = _batchCount + 1;
+}
+
+HOT_CODE uint8_t ICM20948AsyncInterface::takeBatch(IMUSample* samples, uint8_t maxSamples) {
+    uint32_t count = _batchCount;
+    if (count == _lastReadCount) {
+        return 0;
+    }
+    _lastReadCount = count;
+
+    // Keep the newest records if the caller has less room than the batch
+    uint8_t published = _published;
+    uint8_t size = _batchSizes[published];
+    uint8_t first = (size > maxSamples) ? size - maxSamples : 0;
+    for (uint8_t i = first; i < size; i++) {
+        samples[i - first] = _batches[published][i];
+    }
+    return size - first;
+}
+
+bool ICM20948AsyncInterface::readSensors(float& accelX, float& accelY, float& accelZ,
+                                        float& gyroX, float& gyroY, float& gyroZ) {
+    IMUSample latest;
+    if (readBatch(&latest, 1) == 0) {
+        return false;
+    }
+    accelX = latest.accelX;
+    accelY = latest.accelY;
+    accelZ = latest.accelZ;
+    gyroX = latest.gyroX;
+    gyroY = latest.gyroY;
+    gyroZ = latest.gyroZ;
+    return true;
+}
+
+HOT_CODE uint8_t ICM20948AsyncInterface::readBatch(IMUSample* samples, uint8_t maxSamples) {
+    uint8_t count = takeBatch(samples, maxSamples);
+
+    if (Config::IMU_FIFO_ENABLED) {
+        if (_fifoStage == FIFO_IDLE) {
+            startFifoDrain();
+        }
+    } else if (_readPending) {
+        startSampleRead();
+    }
+    return count;
+}
+
+float ICM20948AsyncInterface::getSamplePeriod() const {
+    return _samplePeriod;
+}
+
+uint32_t ICM20948AsyncInterface::getDeferredReadCount() const {
+    return _deferredReads;
+}
+
+uint32_t ICM20948AsyncInterface::getFailedReadCount() const {
+    return _failedReads;
+}
+
+uint32_t ICM20948AsyncInterface::getFifoResetCount() const {
+    return _fifoResets;
+}
@@ -0,0 +1,201 @@
+#ifndef ICM20948_ASYNC_INTERFACE_H
+#define ICM20948_ASYNC_INTERFACE_H
+
+#include <Arduino.h>
+#include <IMUConfig.h>
+#include "IMUInterface.h"
+#include "AsyncI2C.h"
+#include "I2CBusGuard.h"
+
+/**
+ * ICM20948AsyncInterface.h - Interrupt-Driven ICM20948 Implementation
+ *
+ * Alternative to ICM20948Interface that never blocks the caller. Two modes,
+ * selected by Config::IMU_FIFO_ENABLED:
+ *
+ * Data-ready mode:
+ *   The raw-data-ready interrupt (INT1) starts a single 12-byte burst read
+ *   of ACCEL_XOUT_H..GYRO_ZOUT_L through AsyncI2C; the completion ISR
+ *   converts and publishes the sample. readSensors() hands back the latest.
+ *
+ * FIFO mode:
+ *   Gyro records stream into the 512-byte on-chip FIFO at the gyro ODR.
+ *   Each readBatch() call returns the batch drained by the previous call
+ *   and kicks off the next drain: an async FIFO_COUNT read chained to a
+ *   single burst read of every complete record, then one read of the
+ *   accel output registers. The bus is touched three times per balance
+ *   tick no matter how many samples arrived.
+ *   The accelerometer runs on its own, slightly faster grid (1125 vs
+ *   1100 Hz base), so accel and gyro FIFO records would not pair up. Its
+ *   reading is instead interpolated linearly across each batch, from the
+ *   previous drain's value to this one's.
+ *
+ * Compared to ICM20948Interface:
+ * - No Adafruit library: the handful of configuration registers are written
+ *   directly, which also keeps the magnetometer and temperature out of the
+ *   read path
+ * - readSensors() returns false when no new sample has arrived since the
+ *   previous call (same contract as ToFInterface::readDistance())
+ *
+ * Hardware Details:
+ * - INT1 configured push-pull, active high, 50 us pulse per sample (not
+ *   latched, so a missed edge cannot wedge the line); unused in FIFO mode
+ * - FIFO records are 6 bytes: gyro XYZ, big-endian
+ *
+ * Timestamps:
+ * - Data-ready mode stamps each sample with micros() at the INT1 edge
+ * - FIFO mode has no per-record hardware timestamp, so records are placed
+ *   on the gyro's ODR grid: the newest record in the FIFO is anchored
+ *   to the time FIFO_COUNT was read, older ones step back one sample period
+ * - Register bank 0 is left selected after initialize()
+ *
+ * Concurrency:
+ * - ISRs write; readSensors()/readBatch() (balance ISR, higher priority)
+ *   read. Samples and batches are double-buffered and published by flipping
+ *   an index, so the reader never sees a half-written result.
+ * - If the bus guard is held when a read is due, it is deferred and retried
+ *   from the next readSensors()/readBatch() call.
+ *
+ * Usage:
+ *   AsyncI2C imuBus(0);
+ *   ICM20948AsyncInterface imu(&imuBus, &imuBusGuard, 0x69, 2);
+ *   imu.initialize();   // after imuBus.begin()
+ *
+ * Boot overlap: reset() issues the device reset alone; initialize()
+ * called IMU_RESET_TIME_US later then skips the reset wait.
+ */
+class ICM20948AsyncInterface : public IMUInterface {
+private:
+    static constexpr uint8_t SAMPLE_SIZE = 12;        // ACCEL_XOUT_H..GYRO_ZOUT_L
+    static constexpr uint8_t ACCEL_SIZE = 6;
+    static constexpr uint8_t RECORD_SIZE = 6;         // FIFO: gyro only
+    static constexpr uint8_t MAX_BATCH = Config::IMU_FIFO_MAX_BATCH;
+    static_assert(RECORD_SIZE * MAX_BATCH >= SAMPLE_SIZE, "raw buffer too small for a sample");
+
+    enum FifoStage : uint8_t {
+        FIFO_IDLE,
+        FIFO_READ_COUNT,
+        FIFO_READ_DATA,
+        FIFO_READ_ACCEL,
+        FIFO_RESET_ASSERT,
+        FIFO_RESET_RELEASE
+    };
+
+    AsyncI2C* _bus;
+    I2CBusGuard* _guard;
+    uint8_t _i2cAddress;
+    int _intPin;
+
+    float _accelScale;  // m/s² per LSB
+    float _gyroScale;   // rad/s per LSB
+    float _samplePeriod;
+
+    uint8_t _rawBuffer[RECORD_SIZE * MAX_BATCH];
+    uint8_t _countBuffer[2];
+    uint8_t _accelBuffer[ACCEL_SIZE];
+    uint8_t _txBuffer[2];
+    uint8_t _drainRecords;           // records requested by the current drain
+    uint16_t _drainAvailable;        // records in the FIFO when counted
+    uint32_t _drainTimeUs;           // micros() when FIFO_COUNT arrived
+    volatile uint32_t _edgeTimeUs;   // micros() at the last INT1 edge
+    uint32_t _lastTimestampUs;       // newest timestamp published so far
+    uint32_t _samplePeriodUs;
+    float _lastAccel[3];             // robot frame, end of the previous batch
+    bool _accelPrimed;
+    volatile FifoStage _fifoStage;
+
+    IMUSample _batches[2][MAX_BATCH];
+    uint8_t _batchSizes[2];
+    volatile uint8_t _published;     // index of the newest complete batch
+    volatile uint32_t _batchCount;   // incremented per published batch
+    uint32_t _lastReadCount;         // _batchCount seen by the reader
+
+    volatile bool _readPending;      // read due, but bus was busy
+    volatile uint32_t _deferredReads;
+    volatile uint32_t _failedReads;
+    volatile uint32_t _fifoResets;
+
+    bool _resetIssued;
+    uint32_t _resetUs;               // when reset() was sent
+
+    static ICM20948AsyncInterface* _instance;
+    static void dataReadyIsr();
+    static void sampleReadComplete(void* context, bool ok);
+    static void fifoCountComplete(void* context, bool ok);
+    static void fifoDataComplete(void* context, bool ok);
+    static void fifoAccelComplete(void* context, bool ok);
+    static void fifoResetComplete(void* context, bool ok);
+
+    bool writeRegister(uint8_t reg, uint8_t value);
+    bool readRegister(uint8_t reg, uint8_t& value);
+    bool selectBank(uint8_t bank);
+    bool resetFifo();
+    void startSampleRead();
+    void startFifoDrain();
+    void startFifoReset();
+    void decodeAccel(const uint8_t* raw, float& x, float& y, float& z) const;
+    void decodeGyro(const uint8_t* raw, IMUSample& sample) const;
+    void decodeRecord(const uint8_t* raw, IMUSample& sample) const;
+    void publishBatch(uint8_t count, uint32_t newestUs, uint16_t newerInFifo, bool accelFresh);
+    uint8_t takeBatch(IMUSample* samples, uint8_t maxSamples);
+
+public:
+    /**
+     * Constructor
+     * @param bus - async engine for the port the ICM20948 is on
+     * @param guard - ownership flag shared with other users of that port
+     * @param address - I2C address (0x68 or 0x69)
+     * @param intPin - Teensy pin wired to ICM20948 INT1 (data-ready mode)
+     */
+    ICM20948AsyncInterface(AsyncI2C* bus, I2CBusGuard* guard, uint8_t address, int intPin);
+
+    /**
+     * Send the device reset and return without waiting for it. Setup only.
+     * @return false if the bus was busy or the write failed
+     */
+    bool reset();
+
+    /**
+     * Reset (unless reset() already did) and configure the ICM20948, then arm the data-ready interrupt
+     * or start FIFO streaming
+     * @return true if the device answered with the expected WHO_AM_I
+     */
+    bool initialize() override;
+
+    /**
+     * Return the newest completed sample (robot frame). In FIFO mode this is
+     * the last record of the newest batch; earlier records are discarded.
+     * @return true if a new sample arrived since the previous call
+     */
+    bool readSensors(float& accelX, float& accelY, float& accelZ,
+                    float& gyroX, float& gyroY, float& gyroZ) override;
+
+    /**
+     * Return every record drained since the previous call, oldest first,
+     * and start the next drain (FIFO mode). In data-ready mode this returns
+     * at most the single newest sample.
+     */
+    uint8_t readBatch(IMUSample* samples, uint8_t maxSamples) override;
+
+    /**
+     * Gyro ODR period (the sample grid) from the configured rate divider
+     */
+    float getSamplePeriod() const override;
+
+    /**
+     * Reads that found the bus busy and had to be retried
+     */
+    uint32_t getDeferredReadCount() const;
+
+    /**
+     * Burst reads that ended in a bus error
+     */
+    uint32_t getFailedReadCount() const;
+
+    /**
+     * FIFO resets after overflow or a misaligned byte count
+     */
+    uint32_t getFifoResetCount() const;
+};
+
+#endif // ICM20948_ASYNC_INTERFACE_H
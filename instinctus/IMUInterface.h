@@ -0,0 +1,93 @@
+#ifndef IMU_INTERFACE_H
+#define IMU_INTERFACE_H
+
+#include <Arduino.h>
+
+/**
+ * IMUInterface.h - Hardware Abstraction Layer for IMU Sensors
+ * 
+ * This file defines a simple, clean interface that any IMU hardware can implement.
+ * The interface focuses only on the essential functions needed for balance control:
+ * initialization and reading accelerometer/gyroscope data.
+ * 
+ * Design Goals:
+ * - Hardware agnostic - works with any IMU chip (ICM20948, MPU6050, etc.)
+ * - Simple interface - only 2 methods to implement; batch reads are optional
+ * - Easy to swap - new IMU chips require minimal code changes
+ * - No unnecessary complexity - no templates, complex abstractions
+ * 
+ * Usage:
+ * 1. Create a concrete implementation (e.g., ICM20948Interface)
+ * 2. Implement initialize() and readSensors() methods
+ * 3. Optionally override readBatch()/getSamplePeriod() if the chip buffers
+ *    samples (e.g. a hardware FIFO)
+ * 4. Pass to BalanceIMU constructor for dependency injection
+ * 
+ * Example:
+ *   ICM20948Interface imuHardware;
+ *   BalanceIMU balanceIMU(&imuHardware);
+ */
+
+/**
+ * One accelerometer + gyroscope reading in the robot frame
+ * accel in m/s², gyro in rad/s
+ * timestampUs: micros() at which the sample was taken (not when it was
+ * read), so dt between samples is independent of bus and loop latency
+ */
+struct IMUSample {
+    float accelX, accelY, accelZ;
+    float gyroX, gyroY, gyroZ;
+    uint32_t timestampUs;
+};
+
+class IMUInterface {
+public:
+    /**
+     * Initialize the IMU hardware
+     * @return true if initialization successful, false otherwise
+     */
+    virtual bool initialize() = 0;
+    
+    /**
+     * Read accelerometer and gyroscope data
+     * @param accelX, accelY, accelZ - acceleration in m/s²
+     * @param gyroX, gyroY, gyroZ - angular velocity in rad/s
+     * @return true if read successful, false otherwise
+     */
+    virtual bool readSensors(float& accelX, float& accelY, float& accelZ,
+                            float& gyroX, float& gyroY, float& gyroZ) = 0;
+
+    /**
+     * Read every sample buffered since the previous call, oldest first.
+     * Default implementation wraps readSensors() for chips without a FIFO
+     * and stamps the sample with the time of the read.
+     * @param samples - destination array
+     * @param maxSamples - capacity of samples
+     * @return number of samples written (0 if nothing new)
+     */
+    virtual uint8_t readBatch(IMUSample* samples, uint8_t maxSamples) {
+        if (maxSamples == 0) {
+            return 0;
+        }
+        IMUSample& s = samples[0];
+        if (!readSensors(s.accelX, s.accelY, s.accelZ, s.gyroX, s.gyroY, s.gyroZ)) {
+            return 0;
+        }
+        s.timestampUs = micros();
+        return 1;
+    }
+
+    /**
+     * Nominal sensor-side time between consecutive samples
+     * @return period in seconds, or 0 if samples are not evenly spaced.
+     *         Filtering uses IMUSample::timestampUs; this is for consumers
+     *         that need the nominal rate.
+     */
+    virtual float getSamplePeriod() const {
+        return 0.0f;
+    }
+
+    virtual ~IMUInterface() = default;
+};
+
+#endif // IMU_INTERFACE_H
\ No newline at end of file
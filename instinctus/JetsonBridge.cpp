@@ -0,0 +1,128 @@
+/**
+ * JetsonBridge.cpp - Control ISR to Jetson Link Bridge Implementation
+ *
+ * The sketch dispatches the event bus before service(), so a burst of IMU
+ * samples can never delay an emergency frame. Each frame is encoded
+ * directly into the TelemetryWriter buffer; nothing here blocks on the
+ * link.
+ */
+
+#include "JetsonBridge.h"
+
+using namespace Telemetry;
+
+JetsonBridge::JetsonBridge(TelemetryWriter* telemetry, EventBus* bus)
+    : _telemetry(telemetry), _bus(bus), _imuTelemetry(), _link(nullptr), _commandInput(nullptr), _commands() {
+}
+
+ImuTelemetryRing& JetsonBridge::imuTelemetry() {
+    return _imuTelemetry;
+}
+
+void JetsonBridge::setLink(TelemetryLink* link) {
+    _link = link;
+}
+
+void JetsonBridge::setCommandInput(Stream* input) {
+    _commandInput = input;
+}
+
+CommandParser& JetsonBridge::commands() {
+    return _commands;
+}
+
+void JetsonBridge::sendCommandAck(const Commands::Command& command, Commands::CommandStatus status) {
+    CommandAckPayload* p = _telemetry->begin<CommandAckPayload>(FRAME_COMMAND_ACK, micros());
+    p->type = command.type;
+    p->sequence = command.sequence;
+    p->status = status;
+    _telemetry->commit();
+}
+
+bool JetsonBridge::sendAngleEvent(FrameType type, uint32_t timestampUs, float angle, uint16_t count) {
+    // Leave the event queued while the link is full; the topic counts overflow
+    if (!_telemetry->hasRoom(type, sizeof(TiltEventPayload))) {
+        return false;
+    }
+    TiltEventPayload* p = _telemetry->begin<TiltEventPayload>(type, timestampUs);
+    p->angle = angle;
+    p->count = count;
+    _telemetry->commit();
+    return true;
+}
+
+bool JetsonBridge::onTilt(const TiltEvent& event) {
+    return sendAngleEvent(FRAME_TILT_EVENT, event.timestampUs, event.angle, event.count);
+}
+
+bool JetsonBridge::onBalanceEmergency(const BalanceEmergencyEvent& event) {
+    return sendAngleEvent(FRAME_EMERGENCY_STOP, event.timestampUs, event.angle, 1);
+}
+
+bool JetsonBridge::onObstacle(const ObstacleEvent& event) {
+    if (!_telemetry->hasRoom(FRAME_PROXIMITY, sizeof(ProximityPayload))) {
+        return false;
+    }
+    ProximityPayload* p = _telemetry->begin<ProximityPayload>(FRAME_PROXIMITY, event.timestampUs);
+    p->sensorId = event.sensorId;
+    p->distanceMm = event.distanceMm;
+    p->closingMmS = event.closingMmS;
+    p->timeToContactS = event.timeToContactS;
+    p->count = event.count;
+    _telemetry->commit();
+    return true;
+}
+
+bool JetsonBridge::onCollision(const CollisionEvent& event) {
+    if (!_telemetry->hasRoom(FRAME_COLLISION, sizeof(CollisionPayload))) {
+        return false;
+    }
+    CollisionPayload* p = _telemetry->begin<CollisionPayload>(FRAME_COLLISION, event.timestampUs);
+    p->magnitude = event.magnitude;
+    p->jerkMS3 = event.jerkMS3;
+    p->angularAccelRadS2 = event.angularAccelRadS2;
+    _telemetry->commit();
+    return true;
+}
+
+void JetsonBridge::service() {
+    if (_commandInput) {
+        uint8_t bytes = MAX_COMMAND_BYTES_PER_SERVICE;
+        while (bytes-- > 0 && _commandInput->available() > 0) {
+            _commands.feed((uint8_t)_commandInput->read());
+        }
+    }
+
+    uint8_t budget = MAX_FRAMES_PER_SERVICE;
+
+    ImuTelemetrySample sample;
+    while (budget > 0 && _telemetry->hasRoom(FRAME_BALANCE_IMU, sizeof(BalanceImuPayload)) && _imuTelemetry.pop(sample)) {
+        BalanceImuPayload* p = _telemetry->begin<BalanceImuPayload>(FRAME_BALANCE_IMU, sample.timestampUs);
+        *p = sample.data;
+        _telemetry->commit();
+        budget--;
+    }
+
+    if (_link) {
+        _link->service();
+    }
+}
+
+void JetsonBridge::sendLinkHealth() {
+    LinkHealthPayload* p = _telemetry->begin<LinkHealthPayload>(FRAME_LINK_HEALTH, micros());
+    p->eventDrops = _bus->getDropCount();
+    p->eventHighWater = _bus->getHighWater();
+    p->imuOverwrites = _imuTelemetry.getDropCount();
+    p->framesSent = _telemetry->getFramesSent();
+    p->framesDropped = _telemetry->getFramesDropped();
+    p->eventsCoalesced = _bus->getCoalescedCount();
+    p->commandsAccepted = _commands.getAcceptedCount();
+    p->commandErrors = _commands.getErrorCount();
+    for (uint8_t c = 0; c < LINK_CHANNELS; c++) {
+        uint32_t dropped = _link ? _link->getDropCount((LinkChannel)c) : 0;
+        uint16_t highWater = _link ? _link->getHighWater((LinkChannel)c) : 0;
+        p->channelDropped[c] = dropped;
+        p->channelHighWater[c] = highWater;
+    }
+    _telemetry->commit();
+}
@@ -0,0 +1,127 @@
+#ifndef JETSON_BRIDGE_H
+#define JETSON_BRIDGE_H
+
+#include <Arduino.h>
+#include "SpscRing.h"
+#include "EventBus.h"
+#include "TelemetryFrame.h"
+#include "TelemetryWriter.h"
+#include "TelemetryLink.h"
+#include "CommandParser.h"
+
+/**
+ * JetsonBridge.h - Control ISR to Jetson Link Bridge
+ *
+ * Turns data produced in the balance ISR into binary frames from loop().
+ * This is the single-core replacement for EventBroadcaster::sendToM7: the
+ * ISR only ever pushes into a queue, and all Serial traffic happens at
+ * loop priority.
+ *
+ * Sources:
+ * - Events: a DEFERRED subscriber on the EventBus tilt, emergency,
+ *   collision and obstacle topics. A handler refuses the event while the link has no
+ *   room for the frame, so a slow link backs up into the topic queue
+ *   where it is counted rather than lost silently. Tilt and obstacle
+ *   arrive already coalesced and rate limited; their frames carry the
+ *   merged count.
+ * - imuTelemetry: decimated IMU samples, OVERWRITE_OLDEST. Stale samples
+ *   are worthless, so a slow link just means the freshest are sent.
+ *
+ * Commands (Jetson -> Teensy, CommandFrame.h): service() feeds received
+ * bytes from the command input through a CommandParser, a bounded number
+ * per call. The sketch pops the checked commands, executes them and
+ * answers each with sendCommandAck().
+ *
+ * Link: with a TelemetryLink attached, service() also pumps its channel
+ * queues to the ports, and the per-channel drops and queue depths go
+ * into FRAME_LINK_HEALTH.
+ *
+ * Backpressure is reported in FRAME_LINK_HEALTH by sendLinkHealth().
+ *
+ * Usage:
+ *   JetsonBridge bridge(&telemetry, &eventBus);
+ *   bridge.setLink(&link);               // optional, when telemetry uses one
+ *   eventBus.tilt.subscribe<JetsonBridge, &JetsonBridge::onTilt>(&bridge, Dispatch::DEFERRED);
+ *   bridge.imuTelemetry().push(sample);  // balance ISR
+ *   eventBus.dispatchDeferred(8);        // loop slot
+ *   bridge.service();                    // loop slot
+ *   while (bridge.commands().pop(cmd)) { ... bridge.sendCommandAck(cmd, status); }
+ */
+
+/**
+ * IMU telemetry record produced in the balance ISR
+ */
+struct ImuTelemetrySample {
+    uint32_t timestampUs;
+    Telemetry::BalanceImuPayload data;
+};
+
+typedef SpscRing<ImuTelemetrySample, 8, RingPolicy::OVERWRITE_OLDEST> ImuTelemetryRing;
+
+class JetsonBridge {
+private:
+    // Bounds one service() call so a backlog cannot starve other loop slots
+    static constexpr uint8_t MAX_FRAMES_PER_SERVICE = 8;
+    static constexpr uint8_t MAX_COMMAND_BYTES_PER_SERVICE = 64;   // 32 KB/s at the 2 ms slot
+
+    TelemetryWriter* _telemetry;
+    EventBus* _bus;
+    ImuTelemetryRing _imuTelemetry;
+    TelemetryLink* _link;
+    Stream* _commandInput;
+    CommandParser _commands;
+
+    bool sendAngleEvent(Telemetry::FrameType type, uint32_t timestampUs, float angle, uint16_t count);
+
+public:
+    /**
+     * Constructor
+     * @param telemetry - frame writer for the Jetson link
+     * @param bus - event bus whose queue counters go into FRAME_LINK_HEALTH
+     */
+    JetsonBridge(TelemetryWriter* telemetry, EventBus* bus);
+
+    ImuTelemetryRing& imuTelemetry();
+
+    /**
+     * Service and report the link the telemetry writer queues on
+     * @param link - the writer's TelemetryLink, or nullptr for a plain port
+     */
+    void setLink(TelemetryLink* link);
+
+    /**
+     * Read commands from a stream (usually the same port as telemetry)
+     * @param input - byte source, or nullptr for no commands
+     */
+    void setCommandInput(Stream* input);
+
+    CommandParser& commands();
+
+    /**
+     * Answer a command with FRAME_COMMAND_ACK. Loop context.
+     */
+    void sendCommandAck(const Commands::Command& command, Commands::CommandStatus status);
+
+    /**
+     * Deferred event handlers: write the frame, or return false (event
+     * stays queued) if the link has no room. Loop context.
+     */
+    bool onTilt(const TiltEvent& event);                  // FRAME_TILT_EVENT
+    bool onBalanceEmergency(const BalanceEmergencyEvent& event);  // FRAME_EMERGENCY_STOP
+    bool onObstacle(const ObstacleEvent& event);          // FRAME_PROXIMITY
+    bool onCollision(const CollisionEvent& event);        // FRAME_COLLISION
+
+    /**
+     * Feed received command bytes to the parser, drain queued IMU
+     * samples into frames, then pump the link. Loop context only; dispatch the event bus
+     * first so events go out ahead of telemetry.
+     */
+    void service();
+
+    /**
+     * Send queue and link backpressure counters as FRAME_LINK_HEALTH
+     */
+    void sendLinkHealth();
+};
+
+#endif // JETSON_BRIDGE_H
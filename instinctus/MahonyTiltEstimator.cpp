@@ -0,0 +1,115 @@
+/**
+ * MahonyTiltEstimator.cpp - Quaternion Mahony Attitude Filter Implementation
+ *
+ * Per sample:
+ * 1. v = gravity ("up") direction predicted by the quaternion, in body axes
+ * 2. e = a_normalized x v, the rotation that would align them
+ * 3. omega = gyro + Kp * w * e + integral(Ki * w * e), w = accel gate weight
+ * 4. q += 0.5 * q * (0, omega) * dt, then renormalize
+ *
+ * The first sample seeds roll and pitch directly from the accelerometer so
+ * the estimate does not have to converge from level at power-up.
+ */
+
+#include "MahonyTiltEstimator.h"
+#include "MemoryPlacement.h"
+#include "FastMath.h"
+#include <BalanceConfig.h>
+#include <math.h>
+
+static constexpr float GRAVITY = 9.80665f;
+
+MahonyTiltEstimator::MahonyTiltEstimator() {
+    reset();
+}
+
+void MahonyTiltEstimator::reset() {
+    _q0 = 1.0f;
+    _q1 = _q2 = _q3 = 0.0f;
+    _integralX = _integralY = _integralZ = 0.0f;
+    _initialized = false;
+}
+
+HOT_CODE void MahonyTiltEstimator::initializeFromAccel(const IMUSample& sample) {
+    float roll = atan2f(sample.accelY, sample.accelZ);
+    float pitch = atan2f(-sample.accelX, sqrtf(sample.accelY * sample.accelY +
+                                               sample.accelZ * sample.accelZ));
+    float cr = cosf(roll * 0.5f), sr = sinf(roll * 0.5f);
+    float cp = cosf(pitch * 0.5f), sp = sinf(pitch * 0.5f);
+
+    // Yaw is unobservable without a magnetometer; start it at zero
+    _q0 = cr * cp;
+    _q1 = sr * cp;
+    _q2 = cr * sp;
+    _q3 = -sr * sp;
+    _initialized = true;
+}
+
+HOT_CODE float MahonyTiltEstimator::update(const IMUSample& sample, float deltaTime) {
+    float ax = sample.accelX, ay = sample.accelY, az = sample.accelZ;
+    float accelNorm = sqrtf(ax * ax + ay * ay + az * az);
+
+    if (!_initialized && accelNorm > 0.0f) {
+        initializeFromAccel(sample);
+    }
+
+    float gx = sample.gyroX, gy = sample.gyroY, gz = sample.gyroZ;
+
+    // Accel gate: full trust at 1 g, none beyond MAHONY_ACCEL_GATE away
+    float deviation = fabsf(accelNorm / GRAVITY - 1.0f);
+    float weight = 1.0f - deviation / Config::MAHONY_ACCEL_GATE;
+
+    if (weight > 0.0f) {
+        float inv = 1.0f / accelNorm;
+        ax *= inv;
+        ay *= inv;
+        az *= inv;
+
+        // Predicted up vector: third row of the body -> world rotation
+        float vx = 2.0f * (_q1 * _q3 - _q0 * _q2);
+        float vy = 2.0f * (_q0 * _q1 + _q2 * _q3);
+        float vz = _q0 * _q0 - _q1 * _q1 - _q2 * _q2 + _q3 * _q3;
+
+        float ex = (ay * vz - az * vy) * weight;
+        float ey = (az * vx - ax * vz) * weight;
+        float ez = (ax * vy - ay * vx) * weight;
+
+        if (Config::MAHONY_KI > 0.0f) {
+            _integralX += Config::MAHONY_KI * ex * deltaTime;
+            _integralY += Config::MAHONY_KI * ey * deltaTime;
+            _integralZ += Config::MAHONY_KI * ez * deltaTime;
+        }
+
+        gx += Config::MAHONY_KP * ex;
+        gy += Config::MAHONY_KP * ey;
+        gz += Config::MAHONY_KP * ez;
+    }
+
+    gx += _integralX;
+    gy += _integralY;
+    gz += _integralZ;
+
+    // q_dot = 0.5 * q * (0, omega)
+    float half = 0.5f * deltaTime;
+    float q0 = _q0, q1 = _q1, q2 = _q2, q3 = _q3;
+    _q0 += (-q1 * gx - q2 * gy - q3 * gz) * half;
+    _q1 += ( q0 * gx + q2 * gz - q3 * gy) * half;
+    _q2 += ( q0 * gy - q1 * gz + q3 * gx) * half;
+    _q3 += ( q0 * gz + q1 * gy - q2 * gx) * half;
+
+    float norm = 1.0f / sqrtf(_q0 * _q0 + _q1 * _q1 + _q2 * _q2 + _q3 * _q3);
+    _q0 *= norm;
+    _q1 *= norm;
+    _q2 *= norm;
+    _q3 *= norm;
+
+    // Tilt in the accelerometer's atan2(x, z) convention, from the
+    // estimated gravity direction instead of the raw (accelerating) reading
+    float vx = 2.0f * (_q1 * _q3 - _q0 * _q2);
+    float vz = _q0 * _q0 - _q1 * _q1 - _q2 * _q2 + _q3 * _q3;
+    return FastMath::toDegrees(FastMath::fastAtan2(vx, vz));
+}
+
+const char* MahonyTiltEstimator::getName() const {
+    return "mahony";
+}
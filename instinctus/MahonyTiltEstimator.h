@@ -0,0 +1,43 @@
+#ifndef MAHONY_TILT_ESTIMATOR_H
+#define MAHONY_TILT_ESTIMATOR_H
+
+#include "TiltEstimator.h"
+
+/**
+ * MahonyTiltEstimator.h - Quaternion Mahony Attitude Filter
+ *
+ * Integrates all three gyro axes into an attitude quaternion and steers it
+ * toward the measured gravity direction with a PI correction (Mahony et
+ * al., "Nonlinear Complementary Filters on the Special Orthogonal Group").
+ * Tilt is read back from the estimated gravity vector using the same
+ * atan2(x, z) convention as the accelerometer tilt.
+ *
+ * Linear Acceleration Rejection:
+ * - The accel correction is weighted by how close |accel| is to 1 g. The
+ *   weight falls linearly to zero at Config::MAHONY_ACCEL_GATE (fraction of
+ *   g), so hard wheel acceleration is ridden out on the gyro alone instead
+ *   of dragging the estimate. The integral term only learns when the
+ *   weight is non-zero.
+ *
+ * Cost: ~60 float ops and one sqrt per sample, no trig except the final
+ * fastAtan2 and a one-time initialization from the first sample.
+ *
+ * Gains: Config::MAHONY_KP, Config::MAHONY_KI (BalanceConfig.h)
+ */
+class MahonyTiltEstimator : public TiltEstimator {
+private:
+    float _q0, _q1, _q2, _q3;              // body -> world attitude
+    float _integralX, _integralY, _integralZ;
+    bool _initialized;
+
+    void initializeFromAccel(const IMUSample& sample);
+
+public:
+    MahonyTiltEstimator();
+
+    void reset() override;
+    float update(const IMUSample& sample, float deltaTime) override;
+    const char* getName() const override;
+};
+
+#endif // MAHONY_TILT_ESTIMATOR_H
@@ -0,0 +1,51 @@
+#ifndef MEMORY_PLACEMENT_H
+#define MEMORY_PLACEMENT_H
+
+#include <Arduino.h>
+
+/**
+ * MemoryPlacement.h - Linker Section Policy for the i.MX RT1062
+ *
+ * Memory map (Teensy 4.1):
+ * - RAM1, 512 KB tightly coupled, zero wait state, split in 32 KB banks
+ *   between ITCM (code) and DTCM (data). The core's linker script puts
+ *   every function not marked FLASHMEM in ITCM, and all initialized and
+ *   zeroed globals, plus the stack, in DTCM.
+ * - RAM2 (OCRAM), 512 KB on the AXI bus through the data cache: DMAMEM.
+ *   NOLOAD, so not zeroed at boot.
+ * - Flash, executed in place through the 32 KB I-cache: FLASHMEM.
+ * - PSRAM (optional chip), cached, slowest: EXTMEM.
+ *
+ * Every byte of ITCM is taken from DTCM, so "everything in ITCM by
+ * default" fills RAM1 with code that runs once. The policy is therefore:
+ *
+ *   HOT_CODE   balance ISR and everything it calls, CAN and I2C ISRs.
+ *              ITCM: no cache misses, so no worst-case fetch stalls.
+ *   COLD_CODE  setup() and one-shot init. Flash, frees ITCM for hot
+ *              code and DTCM for data.
+ *   (default)  Everything else stays in ITCM as the core places it.
+ *   HOT_DATA   Globals, the ISR-to-loop rings and the stack: DTCM by
+ *              default, nothing to annotate.
+ *   BULK_DATA  Large buffers only touched by loop(), e.g. the black-box
+ *              ring and ToF ranging scratch: OCRAM.
+ *
+ * Placement check: host/memory_report.py lists what landed in each region
+ * from the built ELF and flags HOT_CODE symbols found outside ITCM.
+ *
+ * Worst-case A/B: build with -DINSTINCTUS_HOT_IN_FLASH (together with
+ * -DINSTINCTUS_PROFILE) to move HOT_CODE to flash, and compare the
+ * "balance"/"control" FRAME_PROFILE maxCycles and the upper histogram
+ * buckets against a normal profiled build. The means barely move; the
+ * maxima are cache refills after loop() code evicted the ISR's lines.
+ */
+
+#ifdef INSTINCTUS_HOT_IN_FLASH
+#define HOT_CODE FLASHMEM
+#else
+#define HOT_CODE FASTRUN
+#endif
+
+#define COLD_CODE FLASHMEM
+#define BULK_DATA DMAMEM
+
+#endif // MEMORY_PLACEMENT_H
@@ -0,0 +1,187 @@
+/**
+ * ODriveAxis.cpp - One ODrive S1 Axis over CANSimple Implementation
+ *
+ * Payload layouts (little-endian):
+ * - Heartbeat:       uint32 axis_error, uint8 axis_state, uint8 procedure_result, uint8 traj_done
+ * - Encoder:         float pos_estimate (rev), float vel_estimate (rev/s)
+ * - Iq:              float iq_setpoint, float iq_measured (A)
+ * - Bus V/I:         float bus_voltage (V), float bus_current (A)
+ * - Set_Input_Vel:   float input_vel (rev/s), float input_torque_ff (Nm)
+ * - Set_Axis_State:  uint32 requested_state
+ * - Clear_Errors:    uint8 identify (0)
+ *
+ * Both sides are little-endian, so fields are memcpy'd straight in and out.
+ */
+
+#include "ODriveAxis.h"
+#include "MemoryPlacement.h"
+
+static float readFloat(const uint8_t* p) {
+    float value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static uint32_t readU32(const uint8_t* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+ODriveAxis::ODriveAxis(CANInterface* can, uint8_t nodeId)
+    : _can(can), _nodeId(nodeId), _encoder(), _encoderPublished(0), _encoderCount(0),
+      _axisError(0), _axisState(AXIS_STATE_UNDEFINED), _lastHeartbeatUs(0), _heartbeatCount(0),
+      _iqSetpoint(0), _iqMeasured(0), _busVoltage(0), _busCurrent(0),
+      _txFailures(0) {
+}
+
+uint8_t ODriveAxis::getNodeId() const {
+    return _nodeId;
+}
+
+HOT_CODE bool ODriveAxis::send(Command command, const void* payload, uint8_t length) {
+    CANFrame frame;
+    frame.id = ((uint32_t)_nodeId << NODE_SHIFT) | command;
+    frame.len = length;
+    frame.extended = false;
+    frame.timestampUs = 0;
+    if (length) {
+        memcpy(frame.data, payload, length);
+    }
+
+    if (!_can || !_can->write(frame)) {
+        _txFailures++;
+        return false;
+    }
+    return true;
+}
+
+HOT_CODE bool ODriveAxis::setInputVelocity(float velocityRevS, float torqueFeedForward) {
+    uint8_t payload[8];
+    memcpy(&payload[0], &velocityRevS, 4);
+    memcpy(&payload[4], &torqueFeedForward, 4);
+    return send(CMD_SET_INPUT_VEL, payload, sizeof(payload));
+}
+
+bool ODriveAxis::requestState(AxisState state) {
+    uint32_t requested = state;
+    return send(CMD_SET_AXIS_STATE, &requested, sizeof(requested));
+}
+
+bool ODriveAxis::estop() {
+    return send(CMD_ESTOP, nullptr, 0);
+}
+
+bool ODriveAxis::clearErrors() {
+    uint8_t identify = 0;
+    return send(CMD_CLEAR_ERRORS, &identify, sizeof(identify));
+}
+
+HOT_CODE bool ODriveAxis::handleFrame(const CANFrame& frame) {
+    if (frame.extended || (frame.id >> NODE_SHIFT) != _nodeId) {
+        return false;
+    }
+
+    switch (frame.id & CMD_MASK) {
+        case CMD_HEARTBEAT:
+            if (frame.len < 5) {
+                return false;
+            }
+            _axisError = readU32(&frame.data[0]);
+            _axisState = frame.data[4];
+            _lastHeartbeatUs = frame.timestampUs;
+            _heartbeatCount++;
+            return true;
+
+        case CMD_ENCODER_ESTIMATES: {
+            if (frame.len < 8) {
+                return false;
+            }
+            // Fill the slot the reader isn't using, then flip
+            uint8_t next = _encoderPublished ^ 1;
+            _encoder[next].positionRev = readFloat(&frame.data[0]);
+            _encoder[next].velocityRevS = readFloat(&frame.data[4]);
+            _encoder[next].timestampUs = frame.timestampUs;
+            _encoderPublished = next;
+            _encoderCount++;
+            return true;
+        }
+
+        case CMD_IQ:
+            if (frame.len < 8) {
+                return false;
+            }
+            _iqSetpoint = readFloat(&frame.data[0]);
+            _iqMeasured = readFloat(&frame.data[4]);
+            return true;
+
+        case CMD_BUS_VOLTAGE_CURRENT:
+            if (frame.len < 8) {
+                return false;
+            }
+            _busVoltage = readFloat(&frame.data[0]);
+            _busCurrent = readFloat(&frame.data[4]);
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+HOT_CODE bool ODriveAxis::getEncoderEstimate(EncoderEstimate& estimate) const {
+    // A reader the CAN ISR can preempt (loop context) retries if a new
+    // frame landed mid-copy; the balance ISR is never preempted by it
+    uint32_t count;
+    do {
+        count = _encoderCount;
+        if (count == 0) {
+            return false;
+        }
+        estimate = _encoder[_encoderPublished];
+    } while (count != _encoderCount);
+    return true;
+}
+
+uint32_t ODriveAxis::getEncoderCount() const {
+    return _encoderCount;
+}
+
+uint32_t ODriveAxis::getAxisError() const {
+    return _axisError;
+}
+
+uint8_t ODriveAxis::getAxisState() const {
+    return _axisState;
+}
+
+uint32_t ODriveAxis::getLastHeartbeatUs() const {
+    return _lastHeartbeatUs;
+}
+
+uint32_t ODriveAxis::getHeartbeatCount() const {
+    return _heartbeatCount;
+}
+
+bool ODriveAxis::isAlive(uint32_t timeoutUs) const {
+    return _heartbeatCount != 0 && (micros() - _lastHeartbeatUs) < timeoutUs;
+}
+
+float ODriveAxis::getIqSetpoint() const {
+    return _iqSetpoint;
+}
+
+float ODriveAxis::getIqMeasured() const {
+    return _iqMeasured;
+}
+
+float ODriveAxis::getBusVoltage() const {
+    return _busVoltage;
+}
+
+float ODriveAxis::getBusCurrent() const {
+    return _busCurrent;
+}
+
+uint32_t ODriveAxis::getTxFailureCount() const {
+    return _txFailures;
+}
@@ -0,0 +1,135 @@
+#ifndef ODRIVE_AXIS_H
+#define ODRIVE_AXIS_H
+
+#include <Arduino.h>
+#include "CANInterface.h"
+
+/**
+ * ODriveAxis.h - One ODrive S1 Axis over CANSimple
+ *
+ * Encodes commands for, and decodes cyclic messages from, a single ODrive
+ * node. Arbitration ID = node_id << 5 | cmd_id, 11-bit standard frames,
+ * little-endian payloads (ODrive CANSimple protocol, firmware 0.6).
+ *
+ * Commands (never block, return false if the frame could not be queued):
+ * - setInputVelocity()  0x0D Set_Input_Vel (rev/s, torque feed-forward Nm)
+ * - requestState()      0x07 Set_Axis_State
+ * - estop()             0x02 Estop
+ * - clearErrors()       0x18 Clear_Errors
+ *
+ * Cyclic feedback (configure the rates on the ODrive side):
+ * - 0x01 Heartbeat, 0x09 Encoder estimates, 0x14 Iq, 0x17 Bus voltage/current
+ *
+ * Concurrency:
+ * - handleFrame() runs in the CAN ISR. Encoder estimates are published
+ *   through a double buffer with an index flip, so the balance ISR, which
+ *   can preempt the CAN ISR, always reads a position/velocity pair from
+ *   the same frame; loop-context readers retry if a frame lands mid-copy.
+ *   Other feedback fields are single words.
+ *
+ * Usage:
+ *   ODriveAxis left(&can, Config::MOTOR_LEFT.canId);
+ *   left.requestState(ODriveAxis::AXIS_STATE_CLOSED_LOOP_CONTROL);
+ *   left.setInputVelocity(1.5f);
+ *   ODriveAxis::EncoderEstimate e;
+ *   if (left.getEncoderEstimate(e)) { ... }
+ */
+class ODriveAxis {
+public:
+    enum Command : uint8_t {
+        CMD_HEARTBEAT         = 0x01,
+        CMD_ESTOP             = 0x02,
+        CMD_SET_AXIS_STATE    = 0x07,
+        CMD_ENCODER_ESTIMATES = 0x09,
+        CMD_SET_INPUT_VEL     = 0x0D,
+        CMD_IQ                = 0x14,
+        CMD_BUS_VOLTAGE_CURRENT = 0x17,
+        CMD_CLEAR_ERRORS      = 0x18
+    };
+
+    enum AxisState : uint8_t {
+        AXIS_STATE_UNDEFINED           = 0,
+        AXIS_STATE_IDLE                = 1,
+        AXIS_STATE_CLOSED_LOOP_CONTROL = 8
+    };
+
+    struct EncoderEstimate {
+        float positionRev;
+        float velocityRevS;
+        uint32_t timestampUs;          // micros() when the frame arrived
+    };
+
+    static constexpr uint8_t NODE_SHIFT = 5;
+    static constexpr uint32_t CMD_MASK = 0x1F;
+
+private:
+    CANInterface* _can;
+    uint8_t _nodeId;
+
+    EncoderEstimate _encoder[2];
+    volatile uint8_t _encoderPublished;
+    volatile uint32_t _encoderCount;
+
+    volatile uint32_t _axisError;
+    volatile uint8_t _axisState;
+    volatile uint32_t _lastHeartbeatUs;
+    volatile uint32_t _heartbeatCount;
+    volatile float _iqSetpoint;
+    volatile float _iqMeasured;
+    volatile float _busVoltage;
+    volatile float _busCurrent;
+
+    uint32_t _txFailures;
+
+    bool send(Command command, const void* payload, uint8_t length);
+
+public:
+    /**
+     * Constructor
+     * @param can - bus the ODrive is on
+     * @param nodeId - ODrive axis node_id (Config::MOTOR_*.canId)
+     */
+    ODriveAxis(CANInterface* can, uint8_t nodeId);
+
+    uint8_t getNodeId() const;
+
+    bool setInputVelocity(float velocityRevS, float torqueFeedForward = 0.0f);
+    bool requestState(AxisState state);
+    bool estop();
+    bool clearErrors();
+
+    /**
+     * Decode a frame addressed to this node. CAN ISR context.
+     * @return true if the command was recognized
+     */
+    bool handleFrame(const CANFrame& frame);
+
+    /**
+     * Latest encoder estimate
+     * @return false if none has been received yet
+     */
+    bool getEncoderEstimate(EncoderEstimate& estimate) const;
+    uint32_t getEncoderCount() const;
+
+    uint32_t getAxisError() const;
+    uint8_t getAxisState() const;
+    uint32_t getLastHeartbeatUs() const;
+    uint32_t getHeartbeatCount() const;
+
+    /**
+     * True if a heartbeat arrived within timeoutUs
+     */
+    bool isAlive(uint32_t timeoutUs) const;
+
+    float getIqSetpoint() const;
+    float getIqMeasured() const;
+    float getBusVoltage() const;
+    float getBusCurrent() const;
+
+    /**
+     * Commands that could not be queued on the bus
+     */
+    uint32_t getTxFailureCount() const;
+};
+
+#endif // ODRIVE_AXIS_H
@@ -0,0 +1,49 @@
+/**
+ * ODriveCAN.cpp - ODrive CAN Bus Dispatcher Implementation
+ *
+ * onFrame() runs in the CAN ISR: a linear scan over at most MAX_AXES
+ * axes, then a switch on the command ID inside ODriveAxis::handleFrame().
+ */
+
+#include "ODriveCAN.h"
+#include "MemoryPlacement.h"
+
+ODriveCAN::ODriveCAN(CANInterface* can)
+    : _can(can), _axes(), _axisCount(0), _rxFrames(0), _rxUnhandled(0) {
+}
+
+COLD_CODE bool ODriveCAN::addAxis(ODriveAxis* axis) {
+    if (!axis || _axisCount >= MAX_AXES) {
+        return false;
+    }
+    _axes[_axisCount++] = axis;
+    return true;
+}
+
+COLD_CODE bool ODriveCAN::begin(uint32_t bitrate) {
+    if (!_can) {
+        return false;
+    }
+    _can->setReceiveHandler(onFrame, this);
+    return _can->begin(bitrate);
+}
+
+HOT_CODE void ODriveCAN::onFrame(void* context, const CANFrame& frame) {
+    ODriveCAN* self = static_cast<ODriveCAN*>(context);
+    self->_rxFrames++;
+
+    for (uint8_t i = 0; i < self->_axisCount; i++) {
+        if (self->_axes[i]->handleFrame(frame)) {
+            return;
+        }
+    }
+    self->_rxUnhandled++;
+}
+
+uint32_t ODriveCAN::getRxFrameCount() const {
+    return _rxFrames;
+}
+
+uint32_t ODriveCAN::getRxUnhandledCount() const {
+    return _rxUnhandled;
+}
@@ -0,0 +1,54 @@
+#ifndef ODRIVE_CAN_H
+#define ODRIVE_CAN_H
+
+#include <Arduino.h>
+#include "CANInterface.h"
+#include "ODriveAxis.h"
+
+/**
+ * ODriveCAN.h - ODrive CAN Bus Dispatcher
+ *
+ * Owns the receive side of the motor bus: every frame from the CAN ISR
+ * is routed to the ODriveAxis whose node_id matches (id >> 5). Frames for
+ * unknown nodes are counted and dropped.
+ *
+ * Usage:
+ *   FlexCANInterface can(Config::CAN_IRQ_PRIORITY);
+ *   ODriveCAN odrive(&can);
+ *   ODriveAxis left(&can, Config::MOTOR_LEFT.canId);
+ *   odrive.addAxis(&left);
+ *   odrive.begin(Config::CAN_BUS_SPEED);
+ */
+class ODriveCAN {
+public:
+    static constexpr uint8_t MAX_AXES = 4;
+
+private:
+    CANInterface* _can;
+    ODriveAxis* _axes[MAX_AXES];
+    uint8_t _axisCount;
+
+    volatile uint32_t _rxFrames;
+    volatile uint32_t _rxUnhandled;
+
+    static void onFrame(void* context, const CANFrame& frame);
+
+public:
+    explicit ODriveCAN(CANInterface* can);
+
+    /**
+     * Register an axis for RX dispatch. Call before begin().
+     * @return false if the table is full
+     */
+    bool addAxis(ODriveAxis* axis);
+
+    /**
+     * Install the receive handler and bring the bus up
+     */
+    bool begin(uint32_t bitrate);
+
+    uint32_t getRxFrameCount() const;
+    uint32_t getRxUnhandledCount() const;
+};
+
+#endif // ODRIVE_CAN_H
@@ -0,0 +1,261 @@
+/**
+ * ParamStore.cpp - Runtime-Tunable Parameters Implementation
+ *
+ * EEPROM slot layout (little-endian):
+ *   0   2  magic "CP"
+ *   2   1  slot format version
+ *   3   1  record count n
+ *   4   4  sequence number (newer = larger)
+ *   8   5n records: id, float value
+ *   8+5n 2 CRC-16/CCITT-FALSE over bytes 0 .. 8+5n-1
+ */
+
+#include "ParamStore.h"
+#include "TelemetryWriter.h"
+#include "MemoryPlacement.h"
+#include <EEPROM.h>
+#include <BalanceConfig.h>
+#include <BoardConfig.h>
+#include <stddef.h>
+
+using namespace Telemetry;
+using namespace Commands;
+
+static constexpr uint16_t SLOT_MAGIC = 0x5043;       // "CP"
+static constexpr uint8_t SLOT_VERSION = 1;
+static constexpr uint8_t SLOT_HEADER_BYTES = 8;
+static constexpr uint8_t SLOT_RECORD_BYTES = 1 + sizeof(float);
+
+#define PARAM_FIELD(field) (uint16_t)offsetof(ParamBlock, field)
+
+static const ParamStore::ParamInfo REGISTRY[] = {
+    { PARAM_TILT_KP,               ParamStore::TYPE_FLOAT,  PARAM_FIELD(tiltKp),     0.0f, 1000.0f, true },
+    { PARAM_TILT_KI,               ParamStore::TYPE_FLOAT,  PARAM_FIELD(tiltKi),     0.0f, 1000.0f, true },
+    { PARAM_TILT_KD,               ParamStore::TYPE_FLOAT,  PARAM_FIELD(tiltKd),     0.0f, 1000.0f, true },
+    { PARAM_VELOCITY_KP,           ParamStore::TYPE_FLOAT,  PARAM_FIELD(velocityKp), 0.0f, 1000.0f, true },
+    { PARAM_VELOCITY_KI,           ParamStore::TYPE_FLOAT,  PARAM_FIELD(velocityKi), 0.0f, 1000.0f, true },
+    { PARAM_TILT_ALPHA,            ParamStore::TYPE_FLOAT,  PARAM_FIELD(tiltAlpha),  0.5f, 0.999f, false },
+    { PARAM_TILT_CHANGE_THRESHOLD, ParamStore::TYPE_FLOAT,  PARAM_FIELD(tiltChangeThresholdDeg), 0.1f, 20.0f, false },
+    { PARAM_EMERGENCY_TILT_ANGLE,  ParamStore::TYPE_FLOAT,  PARAM_FIELD(emergencyTiltDeg),       10.0f, 80.0f, false },
+    { PARAM_TOF_FRONT_WARN_MM,     ParamStore::TYPE_FLOAT,  PARAM_FIELD(tofWarnMm[SENSOR_FRONT]), 0.0f, 4000.0f, false },
+    { PARAM_TOF_REAR_WARN_MM,      ParamStore::TYPE_FLOAT,  PARAM_FIELD(tofWarnMm[SENSOR_REAR]),  0.0f, 4000.0f, false },
+    { PARAM_TOF_BUDGET_IDLE_US,    ParamStore::TYPE_UINT32, PARAM_FIELD(tofBudgetUs[0]), 10000.0f, 500000.0f, false },
+    { PARAM_TOF_BUDGET_CRUISE_US,  ParamStore::TYPE_UINT32, PARAM_FIELD(tofBudgetUs[1]), 10000.0f, 500000.0f, false },
+    { PARAM_TOF_BUDGET_FAST_US,    ParamStore::TYPE_UINT32, PARAM_FIELD(tofBudgetUs[2]), 10000.0f, 500000.0f, false },
+};
+
+static constexpr uint8_t PARAM_COUNT = sizeof(REGISTRY) / sizeof(REGISTRY[0]);
+
+static_assert(PARAM_TOF_PROFILES == 3, "one PARAM_TOF_BUDGET_* id per ranging profile");
+static_assert(PARAM_COUNT <= MAX_PARAM_RECORDS, "FRAME_PARAMS too small for the registry");
+static_assert(SLOT_HEADER_BYTES + PARAM_COUNT * SLOT_RECORD_BYTES + 2 <= Config::PARAM_EEPROM_SLOT_BYTES,
+              "PARAM_EEPROM_SLOT_BYTES too small for the registry");
+
+static float readField(const ParamBlock& block, const ParamStore::ParamInfo& info) {
+    const uint8_t* field = reinterpret_cast<const uint8_t*>(&block) + info.offset;
+    if (info.type == ParamStore::TYPE_UINT32) {
+        uint32_t value;
+        memcpy(&value, field, sizeof(value));
+        return (float)value;
+    }
+    float value;
+    memcpy(&value, field, sizeof(value));
+    return value;
+}
+
+static void writeField(ParamBlock& block, const ParamStore::ParamInfo& info, float value) {
+    uint8_t* field = reinterpret_cast<uint8_t*>(&block) + info.offset;
+    if (info.type == ParamStore::TYPE_UINT32) {
+        uint32_t v = (uint32_t)lroundf(value);
+        memcpy(field, &v, sizeof(v));
+    } else {
+        memcpy(field, &value, sizeof(value));
+    }
+}
+
+static bool inRange(const ParamStore::ParamInfo& info, float value) {
+    return isfinite(value) && value >= info.minValue && value <= info.maxValue;
+}
+
+ParamStore::ParamStore()
+    : _blocks(), _active(0), _source(SOURCE_DEFAULTS), _sequence(0), _revision(0), _saves(0) {
+    defaults(_blocks[0]);
+    _blocks[1] = _blocks[0];
+}
+
+void ParamStore::defaults(ParamBlock& block) {
+    block.tiltKp = Config::TILT_KP;
+    block.tiltKi = Config::TILT_KI;
+    block.tiltKd = Config::TILT_KD;
+    block.velocityKp = Config::VELOCITY_KP;
+    block.velocityKi = Config::VELOCITY_KI;
+    block.tiltAlpha = Config::TILT_ALPHA;
+    block.tiltChangeThresholdDeg = Config::TILT_CHANGE_THRESHOLD;
+    block.emergencyTiltDeg = Config::EMERGENCY_TILT_ANGLE;
+    block.tofWarnMm[SENSOR_FRONT] = Config::TOF_FRONT.warnDistanceMm;
+    block.tofWarnMm[SENSOR_REAR] = Config::TOF_REAR.warnDistanceMm;
+    for (uint8_t i = 0; i < PARAM_TOF_PROFILES; i++) {
+        block.tofBudgetUs[i] = Config::TOF_RANGING_PROFILES[i].timingBudgetUs;
+    }
+    derive(block);
+}
+
+void ParamStore::derive(ParamBlock& block) {
+    block.tiltTauS = block.tiltAlpha * Config::TILT_ALPHA_REFERENCE_DT / (1.0f - block.tiltAlpha);
+}
+
+ParamBlock& ParamStore::beginChange() {
+    uint8_t spare = _active.load(std::memory_order_relaxed) ^ 1;
+    _blocks[spare] = _blocks[spare ^ 1];
+    return _blocks[spare];
+}
+
+void ParamStore::commit() {
+    uint8_t spare = _active.load(std::memory_order_relaxed) ^ 1;
+    derive(_blocks[spare]);
+    _active.store(spare, std::memory_order_release);
+    _revision++;
+}
+
+const ParamStore::ParamInfo* ParamStore::find(uint8_t id) {
+    for (uint8_t i = 0; i < PARAM_COUNT; i++) {
+        if (REGISTRY[i].id == id) {
+            return &REGISTRY[i];
+        }
+    }
+    return nullptr;
+}
+
+bool ParamStore::set(uint8_t id, float value) {
+    const ParamInfo* info = find(id);
+    if (!info || !inRange(*info, value)) {
+        return false;
+    }
+    writeField(beginChange(), *info, value);
+    commit();
+    return true;
+}
+
+bool ParamStore::get(uint8_t id, float& value) const {
+    const ParamInfo* info = find(id);
+    if (!info) {
+        return false;
+    }
+    value = readField(active(), *info);
+    return true;
+}
+
+void ParamStore::resetToDefaults() {
+    defaults(beginChange());
+    commit();
+}
+
+bool ParamStore::readSlot(uint8_t slot, ParamBlock& block, uint32_t& sequence) const {
+    uint8_t buffer[Config::PARAM_EEPROM_SLOT_BYTES];
+    int base = Config::PARAM_EEPROM_BASE + slot * Config::PARAM_EEPROM_SLOT_BYTES;
+    for (uint16_t i = 0; i < SLOT_HEADER_BYTES; i++) {
+        buffer[i] = EEPROM.read(base + i);
+    }
+    uint8_t count = buffer[3];
+    if ((uint16_t)(buffer[0] | (buffer[1] << 8)) != SLOT_MAGIC || buffer[2] != SLOT_VERSION ||
+        SLOT_HEADER_BYTES + count * SLOT_RECORD_BYTES + 2 > Config::PARAM_EEPROM_SLOT_BYTES) {
+        return false;
+    }
+    uint16_t length = SLOT_HEADER_BYTES + count * SLOT_RECORD_BYTES;
+    for (uint16_t i = SLOT_HEADER_BYTES; i < length + 2; i++) {
+        buffer[i] = EEPROM.read(base + i);
+    }
+    if (crc16(buffer, length) != (uint16_t)(buffer[length] | (buffer[length + 1] << 8))) {
+        return false;
+    }
+
+    // Unknown ids (a newer firmware's) and out of range values are skipped
+    defaults(block);
+    for (uint8_t r = 0; r < count; r++) {
+        const uint8_t* record = &buffer[SLOT_HEADER_BYTES + r * SLOT_RECORD_BYTES];
+        const ParamInfo* info = find(record[0]);
+        float value;
+        memcpy(&value, record + 1, sizeof(value));
+        if (info && inRange(*info, value)) {
+            writeField(block, *info, value);
+        }
+    }
+    derive(block);
+    memcpy(&sequence, &buffer[4], sizeof(sequence));
+    return true;
+}
+
+COLD_CODE bool ParamStore::load() {
+    ParamBlock candidates[2];
+    uint32_t sequences[2];
+    bool valid[2];
+    for (uint8_t slot = 0; slot < 2; slot++) {
+        valid[slot] = readSlot(slot, candidates[slot], sequences[slot]);
+    }
+    if (!valid[0] && !valid[1]) {
+        return false;
+    }
+    uint8_t newest = (valid[0] && (!valid[1] || (int32_t)(sequences[0] - sequences[1]) > 0)) ? 0 : 1;
+
+    beginChange() = candidates[newest];
+    commit();
+    _sequence = sequences[newest];
+    _source = SOURCE_EEPROM;
+    return true;
+}
+
+bool ParamStore::save() {
+    uint8_t buffer[Config::PARAM_EEPROM_SLOT_BYTES];
+    uint32_t sequence = _sequence + 1;
+    buffer[0] = (uint8_t)(SLOT_MAGIC & 0xFF);
+    buffer[1] = (uint8_t)(SLOT_MAGIC >> 8);
+    buffer[2] = SLOT_VERSION;
+    buffer[3] = PARAM_COUNT;
+    memcpy(&buffer[4], &sequence, sizeof(sequence));
+    const ParamBlock& block = active();
+    for (uint8_t r = 0; r < PARAM_COUNT; r++) {
+        uint8_t* record = &buffer[SLOT_HEADER_BYTES + r * SLOT_RECORD_BYTES];
+        float value = readField(block, REGISTRY[r]);
+        record[0] = REGISTRY[r].id;
+        memcpy(record + 1, &value, sizeof(value));
+    }
+    uint16_t length = SLOT_HEADER_BYTES + PARAM_COUNT * SLOT_RECORD_BYTES;
+    uint16_t crc = crc16(buffer, length);
+    buffer[length] = (uint8_t)(crc & 0xFF);
+    buffer[length + 1] = (uint8_t)(crc >> 8);
+
+    // The slot after the newest one; the newest stays intact until this
+    // one is complete and valid
+    uint8_t slot = (uint8_t)(sequence & 1);
+    int base = Config::PARAM_EEPROM_BASE + slot * Config::PARAM_EEPROM_SLOT_BYTES;
+    for (uint16_t i = 0; i < length + 2; i++) {
+        EEPROM.update(base + i, buffer[i]);
+    }
+
+    ParamBlock check;
+    uint32_t checkSequence;
+    if (!readSlot(slot, check, checkSequence) || checkSequence != sequence) {
+        return false;
+    }
+    _sequence = sequence;
+    _saves++;
+    return true;
+}
+
+uint32_t ParamStore::getRevision() const {
+    return _revision;
+}
+
+void ParamStore::report(TelemetryWriter& telemetry) const {
+    ParamsPayload* p = telemetry.begin<ParamsPayload>(FRAME_PARAMS, micros());
+    p->source = _source;
+    p->revision = _revision;
+    p->saves = _saves;
+    p->count = PARAM_COUNT;
+    const ParamBlock& block = active();
+    for (uint8_t i = 0; i < PARAM_COUNT; i++) {
+        p->params[i].id = REGISTRY[i].id;
+        p->params[i].value = readField(block, REGISTRY[i]);
+    }
+    telemetry.commit(offsetof(ParamsPayload, params) + PARAM_COUNT * sizeof(ParamRecord));
+}
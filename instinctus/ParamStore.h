@@ -0,0 +1,152 @@
+#ifndef PARAM_STORE_H
+#define PARAM_STORE_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <ToFConfig.h>
+#include "CommandFrame.h"
+
+class TelemetryWriter;
+
+/**
+ * ParamStore.h - Runtime-Tunable Parameters with EEPROM Persistence
+ *
+ * The values that were constexpr in the Config headers and worth tuning on the
+ * robot, seeded from those Config defaults, changed over the command link
+ * (CMD_SET_PARAM) and persisted to the Teensy's emulated EEPROM.
+ *
+ * Double buffered:
+ * - Readers (the balance ISR included) use active(): one index load,
+ *   then plain field reads. No lock, no lookup.
+ * - A change copies the active block to the spare one, edits it, and
+ *   publishes it by flipping the index. The balance ISR preempts loop()
+ *   and runs to completion, so every control tick sees one whole block;
+ *   a change lands between ticks.
+ *
+ * Registry: each ParamId maps to a typed field with its range; values go
+ * over the link and into EEPROM as floats (every uint32 field here is
+ * exact in a float).
+ *
+ * EEPROM: two slots written alternately, each with a sequence number
+ * and CRC; load() takes the newest valid one. Records are (id, value)
+ * pairs, so a firmware with more or fewer parameters still loads the
+ * ones it knows and keeps defaults for the rest. Writing the emulated
+ * EEPROM erases flash, which stalls every interrupt for milliseconds:
+ * the sketch only allows save() while disarmed.
+ *
+ * Writers: loop context only.
+ *
+ * Usage:
+ *   ParamStore params;
+ *   params.load();                                  // setup
+ *   balanceIMU.setParams(&params);
+ *   float limit = params.active().emergencyTiltDeg; // any context
+ *   params.set(Commands::PARAM_TILT_ALPHA, 0.97f);  // loop
+ *   params.save();                                  // loop, disarmed
+ */
+constexpr uint8_t PARAM_TOF_SENSORS = 2;   // indexed by Telemetry::SensorId
+constexpr uint8_t PARAM_TOF_PROFILES = sizeof(Config::TOF_RANGING_PROFILES) / sizeof(Config::TOF_RANGING_PROFILES[0]);
+
+/**
+ * Every runtime-tunable value, typed, as the hot path reads it. Derived
+ * values (tiltTau) are computed when a block is committed, not per use.
+ */
+struct ParamBlock {
+    float tiltKp, tiltKi, tiltKd;
+    float velocityKp, velocityKi;
+    float tiltAlpha;
+    float tiltTauS;                // derived: alpha * ref dt / (1 - alpha)
+    float tiltChangeThresholdDeg;
+    float emergencyTiltDeg;
+    float tofWarnMm[PARAM_TOF_SENSORS];
+    uint32_t tofBudgetUs[PARAM_TOF_PROFILES];
+};
+
+class ParamStore {
+public:
+    enum ParamType : uint8_t {
+        TYPE_FLOAT,
+        TYPE_UINT32
+    };
+
+    struct ParamInfo {
+        uint8_t id;                // Commands::ParamId
+        ParamType type;
+        uint16_t offset;           // into ParamBlock
+        float minValue;
+        float maxValue;
+        bool disarmedOnly;         // controller gains
+    };
+
+    enum Source : uint8_t {
+        SOURCE_DEFAULTS,
+        SOURCE_EEPROM
+    };
+
+private:
+    ParamBlock _blocks[2];
+    std::atomic<uint8_t> _active;
+    Source _source;
+    uint32_t _sequence;            // of the newest EEPROM slot
+    uint32_t _revision;            // commits since boot
+    uint32_t _saves;
+
+    static void defaults(ParamBlock& block);
+    static void derive(ParamBlock& block);
+    ParamBlock& beginChange();
+    void commit();
+    bool readSlot(uint8_t slot, ParamBlock& block, uint32_t& sequence) const;
+
+public:
+    ParamStore();
+
+    /**
+     * The block in effect. Any context; take the reference once per tick.
+     */
+    const ParamBlock& active() const {
+        return _blocks[_active.load(std::memory_order_acquire)];
+    }
+
+    /**
+     * Registry entry for a parameter
+     * @return nullptr for an unknown id
+     */
+    static const ParamInfo* find(uint8_t id);
+
+    /**
+     * Change one parameter; it is in effect from the next control tick
+     * @return false for an unknown id or a value outside its range
+     */
+    bool set(uint8_t id, float value);
+
+    bool get(uint8_t id, float& value) const;
+
+    /**
+     * Back to the Config defaults (EEPROM untouched until save())
+     */
+    void resetToDefaults();
+
+    /**
+     * Replace the active block with the newest valid EEPROM slot. Setup.
+     * @return false if neither slot is valid (defaults stay in effect)
+     */
+    bool load();
+
+    /**
+     * Write the active block to the older EEPROM slot. Blocks, with
+     * interrupts stalled by flash erases: disarmed only.
+     */
+    bool save();
+
+    /**
+     * Incremented by every change, so loop-side users can notice one
+     */
+    uint32_t getRevision() const;
+
+    /**
+     * Every parameter as FRAME_PARAMS
+     */
+    void report(TelemetryWriter& telemetry) const;
+};
+
+#endif // PARAM_STORE_H
@@ -0,0 +1,77 @@
+/**
+ * PidController.cpp - Discrete PID with Measured dt Implementation
+ *
+ * The integral is stored as ki * sum(error * dt), so changing ki at run
+ * time would not rescale history. setGains() therefore resets the
+ * controller with the new gains; BalanceMotorController only allows it
+ * while disarmed, and arm() starts from a fresh state anyway.
+ */
+
+#include "PidController.h"
+#include "MemoryPlacement.h"
+
+static float clampf(float value, float lo, float hi) {
+    return value < lo ? lo : (value > hi ? hi : value);
+}
+
+PidController::PidController(const PidGains& gains)
+    : _gains(gains), _integral(0), _derivative(0), _lastMeasurement(0),
+      _primed(false), _saturated(false) {
+}
+
+void PidController::reset() {
+    _integral = 0;
+    _derivative = 0;
+    _lastMeasurement = 0;
+    _primed = false;
+    _saturated = false;
+}
+
+HOT_CODE float PidController::update(float setpoint, float measurement, float dt) {
+    float error = setpoint - measurement;
+
+    // Derivative on measurement, first-order low-passed
+    if (_primed) {
+        float rate = (measurement - _lastMeasurement) / dt;
+        float alpha = (_gains.derivativeTau > 0.0f) ? dt / (_gains.derivativeTau + dt) : 1.0f;
+        _derivative += alpha * (rate - _derivative);
+    } else {
+        _derivative = 0;
+        _primed = true;
+    }
+    _lastMeasurement = measurement;
+
+    float proportional = _gains.kp * error;
+    float derivative = -_gains.kd * _derivative;
+    float candidate = _integral + _gains.ki * error * dt;
+    float unclamped = proportional + candidate + derivative;
+
+    // Integrate only if that doesn't push further into saturation
+    bool high = unclamped > _gains.outputMax;
+    bool low = unclamped < _gains.outputMin;
+    if ((!high || error < 0.0f) && (!low || error > 0.0f)) {
+        _integral = clampf(candidate, _gains.outputMin, _gains.outputMax);
+    }
+
+    float output = proportional + _integral + derivative;
+    float clamped = clampf(output, _gains.outputMin, _gains.outputMax);
+    _saturated = (clamped != output);
+    return clamped;
+}
+
+bool PidController::isSaturated() const {
+    return _saturated;
+}
+
+float PidController::getIntegral() const {
+    return _integral;
+}
+
+void PidController::setGains(const PidGains& gains) {
+    _gains = gains;
+    reset();
+}
+
+const PidGains& PidController::getGains() const {
+    return _gains;
+}
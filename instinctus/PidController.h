@@ -0,0 +1,79 @@
+#ifndef PID_CONTROLLER_H
+#define PID_CONTROLLER_H
+
+#include <Arduino.h>
+
+/**
+ * PidController.h - Discrete PID with Measured dt
+ *
+ * One loop of the cascaded balance controller. Everything is float and
+ * the caller supplies the measured dt of each step, so the loop behaves
+ * the same whatever rate or jitter it actually runs at.
+ *
+ * - Derivative on measurement: the D term differentiates the measurement,
+ *   not the error, so a setpoint step (e.g. the outer loop moving the tilt
+ *   target) produces no derivative kick. It is low-pass filtered with
+ *   derivativeTau; 0 disables the filter.
+ * - Anti-windup by conditional integration: the integrator only moves if
+ *   the output is unsaturated or the error would pull it back out of
+ *   saturation. The integral term is also clamped to the output range.
+ * - The first update() after reset() has no derivative (nothing to
+ *   difference against).
+ *
+ * Usage:
+ *   PidGains gains = { 0.5f, 1.0f, 0.02f, -8.0f, 8.0f, 0.005f };
+ *   PidController pid(gains);
+ *   float out = pid.update(setpoint, measurement, dt);
+ */
+struct PidGains {
+    float kp;
+    float ki;                  // per second
+    float kd;                  // seconds
+    float outputMin;
+    float outputMax;
+    float derivativeTau;       // derivative low-pass time constant (s), 0 = off
+};
+
+class PidController {
+private:
+    PidGains _gains;
+    float _integral;           // integral term, already scaled by ki
+    float _derivative;         // filtered d(measurement)/dt
+    float _lastMeasurement;
+    bool _primed;
+    bool _saturated;
+
+public:
+    explicit PidController(const PidGains& gains);
+
+    /**
+     * Clear the integrator and derivative history
+     */
+    void reset();
+
+    /**
+     * One control step
+     * @param setpoint - target value
+     * @param measurement - measured value
+     * @param dt - seconds since the previous step, must be > 0
+     * @return output clamped to [outputMin, outputMax]
+     */
+    float update(float setpoint, float measurement, float dt);
+
+    /**
+     * True if the last output was clamped
+     */
+    bool isSaturated() const;
+
+    float getIntegral() const;
+
+    /**
+     * Replace the gains and reset() (the integral was accumulated with
+     * the old ki). The caller makes sure no update() runs concurrently,
+     * i.e. changes gains only while its loop is not running.
+     */
+    void setGains(const PidGains& gains);
+    const PidGains& getGains() const;
+};
+
+#endif // PID_CONTROLLER_H
@@ -0,0 +1,234 @@
+/**
+ * PipelineBenchmark.cpp - Timing Budgets for the Balance Tick's Stages Implementation
+ *
+ * Each stage runs from a small table of varied IMU samples so the
+ * compiler can neither fold the work away nor hoist it out of the loop;
+ * results go to volatile sinks. Percentiles are nearest-rank over the
+ * sorted per-call times.
+ */
+
+#include "PipelineBenchmark.h"
+
+#ifdef INSTINCTUS_BENCH
+
+#include "ComplementaryTiltEstimator.h"
+#include "TelemetryWriter.h"
+#include "ODriveAxis.h"
+#include "MemoryPlacement.h"
+#include <BoardConfig.h>
+#include <IMUConfig.h>
+#include <algorithm>
+#include <stdio.h>
+
+using namespace Telemetry;
+
+namespace PipelineBenchmark {
+
+static constexpr uint8_t INPUT_SAMPLES = 64;      // power of two
+static constexpr uint32_t SAMPLE_PERIOD_US = 1000;
+
+static IMUSample inputs[INPUT_SAMPLES];
+BULK_DATA static uint32_t benchSamples[Config::BENCH_ITERATIONS];
+
+static volatile float floatSink;
+static volatile uint32_t wordSink;
+
+// Slow balancing sway with some noise, in the robot frame
+static void fillInputs() {
+    uint32_t noise = 12345;
+    for (uint8_t i = 0; i < INPUT_SAMPLES; i++) {
+        noise = noise * 1664525UL + 1013904223UL;
+        float jitter = ((noise >> 16) & 0xFF) * (0.05f / 255.0f);
+        float lean = 0.07f * sinf(i * (2.0f * (float)PI / INPUT_SAMPLES));
+        IMUSample& s = inputs[i];
+        s.accelX = -9.81f * sinf(lean) + jitter;
+        s.accelY = jitter;
+        s.accelZ = 9.81f * cosf(lean) - jitter;
+        s.gyroX = 0.01f * jitter;
+        s.gyroY = 0.4f * cosf(i * (2.0f * (float)PI / INPUT_SAMPLES)) + jitter;
+        s.gyroZ = -jitter;
+        s.timestampUs = i * SAMPLE_PERIOD_US;
+    }
+}
+
+class SyntheticIMU : public IMUInterface {
+private:
+    uint8_t _next = 0;
+
+public:
+    bool initialize() override { return true; }
+
+    bool readSensors(float& accelX, float& accelY, float& accelZ,
+                     float& gyroX, float& gyroY, float& gyroZ) override {
+        const IMUSample& s = inputs[_next];
+        _next = (_next + 1) & (INPUT_SAMPLES - 1);
+        accelX = s.accelX;
+        accelY = s.accelY;
+        accelZ = s.accelZ;
+        gyroX = s.gyroX;
+        gyroY = s.gyroY;
+        gyroZ = s.gyroZ;
+        return true;
+    }
+};
+
+// Accepts every frame, as a driver with an empty TX mailbox would
+class NullCAN : public CANInterface {
+public:
+    bool begin(uint32_t) override { return true; }
+
+    bool write(const CANFrame& frame) override {
+        wordSink = frame.id ^ frame.data[0];
+        return true;
+    }
+
+    void setReceiveHandler(ReceiveHandler, void*) override {}
+
+    void getStats(CANBusStats& stats) override {
+        memset(&stats, 0, sizeof(stats));
+    }
+};
+
+// Port that always has room, so every frame is encoded and written
+class NullPort : public Print {
+public:
+    size_t write(uint8_t b) override {
+        wordSink = b;
+        return 1;
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override {
+        wordSink = buffer[size - 1];
+        return size;
+    }
+
+    int availableForWrite() override { return MAX_FRAME_SIZE; }
+};
+
+struct StageResult {
+    uint32_t minCycles;
+    uint32_t p50Cycles;
+    uint32_t p99Cycles;
+    uint32_t maxCycles;
+};
+
+// Cost of the two counter reads around an empty body
+static uint32_t measureOverhead(CycleCounter counter) {
+    uint32_t best = UINT32_MAX;
+    for (uint16_t i = 0; i < 256; i++) {
+        uint32_t start = counter();
+        uint32_t elapsed = counter() - start;
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+template <typename Body>
+static StageResult timeStage(CycleCounter counter, uint32_t overhead, Body body) {
+    for (uint16_t i = 0; i < INPUT_SAMPLES; i++) {
+        body(i);
+    }
+    for (uint16_t i = 0; i < Config::BENCH_ITERATIONS; i++) {
+        uint32_t start = counter();
+        body(i);
+        uint32_t elapsed = counter() - start;
+        benchSamples[i] = elapsed > overhead ? elapsed - overhead : 0;
+    }
+
+    std::sort(benchSamples, benchSamples + Config::BENCH_ITERATIONS);
+    const uint32_t n = Config::BENCH_ITERATIONS;
+    StageResult result;
+    result.minCycles = benchSamples[0];
+    result.p50Cycles = benchSamples[(n * 50 + 99) / 100 - 1];
+    result.p99Cycles = benchSamples[(n * 99 + 99) / 100 - 1];
+    result.maxCycles = benchSamples[n - 1];
+    return result;
+}
+
+static bool reportStage(Print& out, const Options& options, const char* stage,
+                        const StageResult& result, uint32_t budget) {
+    uint32_t gated = options.gate == GATE_MAX ? result.maxCycles : result.p99Cycles;
+    bool pass = gated <= budget;
+    char line[256];
+    int length = snprintf(line, sizeof(line),
+        "{\"bench\":\"pipeline\",\"platform\":\"%s\",\"stage\":\"%s\",\"unit\":\"cycles\","
+        "\"hz\":%lu,\"n\":%u,\"min\":%lu,\"p50\":%lu,\"p99\":%lu,\"max\":%lu,\"budget\":%lu,"
+        "\"gate\":\"%s\",\"pass\":%s}\n",
+        options.platform, stage, (unsigned long)Config::BENCH_REFERENCE_HZ,
+        (unsigned)Config::BENCH_ITERATIONS,
+        (unsigned long)result.minCycles, (unsigned long)result.p50Cycles,
+        (unsigned long)result.p99Cycles, (unsigned long)result.maxCycles, (unsigned long)budget,
+        options.gate == GATE_MAX ? "max" : "p99", pass ? "true" : "false");
+    out.write(reinterpret_cast<const uint8_t*>(line), length);
+    return pass;
+}
+
+bool run(const Options& options, Print& out) {
+    fillInputs();
+    CycleCounter counter = options.counter;
+    uint32_t overhead = measureOverhead(counter);
+    uint8_t failed = 0;
+
+    SyntheticIMU syntheticImu;
+    IMUInterface* imu = options.imu ? options.imu : &syntheticImu;
+    StageResult read = timeStage(counter, overhead, [&](uint16_t) {
+        float ax, ay, az, gx, gy, gz;
+        if (imu->readSensors(ax, ay, az, gx, gy, gz)) {
+            floatSink = ax + gz;
+        }
+    });
+    failed += !reportStage(out, options, "readSensors", read, Config::BENCH_BUDGET_READ_SENSORS_CYCLES);
+
+    StageResult transform = timeStage(counter, overhead, [&](uint16_t i) {
+        const IMUSample& in = inputs[i & (INPUT_SAMPLES - 1)];
+        IMUSample robot;
+        applyTransform<Config::BALANCE_IMU_TRANSFORM>(in.accelX, in.accelY, in.accelZ,
+                                                      robot.accelX, robot.accelY, robot.accelZ);
+        applyTransform<Config::BALANCE_IMU_TRANSFORM>(in.gyroX, in.gyroY, in.gyroZ,
+                                                      robot.gyroX, robot.gyroY, robot.gyroZ);
+        floatSink = robot.accelX + robot.gyroZ;
+    });
+    failed += !reportStage(out, options, "transform", transform, Config::BENCH_BUDGET_TRANSFORM_CYCLES);
+
+    ComplementaryTiltEstimator filter;
+    StageResult tilt = timeStage(counter, overhead, [&](uint16_t i) {
+        floatSink = filter.update(inputs[i & (INPUT_SAMPLES - 1)], SAMPLE_PERIOD_US * 1e-6f);
+    });
+    failed += !reportStage(out, options, "tiltFilter", tilt, Config::BENCH_BUDGET_TILT_FILTER_CYCLES);
+
+    NullPort port;
+    TelemetryWriter telemetry(&port);
+    StageResult encode = timeStage(counter, overhead, [&](uint16_t i) {
+        const IMUSample& s = inputs[i & (INPUT_SAMPLES - 1)];
+        BalanceImuPayload* p = telemetry.begin<BalanceImuPayload>(FRAME_BALANCE_IMU, s.timestampUs);
+        p->accelX = s.accelX;
+        p->accelY = s.accelY;
+        p->accelZ = s.accelZ;
+        p->gyroX = s.gyroX;
+        p->gyroY = s.gyroY;
+        p->gyroZ = s.gyroZ;
+        p->tiltAngle = floatSink;
+        telemetry.commit();
+    });
+    failed += !reportStage(out, options, "telemetry", encode, Config::BENCH_BUDGET_TELEMETRY_CYCLES);
+
+    NullCAN can;
+    ODriveAxis axis(&can, 0);
+    StageResult canEncode = timeStage(counter, overhead, [&](uint16_t i) {
+        axis.setInputVelocity(inputs[i & (INPUT_SAMPLES - 1)].gyroY);
+    });
+    failed += !reportStage(out, options, "canEncode", canEncode, Config::BENCH_BUDGET_CAN_ENCODE_CYCLES);
+
+    char line[128];
+    int length = snprintf(line, sizeof(line),
+        "{\"bench\":\"pipeline\",\"platform\":\"%s\",\"result\":\"%s\",\"failed\":%u}\n",
+        options.platform, failed ? "fail" : "pass", (unsigned)failed);
+    out.write(reinterpret_cast<const uint8_t*>(line), length);
+    return failed == 0;
+}
+
+} // namespace PipelineBenchmark
+
+#endif // INSTINCTUS_BENCH
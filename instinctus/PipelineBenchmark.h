@@ -0,0 +1,80 @@
+#ifndef PIPELINE_BENCHMARK_H
+#define PIPELINE_BENCHMARK_H
+
+#include <Arduino.h>
+#include "IMUInterface.h"
+
+/**
+ * PipelineBenchmark.h - Timing Budgets for the Balance Tick's Stages
+ *
+ * Times each stage of the 1 kHz pipeline on its own, over
+ * Config::BENCH_ITERATIONS calls, and checks it against its budget in
+ * BoardConfig.h:
+ *
+ *   readSensors  IMUInterface::readSensors (the sketch's IMU, or a
+ *                synthetic one)
+ *   transform    applyTransform<BALANCE_IMU_TRANSFORM>, accel and gyro
+ *   tiltFilter   ComplementaryTiltEstimator::update
+ *   telemetry    one BalanceImuPayload frame: encode, CRC, write to a
+ *                null port
+ *   canEncode    ODriveAxis::setInputVelocity into a null CAN driver
+ *
+ * The same code runs on the Teensy (sketch built with -DINSTINCTUS_BENCH,
+ * DWT cycle counter) and on a desktop (host/pipeline_benchmark.cpp, wall
+ * clock scaled to cycles at Config::BENCH_REFERENCE_HZ). The cost of
+ * reading the counter is measured first and subtracted. One untimed pass
+ * warms caches and branch predictors.
+ *
+ * Gate: on the target nothing else runs, so every call must meet the
+ * budget (max). On a desktop the scheduler adds outliers; p99 is checked
+ * instead, and host numbers only catch gross regressions.
+ *
+ * Output, one JSON object per line:
+ *   {"bench":"pipeline","platform":"teensy41","stage":"tiltFilter","unit":"cycles",
+ *    "hz":600000000,"n":4096,"min":..,"p50":..,"p99":..,"max":..,"budget":400,
+ *    "gate":"max","pass":true}
+ *   ... one per stage, then
+ *   {"bench":"pipeline","platform":"teensy41","result":"pass","failed":0}
+ *
+ * Compiled only with INSTINCTUS_BENCH defined (like Profiler.h's
+ * INSTINCTUS_PROFILE): the sample buffer costs nothing in robot builds.
+ *
+ * Usage:
+ *   PipelineBenchmark::Options options = { &imuHardware, readCycles,
+ *                                          PipelineBenchmark::GATE_MAX, "teensy41" };
+ *   bool ok = PipelineBenchmark::run(options, Serial);
+ */
+namespace PipelineBenchmark {
+
+/**
+ * Free-running cycle count at Config::BENCH_REFERENCE_HZ, wrapping
+ */
+typedef uint32_t (*CycleCounter)();
+
+enum Gate : uint8_t {
+    GATE_MAX,                      // every call within budget
+    GATE_P99                       // 99 % of calls within budget
+};
+
+struct Options {
+    IMUInterface* imu;             // readSensors stage, nullptr = synthetic
+    CycleCounter counter;
+    Gate gate;
+    const char* platform;          // "platform" field of the output
+};
+
+#ifdef INSTINCTUS_BENCH
+
+/**
+ * Run every stage and write the results as JSON lines
+ * @param options - cycle source, gate and IMU
+ * @param out - where the lines go (e.g. Serial)
+ * @return true if every stage met its budget
+ */
+bool run(const Options& options, Print& out);
+
+#endif // INSTINCTUS_BENCH
+
+} // namespace PipelineBenchmark
+
+#endif // PIPELINE_BENCHMARK_H
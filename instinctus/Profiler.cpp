@@ -0,0 +1,85 @@
+/**
+ * Profiler.cpp - Cycle-Accurate Hot-Path Probes Implementation
+ *
+ * The histogram bucket is found with one CLZ instead of a divide or a
+ * loop, so record() stays cheap enough for the balance ISR.
+ */
+
+#include "Profiler.h"
+#include "MemoryPlacement.h"
+
+#ifdef INSTINCTUS_PROFILE
+
+#include "TelemetryWriter.h"
+
+namespace Profiler {
+
+static const char* const PROBE_NAMES[PROBE_COUNT] = {
+    "balance", "control", "tof", "bridge", "tlmCommit"
+};
+
+static ProbeStats probes[PROBE_COUNT];
+
+static void clearProbe(ProbeStats& p) {
+    memset(&p, 0, sizeof(p));
+    p.minCycles = UINT32_MAX;
+}
+
+HOT_CODE static uint8_t bucketFor(uint32_t cycles) {
+    if (cycles < (1UL << HIST_FIRST_SHIFT)) {
+        return 0;
+    }
+    uint8_t log2 = 31 - __builtin_clz(cycles);
+    uint8_t bucket = log2 - HIST_FIRST_SHIFT + 1;
+    return (bucket < HIST_BUCKETS) ? bucket : HIST_BUCKETS - 1;
+}
+
+HOT_CODE void record(ProbeId id, uint32_t cycles) {
+    ProbeStats& p = probes[id];
+    if (p.count == 0) {
+        p.minCycles = cycles;
+    }
+    p.count++;
+    p.totalCycles += cycles;
+    if (cycles < p.minCycles) {
+        p.minCycles = cycles;
+    }
+    if (cycles > p.maxCycles) {
+        p.maxCycles = cycles;
+    }
+    uint16_t& bin = p.histogram[bucketFor(cycles)];
+    if (bin != UINT16_MAX) {
+        bin++;
+    }
+}
+
+void report(TelemetryWriter& telemetry) {
+    for (uint8_t i = 0; i < PROBE_COUNT; i++) {
+        ProbeStats snapshot;
+        noInterrupts();
+        snapshot = probes[i];
+        clearProbe(probes[i]);
+        interrupts();
+
+        if (snapshot.count == 0) {
+            continue;
+        }
+
+        Telemetry::ProfilePayload* f =
+            telemetry.begin<Telemetry::ProfilePayload>(Telemetry::FRAME_PROFILE, micros());
+        f->cpuHz = F_CPU_ACTUAL;
+        f->probe = i;
+        memset(f->name, 0, sizeof(f->name));
+        strncpy(f->name, PROBE_NAMES[i], sizeof(f->name));
+        f->count = snapshot.count;
+        f->minCycles = snapshot.minCycles;
+        f->maxCycles = snapshot.maxCycles;
+        f->meanCycles = (uint32_t)(snapshot.totalCycles / snapshot.count);
+        memcpy(f->histogram, snapshot.histogram, sizeof(f->histogram));
+        telemetry.commit();
+    }
+}
+
+} // namespace Profiler
+
+#endif // INSTINCTUS_PROFILE
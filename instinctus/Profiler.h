@@ -0,0 +1,100 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+#include "TelemetryFrame.h"
+
+class TelemetryWriter;
+
+/**
+ * Profiler.h - Cycle-Accurate Hot-Path Probes (DWT CYCCNT)
+ *
+ * Scoped probes time a block with the Cortex-M7 cycle counter and fold the
+ * result into a static per-probe table: count, min, max, total (for the
+ * mean) and a log2 histogram. Profiler::report() sends one FRAME_PROFILE
+ * per probe that ran and starts a fresh window.
+ *
+ * Compile-time switch:
+ * - Define INSTINCTUS_PROFILE (e.g. -DINSTINCTUS_PROFILE in the build
+ *   flags) to enable. Without it, PROFILE_SCOPE expands to nothing, the
+ *   table does not exist and report() is an empty inline: zero cost.
+ *
+ * Histogram buckets (cycles, 600 MHz shown for scale):
+ *   0: < 256 (0.43 us), k: [2^(7+k), 2^(8+k)), last: >= 2^18 (437 us)
+ *
+ * Rules:
+ * - Each probe must be entered from a single context (balance ISR or
+ *   loop()). Recording is not atomic across contexts; report() snapshots
+ *   each probe with interrupts off so ISR-side probes are read whole.
+ * - A probe costs two CYCCNT reads plus a few compares (~20 cycles).
+ *
+ * Usage:
+ *   void tofTask() {
+ *       PROFILE_SCOPE(Profiler::PROBE_TOF_UPDATE);
+ *       frontToF.update();
+ *   }
+ *   Profiler::report(telemetry);   // from a slow loop slot
+ */
+namespace Profiler {
+
+enum ProbeId : uint8_t {
+    PROBE_BALANCE_UPDATE,     // BalanceIMU::updateBatch (balance ISR)
+    PROBE_BALANCE_CONTROL,    // BalanceMotorController::update (balance ISR)
+    PROBE_TOF_UPDATE,         // both ToFSensor::update calls
+    PROBE_BRIDGE_SERVICE,     // JetsonBridge::service
+    PROBE_TELEMETRY_COMMIT,   // TelemetryWriter::commit (CRC + link write)
+    PROBE_COUNT
+};
+
+constexpr uint8_t HIST_BUCKETS = Telemetry::PROFILE_HIST_BUCKETS;
+constexpr uint8_t HIST_FIRST_SHIFT = 8;
+
+#ifdef INSTINCTUS_PROFILE
+
+struct ProbeStats {
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint64_t totalCycles;
+    uint16_t histogram[HIST_BUCKETS];   // saturating
+};
+
+/**
+ * Fold one measurement into a probe. Called by ProfileScope.
+ */
+void record(ProbeId id, uint32_t cycles);
+
+/**
+ * Send one FRAME_PROFILE per probe that ran since the last report,
+ * then clear the table. Loop context only.
+ */
+void report(TelemetryWriter& telemetry);
+
+class ProfileScope {
+private:
+    ProbeId _id;
+    uint32_t _start;
+
+public:
+    explicit ProfileScope(ProbeId id) : _id(id), _start(ARM_DWT_CYCCNT) {}
+    ~ProfileScope() { record(_id, ARM_DWT_CYCCNT - _start); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(id) Profiler::ProfileScope PROFILE_CONCAT(_profileScope, __LINE__)(id)
+
+#else
+
+inline void report(TelemetryWriter&) {}
+
+#define PROFILE_SCOPE(id) do {} while (0)
+
+#endif // INSTINCTUS_PROFILE
+
+} // namespace Profiler
+
+#endif // PROFILER_H
@@ -0,0 +1,64 @@
+/**
+ * RtWatchdog.cpp - i.MX RT1062 RTWDOG (WDOG3) Driver Implementation
+ *
+ * Reconfiguration follows the reference manual's sequence: write the
+ * unlock key to CNT, wait for CS.ULK, then write TOVAL, WIN and CS (CS
+ * last) within the 255 bus clock unlock window, wait for CS.RCS.
+ * Interrupts are off throughout so nothing stretches that window. With
+ * CMD32EN set, the unlock and refresh keys are single 32-bit writes.
+ */
+
+#include "RtWatchdog.h"
+#include "MemoryPlacement.h"
+
+static constexpr uint32_t UNLOCK_KEY = 0xD928C520;
+static constexpr uint32_t REFRESH_KEY = 0xB480A602;
+static constexpr uint32_t LPO_HZ = 32000;
+static constexpr uint32_t SRSR_WDOG3_RST_B = 1UL << 7;
+
+static constexpr uint32_t CS_EN = 1UL << 7;
+static constexpr uint32_t CS_UPDATE = 1UL << 5;
+static constexpr uint32_t CS_CLK_LPO = 1UL << 8;
+static constexpr uint32_t CS_RCS = 1UL << 10;
+static constexpr uint32_t CS_ULK = 1UL << 11;
+static constexpr uint32_t CS_CMD32EN = 1UL << 13;
+
+RtWatchdog::RtWatchdog()
+    : _running(false) {
+}
+
+COLD_CODE bool RtWatchdog::begin(uint16_t timeoutMs) {
+    uint32_t ticks = (uint32_t)timeoutMs * (LPO_HZ / 1000);
+    if (ticks == 0 || ticks > 0xFFFF) {
+        return false;
+    }
+
+    __disable_irq();
+    RTWDOG_CNT = UNLOCK_KEY;
+    while (!(RTWDOG_CS & CS_ULK)) {
+    }
+    RTWDOG_TOVAL = ticks;
+    RTWDOG_WIN = 0;
+    RTWDOG_CS = CS_CMD32EN | CS_CLK_LPO | CS_UPDATE | CS_EN;
+    while (!(RTWDOG_CS & CS_RCS)) {
+    }
+    __enable_irq();
+
+    _running = true;
+    feed();
+    return true;
+}
+
+void RtWatchdog::feed() {
+    if (_running) {
+        RTWDOG_CNT = REFRESH_KEY;
+    }
+}
+
+bool RtWatchdog::isRunning() const {
+    return _running;
+}
+
+bool RtWatchdog::causedLastReset() {
+    return (SRC_SRSR & SRSR_WDOG3_RST_B) != 0;
+}
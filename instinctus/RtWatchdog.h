@@ -0,0 +1,54 @@
+#ifndef RT_WATCHDOG_H
+#define RT_WATCHDOG_H
+
+#include <Arduino.h>
+
+/**
+ * RtWatchdog.h - i.MX RT1062 RTWDOG (WDOG3) Driver
+ *
+ * A hardware watchdog that resets the MCU unless feed() is called within
+ * the timeout. Counted on the 32 kHz low-power oscillator, so it keeps
+ * running whatever the core clock or a stuck interrupt does; timeouts up
+ * to 2047 ms without the prescaler.
+ *
+ * Once started the watchdog cannot be stopped short of a reset. The
+ * configuration stays unlocked (UPDATE) so begin() may be called again
+ * to change the timeout.
+ *
+ * Who decides to feed is up to the caller (HealthMonitor). feed() is one
+ * register write and safe from any context.
+ *
+ * Usage:
+ *   RtWatchdog watchdog;
+ *   bool bitten = RtWatchdog::causedLastReset();   // before begin()
+ *   watchdog.begin(1000);
+ *   watchdog.feed();                               // at least every second
+ */
+class RtWatchdog {
+private:
+    bool _running;
+
+public:
+    RtWatchdog();
+
+    /**
+     * Start (or reconfigure) the watchdog
+     * @param timeoutMs - 1 .. 2047
+     * @return false if the timeout is out of range
+     */
+    bool begin(uint16_t timeoutMs);
+
+    /**
+     * Restart the timeout. No-op before begin().
+     */
+    void feed();
+
+    bool isRunning() const;
+
+    /**
+     * True if the last MCU reset came from this watchdog (SRC_SRSR)
+     */
+    static bool causedLastReset();
+};
+
+#endif // RT_WATCHDOG_H
@@ -0,0 +1,158 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+/**
+ * SpscRing.h - Lock-Free Single-Producer / Single-Consumer Ring Buffer
+ *
+ * Fixed-capacity queue for handing data from the control ISR (producer) to
+ * loop() (consumer) without ever blocking the producer. Replaces the
+ * GigaEventQueue / EventBroadcaster::sendToM7 path, which does not exist
+ * on the single-core Teensy.
+ *
+ * Full-Queue Policies:
+ * - DROP_NEWEST: push() fails and the new element is discarded. History
+ *   stays in order; use for events where the oldest entry matters.
+ * - OVERWRITE_OLDEST: push() always succeeds and evicts the oldest element.
+ *   Use for telemetry where only the freshest data is worth sending.
+ * Both policies count what they throw away, so backpressure is visible.
+ *
+ * Concurrency:
+ * - Exactly one producer context and one consumer context per ring.
+ * - head is written only by the producer. tail is advanced by the consumer,
+ *   and also by the producer in OVERWRITE_OLDEST mode; both sides use a
+ *   compare-and-swap (LDREX/STREX on the M7), so a pop that races with an
+ *   eviction retries instead of returning a torn element.
+ * - head and tail sit on separate 32-byte cache lines (the M7 line size).
+ *
+ * Sizing:
+ * - Capacity must be a power of two; indices are free-running uint32_t
+ *   and wrap naturally.
+ *
+ * Usage:
+ *   SpscRing<ControlEvent, 32> events;                          // drop newest
+ *   SpscRing<Sample, 16, RingPolicy::OVERWRITE_OLDEST> latest;  // overwrite
+ *   events.push(e);            // ISR
+ *   while (events.pop(e)) {}   // loop()
+ */
+
+enum class RingPolicy : uint8_t {
+    DROP_NEWEST,
+    OVERWRITE_OLDEST
+};
+
+template <typename T, size_t Capacity, RingPolicy Policy = RingPolicy::DROP_NEWEST>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+private:
+    static constexpr uint32_t MASK = Capacity - 1;
+    static constexpr size_t CACHE_LINE = 32;
+
+    alignas(CACHE_LINE) std::atomic<uint32_t> _head;   // next slot to write
+    alignas(CACHE_LINE) std::atomic<uint32_t> _tail;   // next slot to read
+    alignas(CACHE_LINE) std::atomic<uint32_t> _dropped;
+    std::atomic<uint32_t> _highWater;
+    alignas(CACHE_LINE) T _slots[Capacity];
+
+public:
+    SpscRing() : _head(0), _tail(0), _dropped(0), _highWater(0), _slots() {}
+
+    /**
+     * Producer side. Never blocks.
+     * @return false only in DROP_NEWEST mode when the ring is full
+     */
+    bool push(const T& item) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        uint32_t tail = _tail.load(std::memory_order_acquire);
+
+        if (head - tail >= Capacity) {
+            _dropped.store(_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (Policy == RingPolicy::DROP_NEWEST) {
+                return false;
+            }
+            // Evict the oldest; if the consumer just took it, that's fine too
+            _tail.compare_exchange_strong(tail, tail + 1, std::memory_order_acq_rel);
+        }
+
+        _slots[head & MASK] = item;
+        _head.store(head + 1, std::memory_order_release);
+
+        uint32_t depth = head + 1 - _tail.load(std::memory_order_relaxed);
+        if (depth > _highWater.load(std::memory_order_relaxed)) {
+            _highWater.store(depth, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /**
+     * Consumer side.
+     * @return false if the ring is empty
+     */
+    bool pop(T& item) {
+        uint32_t tail = _tail.load(std::memory_order_acquire);
+        for (;;) {
+            if (tail == _head.load(std::memory_order_acquire)) {
+                return false;
+            }
+            item = _slots[tail & MASK];
+            // Fails only if the producer evicted this slot while we copied it;
+            // tail is reloaded by the failed exchange and we try again
+            if (_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+    }
+
+    /**
+     * Consumer side: copy the oldest element without removing it; pop()
+     * removes it. DROP_NEWEST only: an evicting producer could replace
+     * the element between the two calls.
+     * @return false if the ring is empty
+     */
+    bool peek(T& item) const {
+        static_assert(Policy == RingPolicy::DROP_NEWEST, "peek() needs a DROP_NEWEST ring");
+        uint32_t tail = _tail.load(std::memory_order_acquire);
+        if (tail == _head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = _slots[tail & MASK];
+        return true;
+    }
+
+    /**
+     * Elements currently queued (approximate while the producer is active)
+     */
+    uint32_t size() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    static constexpr size_t capacity() {
+        return Capacity;
+    }
+
+    /**
+     * Elements discarded because the ring was full (dropped or overwritten,
+     * depending on the policy)
+     */
+    uint32_t getDropCount() const {
+        return _dropped.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Deepest occupancy seen since construction
+     */
+    uint32_t getHighWater() const {
+        return _highWater.load(std::memory_order_relaxed);
+    }
+};
+
+#endif // SPSC_RING_H
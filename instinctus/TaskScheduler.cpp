@@ -0,0 +1,150 @@
+/**
+ * TaskScheduler.cpp - Fixed-Rate Task Scheduler Implementation
+ *
+ * The balance task is measured from inside its own ISR: entry timestamp,
+ * exit timestamp, and the distance between consecutive entries. Loop tasks
+ * are measured around each call in runPending().
+ *
+ * Implementation Notes:
+ * - Cycle counts use ARM_DWT_CYCCNT; unsigned subtraction handles wrap
+ *   (the counter wraps every ~7 s at 600 MHz, far longer than any period)
+ * - Balance stats are only written by the ISR; readers take a snapshot with
+ *   interrupts masked so the fields are consistent with each other
+ * - Loop releases are scheduled on an absolute grid (next += period) so the
+ *   average rate does not drift with execution time
+ */
+
+#include "TaskScheduler.h"
+#include "MemoryPlacement.h"
+
+TaskScheduler::TaskFn TaskScheduler::_balanceFn = nullptr;
+uint32_t TaskScheduler::_periodCycles = 0;
+uint32_t TaskScheduler::_lastReleaseCycles = 0;
+TaskStats TaskScheduler::_balanceStats = {};
+
+TaskScheduler::TaskScheduler()
+    : _tasks(), _taskCount(0) {
+}
+
+COLD_CODE bool TaskScheduler::addTask(const char* name, TaskFn fn, uint32_t periodUs) {
+    if (_taskCount >= MAX_LOOP_TASKS || !fn || periodUs == 0) {
+        return false;
+    }
+    LoopTask& task = _tasks[_taskCount++];
+    task.name = name;
+    task.fn = fn;
+    task.periodUs = periodUs;
+    task.nextReleaseUs = micros() + periodUs;
+    task.stats = {};
+    return true;
+}
+
+COLD_CODE bool TaskScheduler::begin(TaskFn balanceFn, uint16_t rateHz, uint8_t priority) {
+    if (!balanceFn || rateHz == 0) {
+        return false;
+    }
+    _balanceFn = balanceFn;
+    _periodCycles = F_CPU_ACTUAL / rateHz;
+    _lastReleaseCycles = 0;
+    _balanceStats = {};
+
+    // Re-anchor loop tasks so setup() time does not count as lateness
+    uint32_t now = micros();
+    for (uint8_t i = 0; i < _taskCount; i++) {
+        _tasks[i].nextReleaseUs = now + _tasks[i].periodUs;
+    }
+
+    _timer.priority(priority);
+    return _timer.begin(balanceIsr, 1000000.0f / rateHz);
+}
+
+HOT_CODE void TaskScheduler::balanceIsr() {
+    uint32_t start = ARM_DWT_CYCCNT;
+
+    if (_lastReleaseCycles != 0) {
+        uint32_t interval = start - _lastReleaseCycles;
+        uint32_t jitter = (interval > _periodCycles) ? interval - _periodCycles
+                                                     : _periodCycles - interval;
+        if (jitter > _balanceStats.maxJitterCycles) {
+            _balanceStats.maxJitterCycles = jitter;
+        }
+    }
+    _lastReleaseCycles = start;
+
+    _balanceFn();
+
+    uint32_t elapsed = ARM_DWT_CYCCNT - start;
+    _balanceStats.lastCycles = elapsed;
+    if (elapsed > _balanceStats.maxCycles) {
+        _balanceStats.maxCycles = elapsed;
+    }
+    if (elapsed > _periodCycles) {
+        _balanceStats.overruns++;
+    }
+    _balanceStats.runs++;
+}
+
+void TaskScheduler::runPending() {
+    for (uint8_t i = 0; i < _taskCount; i++) {
+        LoopTask& task = _tasks[i];
+        uint32_t now = micros();
+        int32_t late = (int32_t)(now - task.nextReleaseUs);
+        if (late < 0) {
+            continue;
+        }
+
+        // Serviced a full period or more late: count it and drop the
+        // missed releases instead of running the task back to back.
+        if ((uint32_t)late >= task.periodUs) {
+            task.stats.overruns++;
+            task.nextReleaseUs = now + task.periodUs;
+        } else {
+            task.nextReleaseUs += task.periodUs;
+        }
+
+        uint32_t start = ARM_DWT_CYCCNT;
+        task.fn();
+        uint32_t elapsed = ARM_DWT_CYCCNT - start;
+
+        task.stats.lastCycles = elapsed;
+        if (elapsed > task.stats.maxCycles) {
+            task.stats.maxCycles = elapsed;
+        }
+        task.stats.runs++;
+    }
+}
+
+void TaskScheduler::getBalanceStats(TaskStats& stats) const {
+    __disable_irq();
+    stats = _balanceStats;
+    __enable_irq();
+}
+
+uint8_t TaskScheduler::getTaskCount() const {
+    return _taskCount;
+}
+
+const char* TaskScheduler::getTaskName(uint8_t index) const {
+    return index < _taskCount ? _tasks[index].name : nullptr;
+}
+
+const TaskStats& TaskScheduler::getTaskStats(uint8_t index) const {
+    return _tasks[index < _taskCount ? index : 0].stats;
+}
+
+void TaskScheduler::resetStats() {
+    __disable_irq();
+    _balanceStats.overruns = 0;
+    _balanceStats.maxCycles = 0;
+    _balanceStats.maxJitterCycles = 0;
+    __enable_irq();
+
+    for (uint8_t i = 0; i < _taskCount; i++) {
+        _tasks[i].stats.overruns = 0;
+        _tasks[i].stats.maxCycles = 0;
+    }
+}
+
+uint32_t TaskScheduler::cyclesToMicros(uint32_t cycles) {
+    return cycles / (F_CPU_ACTUAL / 1000000);
+}
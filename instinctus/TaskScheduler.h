@@ -0,0 +1,114 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <Arduino.h>
+#include <IntervalTimer.h>
+
+/**
+ * TaskScheduler.h - Fixed-Rate Task Scheduler for the Teensy 4.1
+ *
+ * Replaces the legacy "do everything, then delay()" loop. One task, the
+ * balance task, is released by a PIT-backed IntervalTimer and runs inside
+ * the timer ISR at the top NVIC priority, so its period does not depend on
+ * how long anything else takes. Everything else (ToF polling, telemetry,
+ * stats reporting) lives in lower-priority slots that loop() services via
+ * runPending().
+ *
+ * Timing Model:
+ * - Balance task: hard period from the PIT. Jitter is the deviation between
+ *   successive ISR entries; an overrun is an execution longer than one period.
+ * - Loop slots: soft periods in microseconds, checked in registration order
+ *   (first registered = highest priority). An overrun is a release that was
+ *   serviced more than one full period late; missed releases are skipped,
+ *   not replayed in a burst.
+ *
+ * All execution times are measured with the Cortex-M7 DWT cycle counter,
+ * which the Teensy core enables at startup.
+ *
+ * Usage:
+ *   TaskScheduler scheduler;
+ *   scheduler.addTask("tof", tofTask, 10000);
+ *   scheduler.begin(balanceTask, 1000, 0);  // 1 kHz, NVIC priority 0
+ *   void loop() { scheduler.runPending(); }
+ */
+
+struct TaskStats {
+    uint32_t runs;          // completed executions
+    uint32_t overruns;      // executions longer than the period / late releases
+    uint32_t lastCycles;    // execution time of the most recent run
+    uint32_t maxCycles;     // worst-case execution time observed
+    uint32_t maxJitterCycles;  // worst release jitter (balance task only)
+};
+
+class TaskScheduler {
+public:
+    typedef void (*TaskFn)();
+
+    static constexpr uint8_t MAX_LOOP_TASKS = 10;
+
+private:
+    struct LoopTask {
+        const char* name;
+        TaskFn fn;
+        uint32_t periodUs;
+        uint32_t nextReleaseUs;
+        TaskStats stats;
+    };
+
+    IntervalTimer _timer;
+    LoopTask _tasks[MAX_LOOP_TASKS];
+    uint8_t _taskCount;
+
+    // Balance task state, written only from the timer ISR
+    static TaskFn _balanceFn;
+    static uint32_t _periodCycles;
+    static uint32_t _lastReleaseCycles;
+    static TaskStats _balanceStats;
+
+    static void balanceIsr();
+
+public:
+    TaskScheduler();
+
+    /**
+     * Register a loop-context task. Call before begin().
+     * @param name - short label used in stats reports
+     * @param fn - task body, must not block
+     * @param periodUs - release period in microseconds
+     * @return false if the task table is full
+     */
+    bool addTask(const char* name, TaskFn fn, uint32_t periodUs);
+
+    /**
+     * Start the balance timer.
+     * @param balanceFn - balance task body, runs in ISR context
+     * @param rateHz - balance task rate
+     * @param priority - NVIC priority for the PIT interrupt (0 = highest)
+     * @return false if no PIT channel was available
+     */
+    bool begin(TaskFn balanceFn, uint16_t rateHz, uint8_t priority);
+
+    /**
+     * Run every loop-context task whose release time has passed.
+     * Call from loop() as often as possible.
+     */
+    void runPending();
+
+    /**
+     * Copy the balance task statistics (interrupt-safe snapshot)
+     */
+    void getBalanceStats(TaskStats& stats) const;
+
+    uint8_t getTaskCount() const;
+    const char* getTaskName(uint8_t index) const;
+    const TaskStats& getTaskStats(uint8_t index) const;
+
+    /**
+     * Reset worst-case and overrun counters for all tasks
+     */
+    void resetStats();
+
+    static uint32_t cyclesToMicros(uint32_t cycles);
+};
+
+#endif // TASK_SCHEDULER_H
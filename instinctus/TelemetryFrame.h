@@ -0,0 +1,416 @@
+#ifndef TELEMETRY_FRAME_H
+#define TELEMETRY_FRAME_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * TelemetryFrame.h - Binary Telemetry Wire Format (Teensy -> Jetson)
+ *
+ * Replaces the legacy snprintf("%.3f,...") CSV strings. Every frame is a
+ * fixed header, a packed little-endian payload and a CRC:
+ *
+ *   offset  size  field
+ *   0       2     sync: 0xA5 0x5A
+ *   2       1     protocol version (TELEMETRY_VERSION)
+ *   3       1     frame type (FrameType)
+ *   4       2     payload length in bytes
+ *   6       2     sequence number (per LinkChannel, wraps; gaps = dropped frames)
+ *   8       4     timestamp, µs when the data was captured (see below)
+ *   12      n     payload (one of the *Payload structs below)
+ *   12+n    2     CRC-16/CCITT-FALSE over bytes 2 .. 12+n-1
+ *
+ * Decoder rules:
+ * - Hunt for the sync pair, read the header, reject lengths above
+ *   MAX_PAYLOAD_SIZE, then check the CRC before trusting anything
+ * - Unknown frame types with a valid CRC are skipped, not errors
+ * - A version bump means a payload layout changed; decoders should skip
+ *   frames whose version they do not know
+ * - Frames of different channels (LinkChannel, from the frame type) are
+ *   queued separately and may overtake each other; sequence numbers are
+ *   per channel, so gap detection must be too
+ *
+ * Timestamps: once TimeSync has locked, header timestamps are in the
+ * Jetson's clock (low 32 bits of its microsecond counter), so a frame's
+ * age is simply Jetson now - timestamp. Before that they are Teensy
+ * micros(); FRAME_TIME_SYNC's synced flag says which. Timestamps inside
+ * payloads are always Teensy micros().
+ *
+ * All multi-byte fields are little-endian (native on Cortex-M7 and on the
+ * Jetson), floats are IEEE-754 single precision.
+ */
+
+namespace Telemetry {
+
+constexpr uint8_t  SYNC_0 = 0xA5;
+constexpr uint8_t  SYNC_1 = 0x5A;
+constexpr uint8_t  TELEMETRY_VERSION = 10;  // 10: paged FRAME_SCHEDULER
+constexpr uint16_t MAX_PAYLOAD_SIZE = 192;
+
+enum FrameType : uint8_t {
+    FRAME_LOG            = 0x01,   // UTF-8 text, not NUL terminated
+    FRAME_BALANCE_IMU    = 0x10,
+    FRAME_TOF            = 0x11,
+    FRAME_TILT_EVENT     = 0x12,
+    FRAME_EMERGENCY_STOP = 0x13,
+    FRAME_PROXIMITY      = 0x14,
+    FRAME_MOTOR          = 0x15,
+    FRAME_BALANCE_CONTROL = 0x16,
+    FRAME_VIBRATION      = 0x17,
+    FRAME_TOF_RANGING    = 0x18,
+    FRAME_COLLISION      = 0x19,
+    FRAME_COMMAND_ACK    = 0x1A,
+    FRAME_TIME_SYNC      = 0x1B,
+    FRAME_SCHEDULER      = 0x20,
+    FRAME_IMU_HEALTH     = 0x21,
+    FRAME_LINK_HEALTH    = 0x22,
+    FRAME_PROFILE        = 0x23,
+    FRAME_CAN_BUS        = 0x24,
+    FRAME_BLACKBOX       = 0x25,
+    FRAME_BOOT           = 0x26,
+    FRAME_PARAMS         = 0x27,
+    FRAME_HEALTH         = 0x28
+};
+
+/**
+ * Logical channels of the Jetson link. Each has its own queue in
+ * TelemetryLink, so a burst of bulk data never holds up an emergency
+ * frame behind it (head-of-line blocking), and can go out on its own
+ * port.
+ * - CONTROL: events and command answers, small and urgent
+ * - TELEMETRY: periodic state streams; a late sample is a stale sample
+ * - BULK: logs, statistics and spectra; throughput, not latency
+ */
+enum LinkChannel : uint8_t {
+    CHANNEL_CONTROL   = 0,
+    CHANNEL_TELEMETRY = 1,
+    CHANNEL_BULK      = 2
+};
+
+constexpr uint8_t LINK_CHANNELS = 3;
+
+constexpr LinkChannel channelFor(uint8_t type) {
+    switch (type) {
+        case FRAME_TILT_EVENT:
+        case FRAME_EMERGENCY_STOP:
+        case FRAME_PROXIMITY:
+        case FRAME_COLLISION:
+        case FRAME_COMMAND_ACK:
+        case FRAME_TOF_RANGING:
+        case FRAME_TIME_SYNC:
+        case FRAME_HEALTH:
+            return CHANNEL_CONTROL;
+        case FRAME_BALANCE_IMU:
+        case FRAME_TOF:
+        case FRAME_MOTOR:
+        case FRAME_BALANCE_CONTROL:
+            return CHANNEL_TELEMETRY;
+        default:
+            return CHANNEL_BULK;
+    }
+}
+
+struct __attribute__((packed)) FrameHeader {
+    uint8_t  sync0;
+    uint8_t  sync1;
+    uint8_t  version;
+    uint8_t  type;
+    uint16_t length;
+    uint16_t sequence;
+    uint32_t timestampUs;
+};
+
+typedef uint16_t FrameCrc;
+
+constexpr size_t MAX_FRAME_SIZE = sizeof(FrameHeader) + MAX_PAYLOAD_SIZE + sizeof(FrameCrc);
+
+// FRAME_BALANCE_IMU: robot-frame accel (m/s²), gyro (rad/s), tilt (deg)
+struct __attribute__((packed)) BalanceImuPayload {
+    float accelX, accelY, accelZ;
+    float gyroX, gyroY, gyroZ;
+    float tiltAngle;
+};
+
+// FRAME_TOF: tracked distances in mm, negative = no reading yet,
+// 9999 = nothing tracked
+struct __attribute__((packed)) ToFPayload {
+    int16_t frontMm;
+    int16_t rearMm;
+};
+
+// FRAME_TILT_EVENT / FRAME_EMERGENCY_STOP: tilt that triggered the event (deg)
+struct __attribute__((packed)) TiltEventPayload {
+    float    angle;
+    uint16_t count;                // events merged into this one (tilt), 1 for emergencies
+};
+
+enum SensorId : uint8_t {
+    SENSOR_FRONT = 0,
+    SENSOR_REAR  = 1
+};
+
+// FRAME_PROXIMITY: tracked obstacle inside a ToF sensor's warning
+// distance, or closing on it faster than the time-to-contact limit
+struct __attribute__((packed)) ProximityPayload {
+    uint8_t sensorId;              // SensorId
+    float   distanceMm;
+    float   closingMmS;            // positive = approaching
+    float   timeToContactS;        // 999 = not closing
+    uint16_t count;                // events merged into this one
+};
+
+// FRAME_MOTOR: ODrive feedback, left axis first
+struct __attribute__((packed)) MotorAxisRecord {
+    uint8_t  nodeId;
+    uint8_t  axisState;            // ODrive AxisState, 0 = no heartbeat yet
+    uint32_t axisError;
+    float    positionRev;
+    float    velocityRevS;
+    float    iqMeasured;           // A
+    float    busVoltage;           // V
+    uint32_t txFailures;           // commands that could not be queued
+};
+
+struct __attribute__((packed)) MotorPayload {
+    MotorAxisRecord axes[2];
+};
+
+// FRAME_BALANCE_CONTROL: cascaded controller state; latency covers the
+// window since the previous frame (IMU sample to CAN setpoint queued)
+struct __attribute__((packed)) BalanceControlPayload {
+    uint8_t  state;                // BalanceMotorController::State
+    uint8_t  saturated;            // bit 0 tilt loop, bit 1 velocity loop
+    float    leanDeg;              // positive = leaning forward
+    float    leanSetpointDeg;
+    float    wheelSpeedRevS;       // mean of both encoders
+    float    wheelCommandRevS;
+    float    velocityTargetRevS;
+    uint32_t dtUs;                 // last measured control dt
+    uint32_t ticks;                // control ticks that sent setpoints
+    uint32_t setpointFailures;     // setpoint pairs not fully queued
+    uint32_t latencyLastUs;
+    uint32_t latencyMeanUs;
+    uint32_t latencyMaxUs;
+};
+
+// FRAME_VIBRATION: IMU vibration spectrum over the report window, as RMS
+// per frequency band. Accel and gyro bands combine all three axes
+// (sqrt of the summed per-axis power), so they don't depend on mounting.
+constexpr uint8_t VIBRATION_BANDS = 8;
+
+struct __attribute__((packed)) VibrationPayload {
+    uint16_t sampleRateHz;
+    uint16_t windowSamples;
+    uint16_t windows;              // FFT windows averaged into this frame
+    uint16_t windowsDiscarded;     // broken by dropped samples
+    uint16_t bandUpperHz[VIBRATION_BANDS];
+    float    accelBandRms[VIBRATION_BANDS];   // m/s²
+    float    gyroBandRms[VIBRATION_BANDS];    // rad/s
+    float    accelPeakHz;          // strongest bin of the averaged spectrum
+    float    accelPeakRms;
+    float    gyroPeakHz;
+    float    gyroPeakRms;
+};
+
+// FRAME_COLLISION: impact seen in the IMU stream (CollisionDetector)
+struct __attribute__((packed)) CollisionPayload {
+    float magnitude;               // peak over threshold, >= 1
+    float jerkMS3;
+    float angularAccelRadS2;
+};
+
+// FRAME_COMMAND_ACK: answer to a well-formed command (CommandFrame.h)
+struct __attribute__((packed)) CommandAckPayload {
+    uint8_t type;                  // Commands::CommandType
+    uint8_t sequence;              // as sent
+    uint8_t status;                // Commands::CommandStatus
+};
+
+// FRAME_TIME_SYNC: clock exchange request (answer with CMD_TIME_SYNC,
+// echoing teensyTxUs) plus the current clock model and command latency.
+// jetson ≈ teensy + offsetUs + driftPpm·1e-6·(teensy - refUs), mod 2^32.
+// Latency is Jetson send to Teensy ack, over the last latencyCount commands.
+struct __attribute__((packed)) TimeSyncReportPayload {
+    uint32_t teensyTxUs;           // t1, Teensy micros()
+    uint8_t  synced;               // header timestamps are in Jetson time
+    uint8_t  samples;              // exchanges in the fit window
+    uint32_t refUs;                // Teensy micros() the offset applies at
+    uint32_t offsetUs;             // Jetson - Teensy, modular
+    float    driftPpm;             // Jetson clock faster = positive
+    uint32_t rttMinUs;             // fastest exchange in the window
+    uint32_t rttLastUs;
+    uint32_t exchangesRejected;
+    uint8_t  latencyCount;
+    uint32_t latencyP50Us;
+    uint32_t latencyP99Us;
+    uint32_t latencyMaxUs;
+};
+
+// FRAME_TOF_RANGING: a ToF sensor's new ranging profile, sent on every
+// switch (ToFRangingPolicy)
+struct __attribute__((packed)) ToFRangingPayload {
+    uint8_t  sensorId;             // SensorId
+    uint8_t  profile;              // index into TOF_RANGING_PROFILES, 0xFF = none applied
+    uint8_t  distanceMode;         // 1 short, 2 medium, 3 long
+    uint32_t timingBudgetUs;
+    float    closingRevS;          // commanded speed towards the sensor
+    uint16_t switches;
+    uint16_t failures;
+};
+
+// FRAME_SCHEDULER: one record per task, balance task first. A report
+// spans as many frames as the task list needs; each frame carries
+// taskCount records starting at list index firstTask, out of totalTasks.
+struct __attribute__((packed)) TaskStatsRecord {
+    char     name[8];              // NUL padded
+    uint32_t runs;
+    uint32_t overruns;
+    uint32_t lastCycles;
+    uint32_t maxCycles;
+    uint32_t maxJitterCycles;
+};
+
+constexpr uint8_t SCHEDULER_HEADER_SIZE = 7;
+constexpr uint8_t MAX_TASK_RECORDS = (MAX_PAYLOAD_SIZE - SCHEDULER_HEADER_SIZE) / sizeof(TaskStatsRecord);
+
+struct __attribute__((packed)) SchedulerPayload {
+    uint32_t cpuHz;                // converts cycle counts to time
+    uint8_t  taskCount;            // records in this frame
+    uint8_t  firstTask;            // list index of tasks[0] (0 = balance)
+    uint8_t  totalTasks;           // records in the whole report
+    TaskStatsRecord tasks[MAX_TASK_RECORDS];
+};
+
+// FRAME_BOOT: startup steps (BootSequencer), sent once when all have
+// finished. Step times are relative to the start of the boot sequence;
+// setupUs is micros() at that point, i.e. core startup before setup().
+struct __attribute__((packed)) BootStepRecord {
+    char     name[8];              // NUL padded
+    uint32_t startUs;
+    uint32_t durationUs;           // including any wait on its own track
+    uint8_t  status;               // BootSequencer::StepStatus
+};
+
+constexpr uint8_t MAX_BOOT_STEPS = 10;
+
+struct __attribute__((packed)) BootPayload {
+    uint32_t setupUs;
+    uint32_t totalUs;
+    uint8_t  failures;
+    uint8_t  stepCount;
+    BootStepRecord steps[MAX_BOOT_STEPS];
+};
+
+// FRAME_PARAMS: every tunable parameter (ParamStore), after each change,
+// on CMD_GET_PARAMS and at boot
+struct __attribute__((packed)) ParamRecord {
+    uint8_t id;                    // Commands::ParamId
+    float   value;
+};
+
+constexpr uint8_t MAX_PARAM_RECORDS = 24;
+
+struct __attribute__((packed)) ParamsPayload {
+    uint8_t  source;               // ParamStore::Source at boot
+    uint32_t revision;             // changes since boot
+    uint32_t saves;                // EEPROM writes since boot
+    uint8_t  count;
+    ParamRecord params[MAX_PARAM_RECORDS];
+};
+
+// FRAME_HEALTH: loop health (HealthMonitor), on every level change and
+// with the periodic stats. Counters are totals since the monitor started.
+struct __attribute__((packed)) HealthPayload {
+    uint8_t  level;                // HealthMonitor::Level
+    uint8_t  faults;               // HealthMonitor::Fault bits, last window
+    uint8_t  safeStateFaults;      // faults that latched the safe state, 0 = not latched
+    uint8_t  watchdogReset;        // 1 if the last MCU reset was the watchdog
+    uint32_t windows;
+    uint32_t degradedWindows;
+    uint32_t deadlineMisses;       // balance overruns plus ticks that never ran
+    uint32_t imuStaleTicks;
+    uint32_t tofStaleWindows;
+    uint32_t i2cTimeouts;
+    uint32_t canTxFailures;
+    uint32_t feedsWithheld;        // windows the watchdog was not fed
+};
+
+// FRAME_IMU_HEALTH: async IMU read path counters
+struct __attribute__((packed)) ImuHealthPayload {
+    uint32_t deferredReads;
+    uint32_t failedReads;
+    uint32_t fifoResets;
+    uint32_t busContentions;
+};
+
+// FRAME_LINK_HEALTH: backpressure between the control ISR and the link
+struct __attribute__((packed)) LinkHealthPayload {
+    uint32_t eventDrops;           // deferred events refused, topic queue full
+    uint32_t eventHighWater;       // deepest topic queue occupancy
+    uint32_t imuOverwrites;        // IMU samples evicted before being sent
+    uint32_t framesSent;
+    uint32_t framesDropped;        // frames refused, link buffer full
+    uint32_t eventsCoalesced;      // events merged into a pending one
+    uint32_t commandsAccepted;
+    uint32_t commandErrors;        // malformed command packets, or lost to a full queue
+    uint32_t channelDropped[LINK_CHANNELS];     // frames refused per LinkChannel, queue full
+    uint16_t channelHighWater[LINK_CHANNELS];   // deepest queue per LinkChannel, bytes
+};
+
+// FRAME_CAN_BUS: rates over the window since the previous frame
+struct __attribute__((packed)) CANBusPayload {
+    uint32_t bitrate;
+    uint32_t windowMs;
+    uint16_t rxFramesPerS;
+    uint16_t txFramesPerS;
+    uint16_t busLoadPermille;      // worst-case (fully stuffed) bits / bitrate
+    uint32_t txDropped;            // frames refused in the window, queue full
+    uint8_t  txErrorCounter;       // TEC
+    uint8_t  rxErrorCounter;       // REC
+    uint8_t  errorState;           // CANErrorState
+    uint8_t  txQueueDepth;
+    uint8_t  txQueueHighWater;     // since boot
+};
+
+// FRAME_BLACKBOX: recorder health; maxWriteUs covers the window since
+// the previous frame
+struct __attribute__((packed)) BlackBoxPayload {
+    uint8_t  state;                // BlackBoxRecorder::State
+    uint8_t  streaming;            // 1 if RECnnnn.BBX is being written
+    uint32_t ringRecords;
+    uint32_t recordsCaptured;      // since boot
+    uint32_t streamBacklog;        // records in RAM not yet on the card
+    uint32_t snapshotsSaved;
+    uint32_t recordsDropped;       // ticks lost while a snapshot was saved
+    uint32_t streamOverruns;       // records skipped, card too slow
+    uint32_t writeErrors;
+    uint32_t maxWriteUs;           // slowest single SD write
+};
+
+// FRAME_PROFILE: one hot-path probe over the last report window
+constexpr uint8_t PROFILE_HIST_BUCKETS = 12;
+
+struct __attribute__((packed)) ProfilePayload {
+    uint32_t cpuHz;                // converts cycle counts to time
+    uint8_t  probe;                // Profiler::ProbeId
+    char     name[8];              // NUL padded
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint32_t meanCycles;
+    uint16_t histogram[PROFILE_HIST_BUCKETS];  // log2 buckets, see Profiler.h
+};
+
+static_assert(sizeof(FrameHeader) == 12, "header layout is part of the protocol");
+static_assert(sizeof(SchedulerPayload) <= MAX_PAYLOAD_SIZE, "scheduler payload too large");
+static_assert(offsetof(SchedulerPayload, tasks) == SCHEDULER_HEADER_SIZE, "scheduler header size");
+
+/**
+ * CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF, no reflection, no xorout)
+ * @param crc - running value, start with 0xFFFF
+ */
+uint16_t crc16(const uint8_t* data, size_t length, uint16_t crc = 0xFFFF);
+
+} // namespace Telemetry
+
+#endif // TELEMETRY_FRAME_H
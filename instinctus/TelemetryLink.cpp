@@ -0,0 +1,161 @@
+/**
+ * TelemetryLink.cpp - Multi-Channel Frame Multiplexer Implementation
+ *
+ * Queues are byte rings holding complete frames back to back. A frame's
+ * length is read back from its own header (payload length at offset 4),
+ * so no separate length FIFO is needed.
+ */
+
+#include "TelemetryLink.h"
+#include "MemoryPlacement.h"
+
+using namespace Telemetry;
+
+// Loop-only bulk buffers
+BULK_DATA static uint8_t controlQueue[Config::LINK_CONTROL_QUEUE_BYTES];
+BULK_DATA static uint8_t telemetryQueue[Config::LINK_TELEMETRY_QUEUE_BYTES];
+BULK_DATA static uint8_t bulkQueue[Config::LINK_BULK_QUEUE_BYTES];
+
+static_assert(Config::LINK_CONTROL_QUEUE_BYTES >= MAX_FRAME_SIZE &&
+              Config::LINK_TELEMETRY_QUEUE_BYTES >= MAX_FRAME_SIZE &&
+              Config::LINK_BULK_QUEUE_BYTES >= MAX_FRAME_SIZE,
+              "every link queue must hold at least one full frame");
+
+TelemetryLink::TelemetryLink() : _queues(), _route(), _ports() {
+    _queues[CHANNEL_CONTROL].data = controlQueue;
+    _queues[CHANNEL_CONTROL].size = sizeof(controlQueue);
+    _queues[CHANNEL_TELEMETRY].data = telemetryQueue;
+    _queues[CHANNEL_TELEMETRY].size = sizeof(telemetryQueue);
+    _queues[CHANNEL_BULK].data = bulkQueue;
+    _queues[CHANNEL_BULK].size = sizeof(bulkQueue);
+    for (uint8_t i = 0; i < MAX_PORTS; i++) {
+        _ports[i].channel = -1;
+        _ports[i].lastShared = CHANNEL_BULK;
+    }
+}
+
+bool TelemetryLink::setPort(uint8_t index, Print* out) {
+    if (index >= MAX_PORTS) {
+        return false;
+    }
+    _ports[index].out = out;
+    return true;
+}
+
+void TelemetryLink::route(LinkChannel channel, uint8_t port) {
+    if (channel < LINK_CHANNELS && port < MAX_PORTS) {
+        _route[channel] = port;
+    }
+}
+
+uint8_t TelemetryLink::portFor(uint8_t channel) const {
+    uint8_t port = _route[channel];
+    return _ports[port].out ? port : 0;
+}
+
+bool TelemetryLink::hasRoom(LinkChannel channel, size_t frameLength) const {
+    const Queue& q = _queues[channel];
+    return _ports[portFor(channel)].out && (size_t)(q.size - q.used) >= frameLength;
+}
+
+bool TelemetryLink::enqueue(LinkChannel channel, const uint8_t* frame, size_t frameLength) {
+    if (!hasRoom(channel, frameLength)) {
+        _queues[channel].dropped++;
+        return false;
+    }
+
+    Queue& q = _queues[channel];
+    uint16_t tail = (q.head + q.used) % q.size;
+    size_t first = q.size - tail;
+    if (first > frameLength) {
+        first = frameLength;
+    }
+    memcpy(q.data + tail, frame, first);
+    memcpy(q.data, frame + first, frameLength - first);
+    q.used += frameLength;
+    if (q.used > q.highWater) {
+        q.highWater = q.used;
+    }
+
+    service();
+    return true;
+}
+
+uint8_t TelemetryLink::peekByte(const Queue& q, uint16_t offset) const {
+    return q.data[(q.head + offset) % q.size];
+}
+
+bool TelemetryLink::startFrame(uint8_t portIndex) {
+    Port& port = _ports[portIndex];
+
+    int8_t next = -1;
+    if (_queues[CHANNEL_CONTROL].used && portFor(CHANNEL_CONTROL) == portIndex) {
+        next = CHANNEL_CONTROL;
+    } else {
+        // Shared channels take turns, starting after the last one served
+        uint8_t first = (port.lastShared == CHANNEL_TELEMETRY) ? CHANNEL_BULK : CHANNEL_TELEMETRY;
+        uint8_t second = (first == CHANNEL_TELEMETRY) ? CHANNEL_BULK : CHANNEL_TELEMETRY;
+        if (_queues[first].used && portFor(first) == portIndex) {
+            next = first;
+        } else if (_queues[second].used && portFor(second) == portIndex) {
+            next = second;
+        }
+        if (next >= 0) {
+            port.lastShared = next;
+        }
+    }
+    if (next < 0) {
+        return false;
+    }
+
+    const Queue& q = _queues[next];
+    uint16_t payloadLength = (uint16_t)(peekByte(q, 4) | (peekByte(q, 5) << 8));
+    port.channel = next;
+    port.remaining = sizeof(FrameHeader) + payloadLength + sizeof(FrameCrc);
+    return true;
+}
+
+void TelemetryLink::service() {
+    for (uint8_t p = 0; p < MAX_PORTS; p++) {
+        Port& port = _ports[p];
+        if (!port.out) {
+            continue;
+        }
+        while (true) {
+            // Pick the next frame only once the port can take bytes, so a
+            // control frame queued meanwhile still goes first
+            int room = port.out->availableForWrite();
+            if (room <= 0 || (port.channel < 0 && !startFrame(p))) {
+                break;
+            }
+
+            Queue& q = _queues[port.channel];
+            size_t n = port.remaining;
+            size_t contiguous = q.size - q.head;
+            if (n > contiguous) {
+                n = contiguous;
+            }
+            if (n > (size_t)room) {
+                n = room;
+            }
+            n = port.out->write(q.data + q.head, n);
+            if (n == 0) {
+                break;
+            }
+            q.head = (q.head + n) % q.size;
+            q.used -= n;
+            port.remaining -= n;
+            if (port.remaining == 0) {
+                port.channel = -1;
+            }
+        }
+    }
+}
+
+uint32_t TelemetryLink::getDropCount(LinkChannel channel) const {
+    return _queues[channel].dropped;
+}
+
+uint16_t TelemetryLink::getHighWater(LinkChannel channel) const {
+    return _queues[channel].highWater;
+}
@@ -0,0 +1,101 @@
+#ifndef TELEMETRY_LINK_H
+#define TELEMETRY_LINK_H
+
+#include <Arduino.h>
+#include <BoardConfig.h>
+#include "TelemetryFrame.h"
+
+/**
+ * TelemetryLink.h - Multi-Channel, Multi-Port Frame Multiplexer
+ *
+ * Sits between TelemetryWriter and the physical links. Finished frames are
+ * queued per LinkChannel; service() moves whole frames from the queues to
+ * the port each channel is routed to, as fast as the port accepts them.
+ *
+ * Scheduling per port:
+ * - Frames are never interleaved on a port: once started, a frame is
+ *   finished (possibly over several service() calls) before the next
+ * - Then CONTROL first, always; TELEMETRY and BULK alternate frame by
+ *   frame when both have data, so neither can starve the other
+ * - Hence a control frame waits for at most the rest of one frame on its
+ *   port, not for everything queued ahead of it
+ *
+ * Ports are Print objects: USB Serial, or a DmaUartPort for a UART with
+ * DMA TX. Routing a channel to a port that isn't set falls back to port 0.
+ *
+ * A full channel queue refuses the frame (TelemetryWriter counts it as
+ * dropped); hasRoom() lets callers keep data queued instead. One instance
+ * (queue storage is file-scope OCRAM), loop context only.
+ *
+ * Usage:
+ *   TelemetryLink link;
+ *   link.setPort(0, &Serial);
+ *   link.setPort(1, &uartPort);
+ *   link.route(Telemetry::CHANNEL_BULK, 1);
+ *   TelemetryWriter telemetry(&link);
+ *   link.service();                  // loop slot; commits also kick it
+ */
+class TelemetryLink {
+public:
+    static constexpr uint8_t MAX_PORTS = 2;
+
+private:
+    struct Queue {
+        uint8_t* data;
+        uint16_t size;
+        uint16_t head;             // next byte to send
+        uint16_t used;
+        uint16_t highWater;
+        uint32_t dropped;
+    };
+
+    struct Port {
+        Print* out;
+        int8_t channel;            // frame in progress, -1 = between frames
+        uint16_t remaining;        // bytes of it still to send
+        uint8_t lastShared;        // TELEMETRY / BULK round robin
+    };
+
+    Queue _queues[Telemetry::LINK_CHANNELS];
+    uint8_t _route[Telemetry::LINK_CHANNELS];
+    Port _ports[MAX_PORTS];
+
+    uint8_t portFor(uint8_t channel) const;
+    bool startFrame(uint8_t portIndex);
+    uint8_t peekByte(const Queue& q, uint16_t offset) const;
+
+public:
+    TelemetryLink();
+
+    /**
+     * Attach a physical link. Setup only.
+     * @return false if index is out of range
+     */
+    bool setPort(uint8_t index, Print* out);
+
+    /**
+     * Send a channel's frames on a port. Setup only.
+     */
+    void route(Telemetry::LinkChannel channel, uint8_t port);
+
+    /**
+     * True if a frame of this size fits the channel's queue now
+     */
+    bool hasRoom(Telemetry::LinkChannel channel, size_t frameLength) const;
+
+    /**
+     * Queue one complete frame and start sending it if its port is idle
+     * @return false if the queue is full (nothing is queued)
+     */
+    bool enqueue(Telemetry::LinkChannel channel, const uint8_t* frame, size_t frameLength);
+
+    /**
+     * Move queued bytes to the ports, as much as each accepts right now
+     */
+    void service();
+
+    uint32_t getDropCount(Telemetry::LinkChannel channel) const;
+    uint16_t getHighWater(Telemetry::LinkChannel channel) const;
+};
+
+#endif // TELEMETRY_LINK_H
@@ -0,0 +1,99 @@
+/**
+ * TelemetryWriter.cpp - Binary Telemetry Frame Builder Implementation
+ *
+ * Frame layout and CRC are defined in TelemetryFrame.h. The header is
+ * written when the frame is started; the length may shrink at commit()
+ * for variable-length payloads, so it is patched before the CRC runs.
+ */
+
+#include "TelemetryWriter.h"
+#include "TelemetryLink.h"
+#include "TimeSync.h"
+#include "Profiler.h"
+
+using namespace Telemetry;
+
+TelemetryWriter::TelemetryWriter(Print* out)
+    : _out(out), _link(nullptr), _clock(nullptr), _buffer(), _payloadLength(0), _sequence(),
+      _framesSent(0), _framesDropped(0) {
+}
+
+TelemetryWriter::TelemetryWriter(TelemetryLink* link)
+    : _out(nullptr), _link(link), _clock(nullptr), _buffer(), _payloadLength(0), _sequence(),
+      _framesSent(0), _framesDropped(0) {
+}
+
+void TelemetryWriter::setClock(const TimeSync* clock) {
+    _clock = clock;
+}
+
+uint8_t* TelemetryWriter::beginFrame(FrameType type, uint32_t timestampUs, uint16_t payloadLength) {
+    FrameHeader* header = reinterpret_cast<FrameHeader*>(_buffer);
+    header->sync0 = SYNC_0;
+    header->sync1 = SYNC_1;
+    header->version = TELEMETRY_VERSION;
+    header->type = type;
+    header->length = payloadLength;
+    header->sequence = _sequence[channelFor(type)];
+    header->timestampUs = _clock ? _clock->toJetson(timestampUs) : timestampUs;
+    _payloadLength = payloadLength;
+    return _buffer + sizeof(FrameHeader);
+}
+
+bool TelemetryWriter::commit(uint16_t payloadLength) {
+    PROFILE_SCOPE(Profiler::PROBE_TELEMETRY_COMMIT);
+    FrameHeader* header = reinterpret_cast<FrameHeader*>(_buffer);
+    if (payloadLength != 0 && payloadLength < _payloadLength) {
+        _payloadLength = payloadLength;
+        header->length = payloadLength;
+    }
+    LinkChannel channel = channelFor(header->type);
+    _sequence[channel]++;
+
+    size_t bodyLength = sizeof(FrameHeader) + _payloadLength;
+    uint16_t crc = crc16(_buffer + 2, bodyLength - 2);
+    _buffer[bodyLength] = (uint8_t)(crc & 0xFF);
+    _buffer[bodyLength + 1] = (uint8_t)(crc >> 8);
+
+    size_t frameLength = bodyLength + sizeof(FrameCrc);
+    if (_link) {
+        if (!_link->enqueue(channel, _buffer, frameLength)) {
+            _framesDropped++;
+            return false;
+        }
+    } else {
+        if (!_out || _out->availableForWrite() < (int)frameLength) {
+            _framesDropped++;
+            return false;
+        }
+        _out->write(_buffer, frameLength);
+    }
+    _framesSent++;
+    return true;
+}
+
+bool TelemetryWriter::hasRoom(FrameType type, uint16_t payloadLength) const {
+    size_t frameLength = sizeof(FrameHeader) + payloadLength + sizeof(FrameCrc);
+    if (_link) {
+        return _link->hasRoom(channelFor(type), frameLength);
+    }
+    return _out && _out->availableForWrite() >= (int)frameLength;
+}
+
+bool TelemetryWriter::log(const char* text) {
+    size_t length = strlen(text);
+    if (length > MAX_PAYLOAD_SIZE) {
+        length = MAX_PAYLOAD_SIZE;
+    }
+    uint8_t* payload = beginFrame(FRAME_LOG, micros(), (uint16_t)length);
+    memcpy(payload, text, length);
+    return commit();
+}
+
+uint32_t TelemetryWriter::getFramesSent() const {
+    return _framesSent;
+}
+
+uint32_t TelemetryWriter::getFramesDropped() const {
+    return _framesDropped;
+}
@@ -0,0 +1,107 @@
+#ifndef TELEMETRY_WRITER_H
+#define TELEMETRY_WRITER_H
+
+#include <Arduino.h>
+#include "TelemetryFrame.h"
+
+class TelemetryLink;
+class TimeSync;
+
+/**
+ * TelemetryWriter.h - Builds Binary Telemetry Frames in Place
+ *
+ * The caller asks for a payload pointer, fills the struct fields directly
+ * in the outbound frame buffer (no formatting, no intermediate copies), and
+ * commits. commit() stamps the length and CRC and hands the finished frame
+ * to the link in one write.
+ *
+ * Non-blocking:
+ * - If the link cannot accept the whole frame right now, the frame is
+ *   dropped and counted instead of waiting. The sequence number still
+ *   advances, so the decoder sees the gap.
+ *
+ * Two sinks:
+ * - A Print (one port): the frame goes straight to it
+ * - A TelemetryLink: the frame is queued on the LinkChannel of its type,
+ *   so bulk frames never hold up control frames
+ * Sequence numbers are kept per LinkChannel either way.
+ *
+ * With a TimeSync attached, header timestamps are converted to the
+ * Jetson's clock once it has locked (TelemetryFrame.h).
+ *
+ * Loop context only: one frame is built at a time in a single buffer.
+ *
+ * Usage:
+ *   TelemetryWriter telemetry(&Serial);   // or TelemetryWriter telemetry(&link);
+ *   Telemetry::ToFPayload* p = telemetry.begin<Telemetry::ToFPayload>(Telemetry::FRAME_TOF, micros());
+ *   p->frontMm = 120;
+ *   p->rearMm = 340;
+ *   telemetry.commit();
+ */
+class TelemetryWriter {
+private:
+    Print* _out;
+    TelemetryLink* _link;
+    const TimeSync* _clock;
+    alignas(4) uint8_t _buffer[Telemetry::MAX_FRAME_SIZE];
+    uint16_t _payloadLength;
+    uint16_t _sequence[Telemetry::LINK_CHANNELS];
+    uint32_t _framesSent;
+    uint32_t _framesDropped;
+
+    uint8_t* beginFrame(Telemetry::FrameType type, uint32_t timestampUs, uint16_t payloadLength);
+
+public:
+    /**
+     * Constructor
+     * @param out - link the frames are written to (e.g. &Serial)
+     */
+    explicit TelemetryWriter(Print* out);
+
+    /**
+     * Constructor
+     * @param link - channel multiplexer the frames are queued on
+     */
+    explicit TelemetryWriter(TelemetryLink* link);
+
+    /**
+     * Stamp headers in Jetson time from this clock model (nullptr = never)
+     */
+    void setClock(const TimeSync* clock);
+
+    /**
+     * Start a frame and return its payload area
+     * @param type - frame type
+     * @param timestampUs - capture time of the data in the payload
+     */
+    template <typename Payload>
+    Payload* begin(Telemetry::FrameType type, uint32_t timestampUs) {
+        static_assert(sizeof(Payload) <= Telemetry::MAX_PAYLOAD_SIZE, "payload too large");
+        return reinterpret_cast<Payload*>(beginFrame(type, timestampUs, sizeof(Payload)));
+    }
+
+    /**
+     * Finish the frame started by begin() and send it
+     * @param payloadLength - bytes of payload actually used, for variable
+     *                        length payloads (0 = full struct size)
+     * @return true if the frame was handed to the link, false if dropped
+     */
+    bool commit(uint16_t payloadLength = 0);
+
+    /**
+     * Check whether a frame of this type and payload size would be
+     * accepted now. Lets queued data stay queued instead of being dropped
+     * at commit().
+     */
+    bool hasRoom(Telemetry::FrameType type, uint16_t payloadLength) const;
+
+    /**
+     * Send a short text message as a FRAME_LOG frame
+     */
+    bool log(const char* text);
+
+    uint32_t getFramesSent() const;
+    uint32_t getFramesDropped() const;
+};
+
+#endif // TELEMETRY_WRITER_H
@@ -0,0 +1,51 @@
+#ifndef TILT_ESTIMATOR_H
+#define TILT_ESTIMATOR_H
+
+#include "IMUInterface.h"
+
+/**
+ * TiltEstimator.h - Pluggable Tilt Estimation Interface
+ *
+ * BalanceIMU owns sample timing (dt from acquisition timestamps, clamped)
+ * and observer notification; everything in between is a TiltEstimator.
+ * Swapping the estimator changes how accel and gyro are fused without
+ * touching the rest of the balance path.
+ *
+ * Implementations:
+ * - ComplementaryTiltEstimator: the legacy single-axis filter (default)
+ * - MahonyTiltEstimator: quaternion Mahony filter with accel gating
+ *
+ * Requirements for implementations:
+ * - Float only, no heap, no blocking: update() runs in the balance ISR at
+ *   the IMU sample rate (1 kHz+)
+ * - Tilt convention matches atan2(accelX, accelZ) in degrees: 0 = upright,
+ *   range -90 to +90 for the balance axis
+ *
+ * Usage:
+ *   MahonyTiltEstimator mahony;
+ *   balanceIMU.setEstimator(&mahony);
+ */
+class TiltEstimator {
+public:
+    /**
+     * Forget all state; the next update() starts a fresh estimate
+     */
+    virtual void reset() = 0;
+
+    /**
+     * Fuse one robot-frame sample
+     * @param sample - accel in m/s², gyro in rad/s
+     * @param deltaTime - seconds since the previous sample (already clamped)
+     * @return tilt angle in degrees
+     */
+    virtual float update(const IMUSample& sample, float deltaTime) = 0;
+
+    /**
+     * Short name for telemetry and benchmarks
+     */
+    virtual const char* getName() const = 0;
+
+    virtual ~TiltEstimator() = default;
+};
+
+#endif // TILT_ESTIMATOR_H
@@ -0,0 +1,154 @@
+/**
+ * TimeSync.cpp - Clock Model and Command Latency Implementation
+ *
+ * The fit runs once per accepted exchange over at most TIME_SYNC_WINDOW
+ * points. Times enter it relative to the newest exchange (seconds) and
+ * offsets relative to the fastest one (µs), so single precision floats
+ * keep sub-microsecond resolution.
+ */
+
+#include "TimeSync.h"
+#include "TelemetryWriter.h"
+
+using namespace Telemetry;
+
+// Drift is only fitted over at least this span; shorter, offset only
+static constexpr float MIN_DRIFT_SPAN_S = 2.0f;
+
+TimeSync::TimeSync()
+    : _samples(), _sampleCount(0), _sampleNext(0), _rejected(0), _lastRttUs(0),
+      _synced(false), _refLocalUs(0), _offsetUs(0), _driftPpm(0), _minRttUs(0),
+      _latencies(), _latencyCount(0), _latencyNext(0) {
+}
+
+bool TimeSync::addSample(const Commands::TimeSyncPayload& reply, uint32_t receivedUs) {
+    uint32_t t1 = reply.teensyTxUs;
+    uint32_t j2 = reply.jetsonRxUs;
+    uint32_t j3 = reply.jetsonTxUs;
+    int32_t rtt = (int32_t)((receivedUs - t1) - (j3 - j2));
+    if (rtt < 0 || (uint32_t)rtt > Config::TIME_SYNC_MAX_RTT_US) {
+        _rejected++;
+        return false;
+    }
+
+    // Halve the difference of the two one-way offsets, not their sum,
+    // so wrapped 32-bit values never overflow
+    uint32_t forward = j2 - t1;
+    uint32_t backward = j3 - receivedUs;
+    Sample& s = _samples[_sampleNext];
+    s.localUs = receivedUs;
+    s.offsetUs = forward + (uint32_t)((int32_t)(backward - forward) / 2);
+    s.rttUs = (uint32_t)rtt;
+    _sampleNext = (_sampleNext + 1) % Config::TIME_SYNC_WINDOW;
+    if (_sampleCount < Config::TIME_SYNC_WINDOW) {
+        _sampleCount++;
+    }
+    _lastRttUs = s.rttUs;
+
+    fit();
+    return true;
+}
+
+void TimeSync::fit() {
+    uint8_t newest = (_sampleNext + Config::TIME_SYNC_WINDOW - 1) % Config::TIME_SYNC_WINDOW;
+    uint32_t refLocal = _samples[newest].localUs;
+
+    uint8_t fastest = newest;
+    for (uint8_t i = 0; i < _sampleCount; i++) {
+        if (_samples[i].rttUs < _samples[fastest].rttUs) {
+            fastest = i;
+        }
+    }
+    uint32_t baseOffset = _samples[fastest].offsetUs;
+    uint32_t cutoff = _samples[fastest].rttUs + Config::TIME_SYNC_RTT_TOLERANCE_US;
+
+    float n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+    float xMin = 0, xMax = 0;
+    for (uint8_t i = 0; i < _sampleCount; i++) {
+        const Sample& s = _samples[i];
+        if (s.rttUs > cutoff) {
+            continue;
+        }
+        float x = (int32_t)(s.localUs - refLocal) * 1e-6f;
+        float y = (float)(int32_t)(s.offsetUs - baseOffset);
+        if (n == 0 || x < xMin) {
+            xMin = x;
+        }
+        if (n == 0 || x > xMax) {
+            xMax = x;
+        }
+        n += 1;
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+
+    float drift = _driftPpm;   // µs per s is ppm
+    float denominator = n * sxx - sx * sx;
+    if (n >= 2 && xMax - xMin >= MIN_DRIFT_SPAN_S && denominator > 0) {
+        drift = (n * sxy - sx * sy) / denominator;
+    }
+    float intercept = (sy - drift * sx) / n;
+
+    _refLocalUs = refLocal;
+    _offsetUs = baseOffset + (uint32_t)(int32_t)lroundf(intercept);
+    _driftPpm = drift;
+    _minRttUs = _samples[fastest].rttUs;
+    _synced = _sampleCount >= Config::TIME_SYNC_MIN_SAMPLES;
+}
+
+void TimeSync::addCommandLatency(uint32_t jetsonSentUs, uint32_t localDoneUs) {
+    if (!_synced) {
+        return;
+    }
+    int32_t latency = (int32_t)(toJetson(localDoneUs) - jetsonSentUs);
+    _latencies[_latencyNext] = latency > 0 ? (uint32_t)latency : 0;
+    _latencyNext = (_latencyNext + 1) % Config::TIME_SYNC_LATENCY_WINDOW;
+    if (_latencyCount < Config::TIME_SYNC_LATENCY_WINDOW) {
+        _latencyCount++;
+    }
+}
+
+bool TimeSync::isSynced() const {
+    return _synced;
+}
+
+uint32_t TimeSync::toJetson(uint32_t localUs) const {
+    if (!_synced) {
+        return localUs;
+    }
+    int32_t sinceRef = (int32_t)(localUs - _refLocalUs);
+    return localUs + _offsetUs + (uint32_t)(int32_t)(_driftPpm * 1e-6f * sinceRef);
+}
+
+void TimeSync::report(TelemetryWriter& telemetry) {
+    // Insertion sort of a copy: at most TIME_SYNC_LATENCY_WINDOW entries, once a period
+    uint32_t sorted[Config::TIME_SYNC_LATENCY_WINDOW];
+    for (uint8_t i = 0; i < _latencyCount; i++) {
+        uint32_t v = _latencies[i];
+        uint8_t j = i;
+        while (j > 0 && sorted[j - 1] > v) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = v;
+    }
+
+    uint32_t nowUs = micros();
+    TimeSyncReportPayload* p = telemetry.begin<TimeSyncReportPayload>(FRAME_TIME_SYNC, nowUs);
+    p->teensyTxUs = nowUs;
+    p->synced = _synced ? 1 : 0;
+    p->samples = _sampleCount;
+    p->refUs = _refLocalUs;
+    p->offsetUs = _offsetUs;
+    p->driftPpm = _driftPpm;
+    p->rttMinUs = _minRttUs;
+    p->rttLastUs = _lastRttUs;
+    p->exchangesRejected = _rejected;
+    p->latencyCount = _latencyCount;
+    p->latencyP50Us = _latencyCount ? sorted[(_latencyCount - 1) * 50 / 100] : 0;
+    p->latencyP99Us = _latencyCount ? sorted[(_latencyCount - 1) * 99 / 100] : 0;
+    p->latencyMaxUs = _latencyCount ? sorted[_latencyCount - 1] : 0;
+    telemetry.commit();
+}
@@ -0,0 +1,105 @@
+#ifndef TIME_SYNC_H
+#define TIME_SYNC_H
+
+#include <Arduino.h>
+#include <BoardConfig.h>
+#include "CommandFrame.h"
+
+class TelemetryWriter;
+
+/**
+ * TimeSync.h - Teensy-to-Jetson Clock Model and Command Latency
+ *
+ * NTP-style exchange over the existing link, initiated by the Teensy:
+ *
+ *   t1  Teensy sends FRAME_TIME_SYNC (report()), carrying t1
+ *   j2  Jetson receives it                      (Jetson clock)
+ *   j3  Jetson sends CMD_TIME_SYNC {t1, j2, j3} (Jetson clock)
+ *   t4  Teensy receives the command (Command::receivedUs)
+ *
+ *   round trip rtt = (t4 - t1) - (j3 - j2)
+ *   offset         = ((j2 - t1) + (j3 - t4)) / 2     (Jetson - Teensy)
+ *
+ * Both clocks are used as 32-bit microsecond counters (the Jetson sends
+ * the low 32 bits of its monotonic clock), so all arithmetic is modular
+ * and survives wraparound.
+ *
+ * Queueing on either side only ever adds delay, so the exchanges with the
+ * smallest round trip are the most accurate. The model (offset at a
+ * reference time plus drift in ppm) is a least squares line through the
+ * window's exchanges within TIME_SYNC_RTT_TOLERANCE_US of the fastest;
+ * crystals differ by tens of ppm, which is a millisecond a minute.
+ *
+ * Once synced, TelemetryWriter stamps frame headers in Jetson time, and
+ * every command (which carries its Jetson send time) yields a latency
+ * sample: Jetson send to Teensy acknowledgement. report() also carries
+ * their p50/p99/max, for explorator via cogitator.
+ *
+ * Loop context only.
+ *
+ * Usage:
+ *   TimeSync timeSync;
+ *   telemetry.setClock(&timeSync);
+ *   timeSync.report(telemetry);                    // loop slot, TIME_SYNC_PERIOD_MS
+ *   timeSync.addSample(cmd.timeSync, cmd.receivedUs);   // on CMD_TIME_SYNC
+ *   timeSync.addCommandLatency(cmd.sentUs, micros());   // after each ack
+ */
+class TimeSync {
+private:
+    struct Sample {
+        uint32_t localUs;          // t4
+        uint32_t offsetUs;         // Jetson - Teensy, modular
+        uint32_t rttUs;
+    };
+
+    Sample _samples[Config::TIME_SYNC_WINDOW];
+    uint8_t _sampleCount;
+    uint8_t _sampleNext;
+    uint32_t _rejected;
+    uint32_t _lastRttUs;
+
+    // Model: jetson = local + _offsetUs + _driftPpm * (local - _refLocalUs)
+    bool _synced;
+    uint32_t _refLocalUs;
+    uint32_t _offsetUs;
+    float _driftPpm;
+    uint32_t _minRttUs;
+
+    uint32_t _latencies[Config::TIME_SYNC_LATENCY_WINDOW];
+    uint8_t _latencyCount;
+    uint8_t _latencyNext;
+
+    void fit();
+
+public:
+    TimeSync();
+
+    /**
+     * Take one completed exchange
+     * @param reply - CMD_TIME_SYNC payload: echoed t1, Jetson j2 and j3
+     * @param receivedUs - t4, when the command arrived
+     * @return false if discarded (impossible or too slow round trip)
+     */
+    bool addSample(const Commands::TimeSyncPayload& reply, uint32_t receivedUs);
+
+    /**
+     * Record a command's Jetson send time against its completion. Ignored
+     * until synced.
+     */
+    void addCommandLatency(uint32_t jetsonSentUs, uint32_t localDoneUs);
+
+    bool isSynced() const;
+
+    /**
+     * Teensy micros() to the Jetson clock; unchanged until synced
+     */
+    uint32_t toJetson(uint32_t localUs) const;
+
+    /**
+     * Start the next exchange and report the model and latency
+     * percentiles as FRAME_TIME_SYNC
+     */
+    void report(TelemetryWriter& telemetry);
+};
+
+#endif // TIME_SYNC_H
@@ -0,0 +1,93 @@
+#ifndef TOF_INTERFACE_H
+#define TOF_INTERFACE_H
+
+#include <ToFConfig.h>
+
+/**
+ * ToFInterface.h - Hardware Abstraction Layer for ToF Sensors
+ *
+ * Defines a clean interface that any ToF hardware can implement.
+ * Focused on the essential functions needed for collision avoidance:
+ * initialization, starting measurements, non-blocking distance reads and,
+ * optionally, multi-target reads and runtime range/rate reconfiguration.
+ *
+ * Design Goals:
+ * - Hardware agnostic - works with any ToF chip (VL53L4CX, VL53L1X, etc.)
+ * - Non-blocking - safe for the balance loop
+ * - Easy to swap - new ToF chips require minimal code changes
+ *
+ * Multi-Target Reads:
+ * - readMeasurement() returns every valid target of one measurement, and
+ *   can say "measured, nothing in range" (count 0), which readDistance()
+ *   can't tell apart from "no new data". ToFSensor uses it. The default
+ *   wraps readDistance() as a single target.
+ *
+ * Usage:
+ * 1. Create a concrete implementation (e.g., VL53L4CXInterface)
+ * 2. Implement initialize(), startRanging(), and readDistance() methods
+ * 3. Pass to ToFSensor constructor for dependency injection
+ */
+struct ToFMeasurement {
+    uint8_t count;                                  // valid targets, 0 = nothing in range
+    float   distanceMm[Config::TOF_MAX_TARGETS];    // any order
+};
+
+class ToFInterface {
+public:
+    /**
+     * Initialize the sensor hardware and configure settings.
+     * @return true if initialization successful, false otherwise
+     */
+    virtual bool initialize() = 0;
+
+    /**
+     * Start continuous ranging measurements.
+     * @return true if ranging started successfully
+     */
+    virtual bool startRanging() = 0;
+
+    /**
+     * Cheap check, without bus traffic, for whether readDistance() could
+     * have new data. Implementations without a data-ready signal cannot
+     * know and return true so the caller goes on to poll.
+     */
+    virtual bool isDataReady() const {
+        return true;
+    }
+
+    /**
+     * Non-blocking distance read.
+     * @param distance - distance in mm (only valid when return is true)
+     * @return true if new data was available and read, false if no new data yet
+     */
+    virtual bool readDistance(float& distance) = 0;
+
+    /**
+     * Non-blocking read of all targets in one measurement.
+     * @param measurement - valid only when return is true
+     * @return true if a measurement completed, even with no target
+     */
+    virtual bool readMeasurement(ToFMeasurement& measurement) {
+        float distance;
+        if (!readDistance(distance)) {
+            return false;
+        }
+        measurement.count = 1;
+        measurement.distanceMm[0] = distance;
+        return true;
+    }
+
+    /**
+     * Switch distance mode and timing budget while ranging. May restart
+     * the measurement in progress. Loop context, same as readDistance().
+     * @return false if the sensor can't be reconfigured (default) or the
+     *         change failed; the sensor keeps ranging either way
+     */
+    virtual bool setRangingProfile(const Config::ToFRangingProfile&) {
+        return false;
+    }
+
+    virtual ~ToFInterface() = default;
+};
+
+#endif // TOF_INTERFACE_H
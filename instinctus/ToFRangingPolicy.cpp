@@ -0,0 +1,119 @@
+/**
+ * ToFRangingPolicy.cpp - Speed-Dependent ToF Ranging Profile Implementation
+ */
+
+#include "ToFRangingPolicy.h"
+
+using namespace Telemetry;
+
+static_assert(ToFRangingPolicy::PROFILE_COUNT == PARAM_TOF_PROFILES, "one budget parameter per profile");
+
+static_assert(sizeof(Config::TOF_PROFILE_ENTER_REV_S) / sizeof(Config::TOF_PROFILE_ENTER_REV_S[0]) ==
+              ToFRangingPolicy::PROFILE_COUNT - 1,
+              "TOF_PROFILE_ENTER_REV_S needs one threshold per profile after the first");
+
+ToFRangingPolicy::ToFRangingPolicy(ToFSensor* sensor, SensorId sensorId, float direction)
+    : _sensor(sensor), _sensorId(sensorId), _direction(direction), _params(nullptr),
+      _level(NO_PROFILE), _belowSinceMs(0), _retryAfterMs(0), _closingRevS(0), _budgetUs(0),
+      _switches(0), _failures(0) {
+}
+
+void ToFRangingPolicy::setParams(const ParamStore* params) {
+    _params = params;
+}
+
+uint32_t ToFRangingPolicy::budgetFor(uint8_t level) const {
+    return _params ? _params->active().tofBudgetUs[level] : Config::TOF_RANGING_PROFILES[level].timingBudgetUs;
+}
+
+uint8_t ToFRangingPolicy::levelFor(float closingRevS) const {
+    uint8_t level = 0;
+    while (level < PROFILE_COUNT - 1 && closingRevS >= Config::TOF_PROFILE_ENTER_REV_S[level]) {
+        level++;
+    }
+    return level;
+}
+
+bool ToFRangingPolicy::update(float commandedRevS) {
+    uint32_t now = millis();
+    _closingRevS = commandedRevS * _direction;
+    uint8_t target = levelFor(_closingRevS);
+
+    if (_retryAfterMs != 0) {
+        if ((int32_t)(now - _retryAfterMs) < 0) {
+            return false;
+        }
+        _retryAfterMs = 0;
+    }
+
+    if (_level == NO_PROFILE || target > _level) {
+        return apply(target, now);
+    }
+
+    if (target == _level) {
+        _belowSinceMs = 0;
+        if (budgetFor(_level) != _budgetUs) {
+            return apply(_level, now);
+        }
+        return false;
+    }
+
+    // Below the current profile: require margin under its entry threshold
+    // for the whole hold time before stepping down
+    if (_closingRevS >= Config::TOF_PROFILE_ENTER_REV_S[_level - 1] * Config::TOF_PROFILE_HYSTERESIS) {
+        _belowSinceMs = 0;
+        return false;
+    }
+    if (_belowSinceMs == 0) {
+        _belowSinceMs = now ? now : 1;
+        return false;
+    }
+    if (now - _belowSinceMs < Config::TOF_PROFILE_HOLD_MS) {
+        return false;
+    }
+    return apply(target, now);
+}
+
+bool ToFRangingPolicy::apply(uint8_t level, uint32_t nowMs) {
+    _belowSinceMs = 0;
+    Config::ToFRangingProfile profile = Config::TOF_RANGING_PROFILES[level];
+    profile.timingBudgetUs = budgetFor(level);
+    if (!_sensor->setRangingProfile(profile)) {
+        _failures++;
+        _retryAfterMs = (nowMs + Config::TOF_PROFILE_HOLD_MS) | 1;
+        return false;
+    }
+    _level = level;
+    _budgetUs = profile.timingBudgetUs;
+    _switches++;
+    return true;
+}
+
+void ToFRangingPolicy::report(TelemetryWriter& telemetry) const {
+    ToFRangingPayload* p = telemetry.begin<ToFRangingPayload>(FRAME_TOF_RANGING, micros());
+    p->sensorId = _sensorId;
+    p->profile = _level;
+    if (_level != NO_PROFILE) {
+        p->distanceMode = Config::TOF_RANGING_PROFILES[_level].distanceMode;
+        p->timingBudgetUs = _budgetUs;
+    } else {
+        p->distanceMode = 0;
+        p->timingBudgetUs = 0;
+    }
+    p->closingRevS = _closingRevS;
+    p->switches = _switches;
+    p->failures = _failures;
+    telemetry.commit();
+}
+
+uint8_t ToFRangingPolicy::getLevel() const {
+    return _level;
+}
+
+uint16_t ToFRangingPolicy::getSwitchCount() const {
+    return _switches;
+}
+
+uint16_t ToFRangingPolicy::getFailureCount() const {
+    return _failures;
+}
@@ -0,0 +1,104 @@
+#ifndef TOF_RANGING_POLICY_H
+#define TOF_RANGING_POLICY_H
+
+#include <Arduino.h>
+#include <ToFConfig.h>
+#include "ToFSensor.h"
+#include "TelemetryWriter.h"
+#include "ParamStore.h"
+
+/**
+ * ToFRangingPolicy.h - Speed-Dependent ToF Ranging Profile
+ *
+ * Trades range for update rate on one ToF sensor. Standing still, long
+ * mode with a long budget sees furthest and is least noisy; driving
+ * towards an obstacle, the stopping distance is short but the refresh
+ * rate matters, so short mode with a short budget takes over.
+ *
+ * The input is the commanded wheel speed, not the measured one: it leads
+ * the motion and doesn't carry the balance wobble. direction maps it to
+ * closing speed for this sensor (+1 front, -1 rear); moving away from the
+ * sensor's side counts as standing still.
+ *
+ * Switching:
+ * - Profile index follows Config::TOF_PROFILE_ENTER_REV_S; higher is faster
+ * - Going up is immediate
+ * - Going down waits until the speed has stayed below HYSTERESIS x the
+ *   current profile's entry threshold for HOLD_MS
+ * - A failed switch keeps the old profile and is retried after HOLD_MS;
+ *   failures are counted and go out with the next successful switch
+ *
+ * Timing budgets: the profile's, or with a ParamStore attached the
+ * PARAM_TOF_BUDGET_* for its index. A budget changed at runtime is
+ * re-applied to the current profile on the next update().
+ *
+ * Every switch restarts the sensor, losing the measurement in progress.
+ * Loop context only (the reconfiguration is blocking I2C).
+ *
+ * Usage:
+ *   ToFRangingPolicy frontRanging(&frontToF, Telemetry::SENSOR_FRONT, 1.0f);
+ *   if (frontRanging.update(commandedRevS)) {   // ToF slot
+ *       frontRanging.report(telemetry);
+ *   }
+ */
+class ToFRangingPolicy {
+public:
+    static constexpr uint8_t PROFILE_COUNT =
+        sizeof(Config::TOF_RANGING_PROFILES) / sizeof(Config::TOF_RANGING_PROFILES[0]);
+    static constexpr uint8_t NO_PROFILE = 0xFF;
+
+private:
+    ToFSensor* _sensor;
+    Telemetry::SensorId _sensorId;
+    float _direction;
+    const ParamStore* _params;
+
+    uint8_t _level;                // applied profile, NO_PROFILE until the first switch
+    uint32_t _belowSinceMs;        // start of the current step-down hold, 0 = not holding
+    uint32_t _retryAfterMs;        // failed switch: earliest next attempt
+    float _closingRevS;            // at the last update
+    uint32_t _budgetUs;            // applied with _level
+
+    uint16_t _switches;
+    uint16_t _failures;
+
+    uint8_t levelFor(float closingRevS) const;
+    uint32_t budgetFor(uint8_t level) const;
+    bool apply(uint8_t level, uint32_t nowMs);
+
+public:
+    /**
+     * Constructor
+     * @param sensor - sensor to reconfigure
+     * @param sensorId - identifies the sensor in FRAME_TOF_RANGING
+     * @param direction - +1 if forward wheel speed closes on this sensor's side, -1 if not
+     */
+    ToFRangingPolicy(ToFSensor* sensor, Telemetry::SensorId sensorId, float direction);
+
+    /**
+     * Take the profiles' timing budgets from runtime parameters
+     * @param params - parameter store, or nullptr for Config::TOF_RANGING_PROFILES
+     */
+    void setParams(const ParamStore* params);
+
+    /**
+     * Pick the profile for the commanded speed and apply it if it changed.
+     * The first call always applies one.
+     * @param commandedRevS - wheel speed target, positive = forward
+     * @return true if a new profile (or budget) was applied
+     */
+    bool update(float commandedRevS);
+
+    /**
+     * Send FRAME_TOF_RANGING with the current profile and counters
+     */
+    void report(TelemetryWriter& telemetry) const;
+
+    /** @return applied profile index, or NO_PROFILE */
+    uint8_t getLevel() const;
+
+    uint16_t getSwitchCount() const;
+    uint16_t getFailureCount() const;
+};
+
+#endif // TOF_RANGING_POLICY_H
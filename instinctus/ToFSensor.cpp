@@ -0,0 +1,96 @@
+/**
+ * ToFSensor.cpp - ToF Distance Sensor System Implementation
+ *
+ * Reads measurements via ToFInterface, tracks targets and publishes
+ * ObstacleEvents. Non-blocking: update() returns immediately if no new
+ * data is available.
+ */
+
+#include "ToFSensor.h"
+#include "MemoryPlacement.h"
+
+
+ToFSensor::ToFSensor(ToFInterface* tofHardware)
+    : _tof(tofHardware), _bus(nullptr), _sensorId(Telemetry::SENSOR_FRONT), _thresholdMm(0), _params(nullptr),
+      _currentDistance(-1.0f), _lastMeasurementUs(0), _initialized(false) {
+}
+
+void ToFSensor::setEventBus(EventBus* bus, Telemetry::SensorId sensorId, float thresholdMm) {
+    _bus = bus;
+    _sensorId = sensorId;
+    _thresholdMm = thresholdMm;
+}
+
+void ToFSensor::setParams(const ParamStore* params) {
+    _params = params;
+}
+
+COLD_CODE bool ToFSensor::initialize() {
+    if (!_tof) {
+        return false;
+    }
+    if (!_tof->initialize()) {
+        return false;
+    }
+    if (!_tof->startRanging()) {
+        return false;
+    }
+    _tracker.reset();
+    _initialized = true;
+    return true;
+}
+
+void ToFSensor::update() {
+    if (!_initialized) {
+        return;
+    }
+
+    if (!_tof->isDataReady()) {
+        return; // Nothing measured yet, don't touch the bus
+    }
+
+    ToFMeasurement measurement;
+    if (!_tof->readMeasurement(measurement)) {
+        return; // No new data available, skip this cycle
+    }
+
+    uint32_t now = micros();
+    _lastMeasurementUs = now ? now : 1;
+    _tracker.update(measurement, now);
+    _currentDistance = _tracker.getDistance();
+    if (!_tracker.hasTarget()) {
+        return;
+    }
+
+    // Publish if an obstacle is close, or closing fast enough to be soon
+    float ttc = _tracker.getTimeToContact();
+    float thresholdMm = _params ? _params->active().tofWarnMm[_sensorId] : _thresholdMm;
+    if (_bus && (_currentDistance < thresholdMm || ttc < Config::TOF_TTC_WARN_S)) {
+        ObstacleEvent event = { micros(), _sensorId, _currentDistance, _tracker.getClosingSpeed(), ttc, 1 };
+        _bus->obstacle.publish(event);
+    }
+}
+
+bool ToFSensor::hasPendingData() const {
+    return _initialized && _tof->isDataReady();
+}
+
+bool ToFSensor::setRangingProfile(const Config::ToFRangingProfile& profile) {
+    return _initialized && _tof->setRangingProfile(profile);
+}
+
+float ToFSensor::getDistance() const {
+    return _currentDistance;
+}
+
+uint32_t ToFSensor::getLastMeasurementUs() const {
+    return _lastMeasurementUs;
+}
+
+float ToFSensor::getClosingSpeed() const {
+    return _tracker.getClosingSpeed();
+}
+
+float ToFSensor::getTimeToContact() const {
+    return _tracker.getTimeToContact();
+}
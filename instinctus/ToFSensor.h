@@ -0,0 +1,120 @@
+#ifndef TOF_SENSOR_H
+#define TOF_SENSOR_H
+
+#include <Arduino.h>
+#include "ToFInterface.h"
+#include "ToFTargetTracker.h"
+#include "EventBus.h"
+#include "ParamStore.h"
+
+/**
+ * ToFSensor.h - ToF Distance Sensor System
+ *
+ * Processes ToF sensor data and publishes obstacle proximity events.
+ * Mirrors the BalanceIMU pattern: hardware abstraction via ToFInterface,
+ * events on the EventBus. Every measurement goes through a
+ * ToFTargetTracker, so distances are median filtered, single spurious
+ * returns are never reported, and the closing speed gives a time to
+ * contact.
+ *
+ * Key Features:
+ * - Hardware abstraction via ToFInterface (works with any ToF chip)
+ * - ObstacleEvent published on the bus while a confirmed target is inside
+ *   the threshold or closer than Config::TOF_TTC_WARN_S to contact
+ * - Non-blocking update cycle safe for the balance loop
+ * - Configurable proximity threshold, owned by the sensor (subscribers
+ *   don't filter), or taken from a ParamStore
+ *
+ * Usage:
+ *   VL53L4CXInterface tofHardware(&Wire, -1, 0x29);
+ *   ToFSensor sensor(&tofHardware);
+ *   sensor.setEventBus(&eventBus, Telemetry::SENSOR_FRONT, 20.0f);
+ *   sensor.initialize();
+ *   while (true) {
+ *       sensor.update();  // Non-blocking
+ *   }
+ */
+class ToFSensor {
+private:
+    ToFInterface* _tof;
+    EventBus* _bus;
+    Telemetry::SensorId _sensorId;
+    float _thresholdMm;
+    const ParamStore* _params;
+
+    ToFTargetTracker _tracker;
+    float _currentDistance;   // Tracked distance in mm, -1 until the first measurement
+    uint32_t _lastMeasurementUs;  // 0 until the first measurement
+    bool _initialized;
+
+public:
+    /**
+     * Constructor
+     * @param tofHardware - pointer to ToF hardware implementation
+     */
+    ToFSensor(ToFInterface* tofHardware);
+
+    /**
+     * Publish ObstacleEvents on a bus
+     * @param bus - event bus, or nullptr to publish nothing
+     * @param sensorId - identifies this sensor in the events
+     * @param thresholdMm - distance below which an obstacle is reported
+     */
+    void setEventBus(EventBus* bus, Telemetry::SensorId sensorId, float thresholdMm);
+
+    /**
+     * Take the proximity threshold from runtime parameters instead
+     * @param params - parameter store, or nullptr for setEventBus()'s threshold
+     */
+    void setParams(const ParamStore* params);
+
+    /**
+     * Initialize the ToF sensor and start ranging
+     * @return true if initialization successful
+     */
+    bool initialize();
+
+    /**
+     * Non-blocking update: reads sensor if new data is available.
+     * Returns without bus traffic when the hardware reports nothing ready.
+     * Publishes an ObstacleEvent on obstacle detection or approach.
+     */
+    void update();
+
+    /**
+     * True if update() would touch the bus; lets the caller skip taking
+     * the bus when no measurement is waiting
+     */
+    bool hasPendingData() const;
+
+    /**
+     * Reconfigure the sensor's range/rate trade-off at runtime
+     * @return false if not initialized, unsupported or the change failed
+     */
+    bool setRangingProfile(const Config::ToFRangingProfile& profile);
+
+    /**
+     * Get the nearest tracked target's distance in mm
+     * @return distance in mm, -1.0 before the first measurement,
+     *         Config::NO_TARGET_DISTANCE when no target is tracked
+     */
+    float getDistance() const;
+
+    /**
+     * @return micros() of the last measurement read, 0 before the first
+     */
+    uint32_t getLastMeasurementUs() const;
+
+    /**
+     * @return nearest target's closing speed in mm/s, positive = approaching
+     */
+    float getClosingSpeed() const;
+
+    /**
+     * @return seconds to contact with the nearest target, or
+     *         Config::TOF_NO_CONTACT_S when not closing
+     */
+    float getTimeToContact() const;
+};
+
+#endif // TOF_SENSOR_H
@@ -0,0 +1,182 @@
+/**
+ * ToFTargetTracker.cpp - Multi-Target Tracking Implementation
+ *
+ * Everything is O(HISTORY²) per track at most (10 slopes for a history of
+ * five), run once per ToF measurement from loop().
+ */
+
+#include "ToFTargetTracker.h"
+
+static_assert(Config::TOF_TRACK_CONFIRM_HITS >= 2 && Config::TOF_TRACK_CONFIRM_HITS <= Config::TOF_TRACK_HISTORY,
+              "TOF_TRACK_CONFIRM_HITS must be between 2 and TOF_TRACK_HISTORY");
+
+// Insertion sort, then middle element (mean of the two middle ones if even)
+static float median(float* values, uint8_t count) {
+    for (uint8_t i = 1; i < count; i++) {
+        float v = values[i];
+        int8_t j = i - 1;
+        while (j >= 0 && values[j] > v) {
+            values[j + 1] = values[j];
+            j--;
+        }
+        values[j + 1] = v;
+    }
+    return (count & 1) ? values[count / 2] : 0.5f * (values[count / 2 - 1] + values[count / 2]);
+}
+
+ToFTargetTracker::ToFTargetTracker() {
+    reset();
+}
+
+void ToFTargetTracker::reset() {
+    memset(_tracks, 0, sizeof(_tracks));
+    _primary = -1;
+}
+
+float ToFTargetTracker::predict(const Track& track, uint32_t timestampUs) const {
+    return track.filteredMm - track.closingMmS * ((timestampUs - track.lastUs) * 1e-6f);
+}
+
+void ToFTargetTracker::addReturn(Track& track, float distanceMm, uint32_t timestampUs) {
+    track.distanceMm[track.head] = distanceMm;
+    track.timeUs[track.head] = timestampUs;
+    track.head = (track.head + 1) % HISTORY;
+    if (track.hits < HISTORY) {
+        track.hits++;
+    }
+    track.misses = 0;
+    track.lastUs = timestampUs;
+    estimate(track);
+}
+
+void ToFTargetTracker::estimate(Track& track) {
+    uint8_t n = track.hits;
+    uint8_t first = (track.head + HISTORY - n) % HISTORY;
+
+    // Theil-Sen: median of all pairwise slopes
+    float slopes[HISTORY * (HISTORY - 1) / 2];
+    uint8_t slopeCount = 0;
+    for (uint8_t a = 0; a < n; a++) {
+        for (uint8_t b = a + 1; b < n; b++) {
+            uint8_t i = (first + a) % HISTORY;
+            uint8_t j = (first + b) % HISTORY;
+            float dt = (track.timeUs[j] - track.timeUs[i]) * 1e-6f;
+            if (dt > 0) {
+                slopes[slopeCount++] = (track.distanceMm[j] - track.distanceMm[i]) / dt;
+            }
+        }
+    }
+    track.closingMmS = slopeCount ? -median(slopes, slopeCount) : 0;
+
+    // Median of the history, projected to the newest return
+    float projected[HISTORY];
+    for (uint8_t a = 0; a < n; a++) {
+        uint8_t i = (first + a) % HISTORY;
+        projected[a] = track.distanceMm[i] - track.closingMmS * ((track.lastUs - track.timeUs[i]) * 1e-6f);
+    }
+    track.filteredMm = median(projected, n);
+}
+
+void ToFTargetTracker::update(const ToFMeasurement& measurement, uint32_t timestampUs) {
+    bool matched[MAX_TRACKS] = {};
+    bool used[Config::TOF_MAX_TARGETS] = {};
+
+    // Greedy association, closest return/track pair first
+    while (true) {
+        int8_t bestTrack = -1;
+        int8_t bestReturn = -1;
+        float bestError = Config::TOF_TRACK_GATE_MM;
+        for (uint8_t t = 0; t < MAX_TRACKS; t++) {
+            if (!_tracks[t].active || matched[t]) {
+                continue;
+            }
+            float predicted = predict(_tracks[t], timestampUs);
+            for (uint8_t r = 0; r < measurement.count; r++) {
+                float error = fabsf(measurement.distanceMm[r] - predicted);
+                if (!used[r] && error < bestError) {
+                    bestError = error;
+                    bestTrack = t;
+                    bestReturn = r;
+                }
+            }
+        }
+        if (bestTrack < 0) {
+            break;
+        }
+        matched[bestTrack] = true;
+        used[bestReturn] = true;
+        addReturn(_tracks[bestTrack], measurement.distanceMm[bestReturn], timestampUs);
+    }
+
+    for (uint8_t t = 0; t < MAX_TRACKS; t++) {
+        if (_tracks[t].active && !matched[t] && ++_tracks[t].misses > Config::TOF_TRACK_MAX_MISSES) {
+            _tracks[t].active = false;
+        }
+    }
+
+    // Leftover returns start tentative tracks in a free slot, or replace
+    // the weakest unmatched tentative one; confirmed tracks are kept
+    for (uint8_t r = 0; r < measurement.count; r++) {
+        if (used[r]) {
+            continue;
+        }
+        int8_t slot = -1;
+        for (uint8_t t = 0; t < MAX_TRACKS; t++) {
+            if (!_tracks[t].active) {
+                slot = t;
+                break;
+            }
+            if (!matched[t] && _tracks[t].hits < Config::TOF_TRACK_CONFIRM_HITS &&
+                (slot < 0 || _tracks[t].hits < _tracks[slot].hits)) {
+                slot = t;
+            }
+        }
+        if (slot < 0) {
+            break;
+        }
+        Track& track = _tracks[slot];
+        memset(&track, 0, sizeof(track));
+        track.active = true;
+        matched[slot] = true;
+        addReturn(track, measurement.distanceMm[r], timestampUs);
+    }
+
+    _primary = -1;
+    for (uint8_t t = 0; t < MAX_TRACKS; t++) {
+        const Track& track = _tracks[t];
+        if (track.active && track.hits >= Config::TOF_TRACK_CONFIRM_HITS &&
+            (_primary < 0 || track.filteredMm < _tracks[_primary].filteredMm)) {
+            _primary = t;
+        }
+    }
+}
+
+bool ToFTargetTracker::hasTarget() const {
+    return _primary >= 0;
+}
+
+float ToFTargetTracker::getDistance() const {
+    return _primary >= 0 ? _tracks[_primary].filteredMm : Config::NO_TARGET_DISTANCE;
+}
+
+float ToFTargetTracker::getClosingSpeed() const {
+    return _primary >= 0 ? _tracks[_primary].closingMmS : 0.0f;
+}
+
+float ToFTargetTracker::getTimeToContact() const {
+    if (_primary < 0 || _tracks[_primary].closingMmS < Config::TOF_MIN_CLOSING_MM_S) {
+        return Config::TOF_NO_CONTACT_S;
+    }
+    float ttc = _tracks[_primary].filteredMm / _tracks[_primary].closingMmS;
+    return ttc < Config::TOF_NO_CONTACT_S ? ttc : Config::TOF_NO_CONTACT_S;
+}
+
+uint8_t ToFTargetTracker::getTargetCount() const {
+    uint8_t count = 0;
+    for (uint8_t t = 0; t < MAX_TRACKS; t++) {
+        if (_tracks[t].active && _tracks[t].hits >= Config::TOF_TRACK_CONFIRM_HITS) {
+            count++;
+        }
+    }
+    return count;
+}
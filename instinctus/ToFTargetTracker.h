@@ -0,0 +1,95 @@
+#ifndef TOF_TARGET_TRACKER_H
+#define TOF_TARGET_TRACKER_H
+
+#include <Arduino.h>
+#include <ToFConfig.h>
+#include "ToFInterface.h"
+
+/**
+ * ToFTargetTracker.h - Multi-Target Tracking for One ToF Sensor
+ *
+ * Turns raw multi-target measurements into a small set of tracked
+ * obstacles with a filtered distance, a closing speed and a time to
+ * contact. Fixed memory: Config::TOF_MAX_TARGETS tracks of
+ * Config::TOF_TRACK_HISTORY returns each.
+ *
+ * Per measurement:
+ * - Returns are matched to tracks nearest-first against each track's
+ *   predicted distance, within Config::TOF_TRACK_GATE_MM. Unmatched
+ *   returns start tentative tracks (replacing the weakest tentative one
+ *   if full),
+ *   unmatched tracks count a miss.
+ * - Closing speed is the median of the pairwise slopes over the history
+ *   (Theil-Sen), so one bad return shifts neither speed nor distance.
+ * - Distance is the median of the history, each return first projected
+ *   to the newest timestamp along that speed: a median without the lag.
+ *
+ * Only confirmed tracks are reported. A "nothing in range" measurement
+ * counts as a miss for every track, so the scene clears within
+ * TOF_TRACK_MAX_MISSES measurements instead of holding the last distance.
+ *
+ * Usage:
+ *   ToFTargetTracker tracker;
+ *   tracker.update(measurement, micros());
+ *   if (tracker.hasTarget()) {
+ *       float mm = tracker.getDistance();
+ *       float ttc = tracker.getTimeToContact();
+ *   }
+ */
+class ToFTargetTracker {
+public:
+    static constexpr uint8_t MAX_TRACKS = Config::TOF_MAX_TARGETS;
+    static constexpr uint8_t HISTORY = Config::TOF_TRACK_HISTORY;
+
+private:
+    struct Track {
+        bool     active;
+        uint8_t  hits;             // returns associated, saturates at HISTORY
+        uint8_t  misses;           // consecutive measurements without one
+        uint8_t  head;             // next history slot
+        float    distanceMm[HISTORY];
+        uint32_t timeUs[HISTORY];
+        float    filteredMm;       // at the newest return
+        float    closingMmS;       // positive = approaching
+        uint32_t lastUs;
+    };
+
+    Track _tracks[MAX_TRACKS];
+    int8_t _primary;               // nearest confirmed track, -1 = none
+
+    void addReturn(Track& track, float distanceMm, uint32_t timestampUs);
+    void estimate(Track& track);
+    float predict(const Track& track, uint32_t timestampUs) const;
+
+public:
+    ToFTargetTracker();
+
+    /**
+     * Drop all tracks
+     */
+    void reset();
+
+    /**
+     * Feed one completed measurement
+     * @param measurement - all valid targets, count 0 if nothing in range
+     * @param timestampUs - when the measurement was read
+     */
+    void update(const ToFMeasurement& measurement, uint32_t timestampUs);
+
+    /** @return true if a confirmed track exists */
+    bool hasTarget() const;
+
+    /** @return nearest confirmed track's distance in mm, or Config::NO_TARGET_DISTANCE */
+    float getDistance() const;
+
+    /** @return nearest confirmed track's closing speed in mm/s, positive = approaching */
+    float getClosingSpeed() const;
+
+    /** @return seconds to contact with the nearest track, or Config::TOF_NO_CONTACT_S */
+    float getTimeToContact() const;
+
+    /** @return number of confirmed tracks */
+    uint8_t getTargetCount() const;
+};
+
+#endif // TOF_TARGET_TRACKER_H
@@ -0,0 +1,217 @@
+/**
+ * VL53L4CXInterface.cpp - VL53L4CX ToF Sensor Implementation
+ *
+ * Concrete implementation of ToFInterface for the VL53L4CX sensor.
+ * Uses the STM32duino VL53L4CX library for hardware communication.
+ *
+ * Non-blocking design:
+ * - Interrupt mode: readDistance() returns false without touching the bus
+ *   until the GPIO1 ISR has flagged a measurement, except for one poll per
+ *   interrupt timeout to recover from a missed edge
+ * - Polling mode: readDistance() polls VL53L4CX_GetMeasurementDataReady()
+ *   once per call
+ * - Returns false immediately if no new data is available
+ * - readMeasurement() reports every valid target; readDistance() keeps
+ *   the closest one and returns false when there is none
+ * - Never blocks the balance loop
+ *
+ * The flag is cleared before the result is read, so an edge raised by the
+ * next measurement (started by ClearInterruptAndStartMeasurement) is
+ * never lost.
+ *
+ * Bring-up is split so the sketch can overlap it with other devices:
+ * powerUp() (XSHUT), assignAddress() (address and boot check), then
+ * initialize() (firmware data init and configuration). The driver's own
+ * InitSensor() is not used: it toggles XSHUT with two 10 ms delays.
+ *
+ * Distance mode starts as SHORT for fast, close-range collision detection;
+ * ToFRangingPolicy changes it at runtime through setRangingProfile().
+ */
+
+#include "VL53L4CXInterface.h"
+#include "MemoryPlacement.h"
+#include <ToFConfig.h>
+
+VL53L4CXInterface* VL53L4CXInterface::_instances[MAX_INTERRUPT_SENSORS] = { nullptr, nullptr };
+
+// Multi-target result, filled by the driver on every read. Shared by all
+// instances: readDistance() only runs from loop(), one sensor at a time.
+BULK_DATA static VL53L4CX_MultiRangingData_t rangingScratch;
+
+VL53L4CXInterface::VL53L4CXInterface(TwoWire* i2cBus, int xshutPin, uint8_t address, uint32_t timingBudgetUs, int gpio1Pin)
+    : _tof(i2cBus, xshutPin), _xshutPin(xshutPin), _i2cAddress(address),
+      _poweredUp(false), _addressAssigned(false), _powerUpUs(0), _timingBudgetUs(timingBudgetUs),
+      _gpio1Pin(gpio1Pin), _dataReady(false), _lastReadyUs(0),
+      _busPolls(0), _missedInterrupts(0) {
+}
+
+COLD_CODE bool VL53L4CXInterface::powerUp() {
+    _tof.begin();   // XSHUT output, held low
+    if (_xshutPin >= 0) {
+        digitalWrite(_xshutPin, HIGH);
+    }
+    _powerUpUs = micros();
+    _poweredUp = true;
+    return true;
+}
+
+COLD_CODE bool VL53L4CXInterface::assignAddress() {
+    if (!_poweredUp) {
+        powerUp();
+    }
+    uint32_t sinceUp = micros() - _powerUpUs;
+    if (sinceUp < Config::TOF_BOOT_TIME_US) {
+        delayMicroseconds(Config::TOF_BOOT_TIME_US - sinceUp);
+    }
+    _addressAssigned = _tof.VL53L4CX_SetDeviceAddress(_i2cAddress) == VL53L4CX_ERROR_NONE &&
+                       _tof.VL53L4CX_WaitDeviceBooted() == VL53L4CX_ERROR_NONE;
+    return _addressAssigned;
+}
+
+COLD_CODE bool VL53L4CXInterface::initialize() {
+    if (!_addressAssigned && !assignAddress()) {
+        return false;
+    }
+    if (_tof.VL53L4CX_DataInit() != VL53L4CX_ERROR_NONE) {
+        return false;
+    }
+
+    // Short distance mode for fast collision detection
+    _tof.VL53L4CX_SetDistanceMode(VL53L4CX_DISTANCEMODE_SHORT);
+    _tof.VL53L4CX_SetMeasurementTimingBudgetMicroSeconds(_timingBudgetUs);
+
+    if (_gpio1Pin >= 0 && !attachDataReadyInterrupt()) {
+        _gpio1Pin = -1;  // No free ISR slot, fall back to polling
+    }
+
+    return true;
+}
+
+COLD_CODE bool VL53L4CXInterface::attachDataReadyInterrupt() {
+    static void (* const isrs[MAX_INTERRUPT_SENSORS])() = { gpio1Isr0, gpio1Isr1 };
+
+    for (uint8_t i = 0; i < MAX_INTERRUPT_SENSORS; i++) {
+        if (_instances[i] == nullptr || _instances[i] == this) {
+            _instances[i] = this;
+            pinMode(_gpio1Pin, INPUT_PULLUP);
+            attachInterrupt(digitalPinToInterrupt(_gpio1Pin), isrs[i], FALLING);
+            return true;
+        }
+    }
+    return false;
+}
+
+void VL53L4CXInterface::gpio1Isr0() {
+    _instances[0]->_dataReady = true;
+}
+
+void VL53L4CXInterface::gpio1Isr1() {
+    _instances[1]->_dataReady = true;
+}
+
+COLD_CODE bool VL53L4CXInterface::startRanging() {
+    _dataReady = false;
+    _lastReadyUs = micros();
+    return _tof.VL53L4CX_StartMeasurement() == VL53L4CX_ERROR_NONE;
+}
+
+bool VL53L4CXInterface::isDataReady() const {
+    if (_gpio1Pin < 0 || _dataReady) {
+        return true;
+    }
+    return (micros() - _lastReadyUs) > _timingBudgetUs * Config::TOF_INTERRUPT_TIMEOUT_BUDGETS;
+}
+
+bool VL53L4CXInterface::pollDataReady() {
+    _busPolls++;
+    uint8_t dataReady = 0;
+    if (_tof.VL53L4CX_GetMeasurementDataReady(&dataReady) != VL53L4CX_ERROR_NONE) {
+        return false;
+    }
+    return dataReady != 0;
+}
+
+bool VL53L4CXInterface::readDistance(float& distance) {
+    ToFMeasurement measurement;
+    if (!readMeasurement(measurement) || measurement.count == 0) {
+        return false;
+    }
+
+    // Use the closest valid target
+    distance = measurement.distanceMm[0];
+    for (uint8_t i = 1; i < measurement.count; i++) {
+        if (measurement.distanceMm[i] < distance) {
+            distance = measurement.distanceMm[i];
+        }
+    }
+    return true;
+}
+
+bool VL53L4CXInterface::readMeasurement(ToFMeasurement& measurement) {
+    if (_gpio1Pin >= 0) {
+        if (_dataReady) {
+            _dataReady = false;
+        } else if (isDataReady()) {
+            // Edge timeout: poll once, and restart the timeout either way
+            _lastReadyUs = micros();
+            if (!pollDataReady()) {
+                return false;
+            }
+            _missedInterrupts++;
+        } else {
+            return false;
+        }
+    } else if (!pollDataReady()) {
+        // Non-blocking: check if data is ready, return false if not
+        return false;
+    }
+
+    _lastReadyUs = micros();
+
+    VL53L4CX_MultiRangingData_t& rangingData = rangingScratch;
+    if (_tof.VL53L4CX_GetMultiRangingData(&rangingData) != VL53L4CX_ERROR_NONE) {
+        _tof.VL53L4CX_ClearInterruptAndStartMeasurement();
+        return false;
+    }
+
+    // Every valid target, for the tracker to sort out
+    measurement.count = 0;
+    for (int i = 0; i < rangingData.NumberOfObjectsFound && measurement.count < Config::TOF_MAX_TARGETS; i++) {
+        if (rangingData.RangeData[i].RangeStatus == VL53L4CX_RANGESTATUS_RANGE_VALID ||
+            rangingData.RangeData[i].RangeStatus == VL53L4CX_RANGESTATUS_RANGE_VALID_MIN_RANGE_CLIPPED) {
+            measurement.distanceMm[measurement.count++] = (float)rangingData.RangeData[i].RangeMilliMeter;
+        }
+    }
+
+    _tof.VL53L4CX_ClearInterruptAndStartMeasurement();
+    return true;
+}
+
+bool VL53L4CXInterface::setRangingProfile(const Config::ToFRangingProfile& profile) {
+    VL53L4CX_DistanceModes mode;
+    switch (profile.distanceMode) {
+        case 1: mode = VL53L4CX_DISTANCEMODE_SHORT; break;
+        case 2: mode = VL53L4CX_DISTANCEMODE_MEDIUM; break;
+        case 3: mode = VL53L4CX_DISTANCEMODE_LONG; break;
+        default: return false;
+    }
+
+    // The driver only applies new settings from a stopped state
+    bool applied = _tof.VL53L4CX_StopMeasurement() == VL53L4CX_ERROR_NONE &&
+                   _tof.VL53L4CX_SetDistanceMode(mode) == VL53L4CX_ERROR_NONE &&
+                   _tof.VL53L4CX_SetMeasurementTimingBudgetMicroSeconds(profile.timingBudgetUs) == VL53L4CX_ERROR_NONE;
+    if (applied) {
+        _timingBudgetUs = profile.timingBudgetUs;
+    }
+
+    // Restart either way, so a failed switch still leaves the sensor ranging
+    return startRanging() && applied;
+}
+
+uint32_t VL53L4CXInterface::getBusPollCount() const {
+    return _busPolls;
+}
+
+uint32_t VL53L4CXInterface::getMissedInterruptCount() const {
+    return _missedInterrupts;
+}
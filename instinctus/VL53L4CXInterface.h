@@ -0,0 +1,115 @@
+#ifndef VL53L4CX_INTERFACE_H
+#define VL53L4CX_INTERFACE_H
+
+#include <vl53l4cx_class.h>
+#include <Wire.h>
+#include "ToFInterface.h"
+
+/**
+ * VL53L4CXInterface.h - VL53L4CX ToF Sensor Implementation
+ *
+ * Implements ToFInterface for the STM32duino VL53L4CX multi-zone ToF sensor.
+ * Provides non-blocking distance reads safe for the balance loop.
+ *
+ * Hardware Details:
+ * - Communication: I2C (Wire library)
+ * - Library: STM32duino VL53L4CX
+ * - Default I2C address: 0x29
+ * - Both sensors share one bus (Config::TOF_I2C_BUS) and boot at 0x29, so
+ *   they are re-addressed at startup: both are held in reset by XSHUT,
+ *   the rear is released and moved to 0x30 by assignAddress(), then the
+ *   front is released and keeps 0x29 (Config::TOF_REAR / TOF_FRONT)
+ *
+ * Data-Ready Interrupt (optional):
+ * - With gpio1Pin wired, the sensor's open-drain GPIO1 line pulls low when
+ *   a measurement completes. The edge ISR only sets a flag; readDistance()
+ *   and isDataReady() return immediately without any I2C traffic until it
+ *   is set. Without it (gpio1Pin = -1), every readDistance() polls
+ *   GetMeasurementDataReady() over I2C as before.
+ * - If no edge arrives within Config::TOF_INTERRUPT_TIMEOUT_BUDGETS timing
+ *   budgets, one poll is made anyway; this recovers from a missed edge,
+ *   which would otherwise leave GPIO1 low and the sensor stalled.
+ * - Up to MAX_INTERRUPT_SENSORS instances can use interrupt mode.
+ *
+ * Ranging Profiles:
+ * - initialize() starts in SHORT mode with the constructor's budget.
+ *   setRangingProfile() switches mode and budget at runtime; the
+ *   interrupt timeout follows the new budget.
+ *
+ * Usage:
+ *   VL53L4CXInterface tof(&Wire, -1, 0x29, 33000, 26);
+ *   if (tof.initialize()) {
+ *       tof.startRanging();
+ *       float distance;
+ *       if (tof.readDistance(distance)) {
+ *           // Use distance in mm
+ *       }
+ *   }
+ */
+class VL53L4CXInterface : public ToFInterface {
+public:
+    static constexpr uint8_t MAX_INTERRUPT_SENSORS = 2;
+
+private:
+    VL53L4CX _tof;
+    int _xshutPin;
+    uint8_t _i2cAddress;
+    bool _poweredUp;
+    bool _addressAssigned;
+    uint32_t _powerUpUs;             // XSHUT release, for the boot time
+    uint32_t _timingBudgetUs;
+    int _gpio1Pin;
+
+    volatile bool _dataReady;        // set by the GPIO1 edge ISR
+    uint32_t _lastReadyUs;           // last measurement seen, for the timeout
+    uint32_t _busPolls;              // GetMeasurementDataReady() calls
+    uint32_t _missedInterrupts;      // timeouts that found data waiting
+
+    bool attachDataReadyInterrupt();
+    bool pollDataReady();
+
+    static VL53L4CXInterface* _instances[MAX_INTERRUPT_SENSORS];
+    static void gpio1Isr0();
+    static void gpio1Isr1();
+
+public:
+    /**
+     * Constructor
+     * @param i2cBus - pointer to I2C bus (e.g., &Wire, &Wire1)
+     * @param xshutPin - XSHUT pin for power control (-1 if not connected)
+     * @param address - I2C address (default 0x29)
+     * @param timingBudgetUs - measurement timing budget
+     * @param gpio1Pin - GPIO1 data-ready pin (-1 to poll over I2C)
+     */
+    VL53L4CXInterface(TwoWire* i2cBus, int xshutPin, uint8_t address, uint32_t timingBudgetUs = 33000, int gpio1Pin = -1);
+
+    /**
+     * Boot overlap, setup only. Release XSHUT and return at once; after
+     * TOF_BOOT_TIME_US, assignAddress() moves the sensor off the shared
+     * default address so the next one can be powered up. initialize()
+     * does whichever of these has not been done yet, waiting as needed.
+     */
+    bool powerUp();
+    bool assignAddress();
+
+    bool initialize() override;
+    bool startRanging() override;
+    bool isDataReady() const override;
+    bool readDistance(float& distance) override;
+    bool readMeasurement(ToFMeasurement& measurement) override;
+
+    /**
+     * Stop ranging, apply mode and budget, restart. Costs the measurement
+     * in progress plus the reconfiguration I2C traffic (a few ms).
+     */
+    bool setRangingProfile(const Config::ToFRangingProfile& profile) override;
+
+    /**
+     * Diagnostics: I2C data-ready polls made, and how many of the timeout
+     * polls found a measurement whose edge was missed
+     */
+    uint32_t getBusPollCount() const;
+    uint32_t getMissedInterruptCount() const;
+};
+
+#endif // VL53L4CX_INTERFACE_H
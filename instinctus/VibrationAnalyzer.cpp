@@ -0,0 +1,182 @@
+/**
+ * VibrationAnalyzer.cpp - IMU Vibration Spectrum Implementation
+ *
+ * Scaling: with window w[n] and X[k] the FFT of w[n] x[n], the one-sided
+ * power of bin k (0 < k < N/2) is 2 |X[k]|² / (N² U), U = mean(w²)
+ * (0.375 for Hann). Summed over the bins this is the mean square of x,
+ * so the square root of a band's sum is that band's RMS in signal units.
+ */
+
+#include "VibrationAnalyzer.h"
+#include "MemoryPlacement.h"
+#include "FastMath.h"
+#include <arm_math.h>
+#include <math.h>
+
+using namespace Telemetry;
+
+static_assert(sizeof(Config::VIBRATION_BAND_UPPER_HZ) / sizeof(Config::VIBRATION_BAND_UPPER_HZ[0]) ==
+              VIBRATION_BANDS, "VIBRATION_BAND_UPPER_HZ must list one edge per telemetry band");
+static_assert((VibrationAnalyzer::WINDOW & (VibrationAnalyzer::WINDOW - 1)) == 0 &&
+              VibrationAnalyzer::WINDOW >= 32 && VibrationAnalyzer::WINDOW <= 4096,
+              "VIBRATION_WINDOW_SAMPLES must be a CMSIS rfft length");
+
+static arm_rfft_fast_instance_f32 fft;
+
+// Loop-only bulk buffers
+BULK_DATA static float vibrationWindows[VibrationAnalyzer::AXES][VibrationAnalyzer::WINDOW];
+BULK_DATA static float hannTable[VibrationAnalyzer::WINDOW];
+BULK_DATA static float fftInput[VibrationAnalyzer::WINDOW];
+BULK_DATA static float fftOutput[VibrationAnalyzer::WINDOW];
+BULK_DATA static float accelPower[VibrationAnalyzer::BINS];   // summed over windows
+BULK_DATA static float gyroPower[VibrationAnalyzer::BINS];
+
+static float powerScale;
+
+VibrationAnalyzer::VibrationAnalyzer()
+    : _samples(), _ready(false), _fill(0), _ringDrops(0), _windows(0), _windowsDiscarded(0) {
+}
+
+COLD_CODE bool VibrationAnalyzer::begin() {
+    if (!Config::VIBRATION_ENABLED) {
+        return false;
+    }
+    if (arm_rfft_fast_init_f32(&fft, WINDOW) != ARM_MATH_SUCCESS) {
+        return false;
+    }
+
+    float sumSq = 0;
+    for (uint16_t n = 0; n < WINDOW; n++) {
+        float w = 0.5f - 0.5f * cosf(2.0f * FastMath::PI_F * n / WINDOW);
+        hannTable[n] = w;
+        sumSq += w * w;
+    }
+    powerScale = 2.0f / ((float)WINDOW * sumSq);   // N² U = N * sum(w²)
+
+    memset(accelPower, 0, sizeof(accelPower));
+    memset(gyroPower, 0, sizeof(gyroPower));
+    _ringDrops = _samples.getDropCount();
+    _ready = true;
+    return true;
+}
+
+HOT_CODE void VibrationAnalyzer::push(const IMUSample* samples, uint8_t count) {
+    if (!_ready) {
+        return;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        _samples.push(samples[i]);
+    }
+}
+
+void VibrationAnalyzer::service() {
+    if (!_ready) {
+        return;
+    }
+
+    // A gap since the last call breaks the window being filled
+    uint32_t drops = _samples.getDropCount();
+    if (drops != _ringDrops) {
+        _ringDrops = drops;
+        if (_fill > 0) {
+            _fill = 0;
+            _windowsDiscarded++;
+        }
+    }
+
+    IMUSample s;
+    while (_samples.pop(s)) {
+        vibrationWindows[0][_fill] = s.accelX;
+        vibrationWindows[1][_fill] = s.accelY;
+        vibrationWindows[2][_fill] = s.accelZ;
+        vibrationWindows[3][_fill] = s.gyroX;
+        vibrationWindows[4][_fill] = s.gyroY;
+        vibrationWindows[5][_fill] = s.gyroZ;
+        if (++_fill == WINDOW) {
+            processWindow();
+            _fill = 0;
+            return;   // one transform per call; the rest waits in the ring
+        }
+    }
+}
+
+void VibrationAnalyzer::processWindow() {
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        float mean;
+        arm_mean_f32(vibrationWindows[axis], WINDOW, &mean);
+        for (uint16_t n = 0; n < WINDOW; n++) {
+            fftInput[n] = (vibrationWindows[axis][n] - mean) * hannTable[n];
+        }
+
+        // Output: [Re0, Re(N/2), Re1, Im1, Re2, Im2, ...]; DC and
+        // Nyquist are left out of the bands
+        arm_rfft_fast_f32(&fft, fftInput, fftOutput, 0);
+
+        float* power = (axis < 3) ? accelPower : gyroPower;
+        for (uint16_t k = 1; k < BINS; k++) {
+            float re = fftOutput[2 * k];
+            float im = fftOutput[2 * k + 1];
+            power[k] += (re * re + im * im) * powerScale;
+        }
+    }
+    _windows++;
+}
+
+// Band RMS and strongest bin of one averaged spectrum
+static void reduceSpectrum(const float* power, uint16_t windows, float binHz,
+                           float* bandRms, float& peakHz, float& peakRms) {
+    float bandSum[VIBRATION_BANDS] = {};
+    float peak = 0;
+    uint16_t peakBin = 0;
+    uint8_t band = 0;
+    for (uint16_t k = 1; k < VibrationAnalyzer::BINS; k++) {
+        float p = power[k] / windows;
+        while (band < VIBRATION_BANDS - 1 && k * binHz > Config::VIBRATION_BAND_UPPER_HZ[band]) {
+            band++;
+        }
+        bandSum[band] += p;
+        if (p > peak) {
+            peak = p;
+            peakBin = k;
+        }
+    }
+    for (uint8_t b = 0; b < VIBRATION_BANDS; b++) {
+        bandRms[b] = sqrtf(bandSum[b]);
+    }
+    peakHz = peakBin * binHz;
+    peakRms = sqrtf(peak);
+}
+
+void VibrationAnalyzer::report(TelemetryWriter& telemetry) {
+    if (!_ready || _windows == 0) {
+        return;
+    }
+
+    const float binHz = SAMPLE_RATE_HZ / WINDOW;
+    VibrationPayload* p = telemetry.begin<VibrationPayload>(FRAME_VIBRATION, micros());
+    p->sampleRateHz = (uint16_t)SAMPLE_RATE_HZ;
+    p->windowSamples = WINDOW;
+    p->windows = _windows;
+    p->windowsDiscarded = _windowsDiscarded;
+    for (uint8_t b = 0; b < VIBRATION_BANDS; b++) {
+        p->bandUpperHz[b] = Config::VIBRATION_BAND_UPPER_HZ[b];
+    }
+
+    // Packed fields: reduce into locals, then copy
+    float accelBands[VIBRATION_BANDS], gyroBands[VIBRATION_BANDS];
+    float accelPeakHz, accelPeakRms, gyroPeakHz, gyroPeakRms;
+    reduceSpectrum(accelPower, _windows, binHz, accelBands, accelPeakHz, accelPeakRms);
+    reduceSpectrum(gyroPower, _windows, binHz, gyroBands, gyroPeakHz, gyroPeakRms);
+    memcpy(p->accelBandRms, accelBands, sizeof(accelBands));
+    memcpy(p->gyroBandRms, gyroBands, sizeof(gyroBands));
+    p->accelPeakHz = accelPeakHz;
+    p->accelPeakRms = accelPeakRms;
+    p->gyroPeakHz = gyroPeakHz;
+    p->gyroPeakRms = gyroPeakRms;
+    telemetry.commit();
+
+    memset(accelPower, 0, sizeof(accelPower));
+    memset(gyroPower, 0, sizeof(gyroPower));
+    _windows = 0;
+    _windowsDiscarded = 0;
+}
@@ -0,0 +1,92 @@
+#ifndef VIBRATION_ANALYZER_H
+#define VIBRATION_ANALYZER_H
+
+#include <Arduino.h>
+#include <IMUConfig.h>
+#include "IMUInterface.h"
+#include "SpscRing.h"
+#include "TelemetryWriter.h"
+
+/**
+ * VibrationAnalyzer.h - IMU Vibration Spectrum in Frequency Bands
+ *
+ * Spots motor and wheel resonances without streaming raw samples: the
+ * balance ISR hands every FIFO sample to push(), loop() collects them into
+ * VIBRATION_WINDOW_SAMPLES windows, and each full window goes through a
+ * CMSIS-DSP real FFT per axis. The per-bin power is averaged over the
+ * report interval (Welch, no overlap) and sent as a FRAME_VIBRATION with
+ * RMS per band and the strongest bin, about 100 bytes a second.
+ *
+ * Processing per window:
+ * - Mean removed per axis (gravity and gyro bias), Hann window applied
+ * - arm_rfft_fast_f32 on each of the six axes
+ * - One-sided power per bin, scaled so that the sum over all bins is the
+ *   signal's mean square (Parseval, corrected for the Hann window)
+ * - Accel X/Y/Z summed into one spectrum, gyro X/Y/Z into another
+ *
+ * Data path:
+ * - ISR -> loop is an SpscRing, DROP_NEWEST. A window with a gap would
+ *   smear the spectrum, so a dropped sample discards the window being
+ *   filled (counted in windowsDiscarded).
+ * - Windows and FFT buffers are bulk loop-only data in OCRAM; only the
+ *   ring is in DTCM. One instance (file-scope buffers, as DMAMEM needs).
+ *
+ * Cost: six 256-point rffts plus windowing, in the loop slot that
+ * completes a window, at most one window per service() call.
+ *
+ * Usage:
+ *   VibrationAnalyzer vibration;
+ *   vibration.begin();                       // setup
+ *   vibration.push(samples, count);          // balance ISR, after updateBatch()
+ *   vibration.service();                     // loop slot
+ *   vibration.report(telemetry);             // loop slot, report interval
+ */
+class VibrationAnalyzer {
+public:
+    static constexpr uint16_t WINDOW = Config::VIBRATION_WINDOW_SAMPLES;
+    static constexpr uint16_t BINS = WINDOW / 2;
+    static constexpr uint8_t AXES = 6;         // accel X/Y/Z, gyro X/Y/Z
+    static constexpr float SAMPLE_RATE_HZ = Config::IMU_GYRO_ODR_HZ;   // the sample grid
+
+private:
+    // ~116 ms of samples at 1100 Hz, several service periods
+    SpscRing<IMUSample, 128> _samples;
+
+    bool _ready;
+    uint16_t _fill;                // samples in the current window
+    uint32_t _ringDrops;           // _samples drop count already accounted for
+
+    uint16_t _windows;             // averaged since the last report
+    uint16_t _windowsDiscarded;
+
+    void processWindow();
+
+public:
+    VibrationAnalyzer();
+
+    /**
+     * Set up the FFT instance and window table
+     * @return false if the window length is not a supported FFT size
+     */
+    bool begin();
+
+    /**
+     * Queue samples for analysis. Balance ISR only.
+     */
+    void push(const IMUSample* samples, uint8_t count);
+
+    /**
+     * Move queued samples into the window and transform it when full.
+     * Loop context only.
+     */
+    void service();
+
+    /**
+     * Send FRAME_VIBRATION for the windows since the last report, then
+     * start a new average. Sends nothing if no window completed.
+     * Loop context only.
+     */
+    void report(TelemetryWriter& telemetry);
+};
+
+#endif // VIBRATION_ANALYZER_H
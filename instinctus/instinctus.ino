@@ -1,17 +1,747 @@
-// Calvin Instinctus - Teensy 4.1
-// Hello World
+/**
+ * Calvin Instinctus - Teensy 4.1
+ *
+ * Single-core port of the legacy Giga M4 sketch. The balance task runs at a
+ * fixed rate from a hardware timer ISR; ToF polling, telemetry and stats
+ * reporting run as lower-priority slots serviced from loop(). Startup is
+ * a BootSequencer advanced from loop(), so setup() returns at once and
+ * the balance loop starts as soon as the IMU and CAN are up.
+ *
+ * The shared config/ headers are expected on the compiler include path
+ * (e.g. --build-property "compiler.cpp.extra_flags=-I<repo>/config").
+ * Add -DINSTINCTUS_PROFILE to the same flags to enable the hot-path
+ * probes in Profiler.h, or -DINSTINCTUS_BENCH to build the pipeline
+ * benchmark (PipelineBenchmark.h) instead of the robot firmware. Code and
+ * buffer placement (ITCM / flash / OCRAM) follows MemoryPlacement.h.
+ */
 
-void setup() {
-    Serial.begin(115200);
-    while (!Serial && millis() < 3000);  // Wait up to 3s for USB serial
-    Serial.println("Hello from Calvin Instinctus!");
+#include <Wire.h>
+#include <BalanceConfig.h>
+#include <BoardConfig.h>
+#include <IMUConfig.h>
+#include <ToFConfig.h>
+#include <MotorConfig.h>
+#include <BlackBoxConfig.h>
+#include "MemoryPlacement.h"
+#include "TaskScheduler.h"
+#include "I2CBusGuard.h"
+#include "AsyncI2C.h"
+#include "ICM20948AsyncInterface.h"
+#include "BalanceIMU.h"
+#include "MahonyTiltEstimator.h"
+#include "VL53L4CXInterface.h"
+#include "ToFSensor.h"
+#include "ToFRangingPolicy.h"
+#include "TelemetryLink.h"
+#include "DmaUartPort.h"
+#include "TelemetryWriter.h"
+#include "TimeSync.h"
+#include "ParamStore.h"
+#include "BootSequencer.h"
+#include "RtWatchdog.h"
+#include "HealthMonitor.h"
+#include "JetsonBridge.h"
+#include "EventBus.h"
+#include "Profiler.h"
+#include "PipelineBenchmark.h"
+#include "FlexCANInterface.h"
+#include "ODriveCAN.h"
+#include "ODriveAxis.h"
+#include "DriveCoordinator.h"
+#include "CANBusMonitor.h"
+#include "BalanceMotorController.h"
+#include "BlackBoxRecorder.h"
+#include "VibrationAnalyzer.h"
+#include "CollisionDetector.h"
+
+TaskScheduler scheduler;
+
+// Frames are queued per LinkChannel and multiplexed onto USB Serial and,
+// when enabled, a DMA-driven Serial1 UART, so bulk data (vibration,
+// black box status, profiles) never holds up control frames.
+TelemetryLink jetsonLink;
+DmaUartPort uartPort;
+TelemetryWriter telemetry(&jetsonLink);
+TimeSync timeSync;
+
+// Tunable gains, filter and ToF settings: Config defaults, overridden from
+// EEPROM at boot and over the link. Readers take the active block.
+ParamStore params;
+
+// Events from every sensor go through the bus: safety reactions run
+// immediately in the publisher's context, everything else is deferred to
+// loop(). Together with the bridge's IMU ring, everything the balance ISR
+// reports is queued on the link from loop(); the ISR never touches it.
+EventBus eventBus;
+JetsonBridge bridge(&telemetry, &eventBus);
+
+// The IMU has its own bus (Config::IMU_I2C_BUS) driven from the LPI2C
+// interrupt; the ToF sensors use the blocking Wire API on a second bus
+// from loop(). IMU transfers therefore run concurrently with ToF reads.
+// Anything else that ever shares the IMU bus must go through imuBusGuard.
+I2CBusGuard imuBusGuard;
+AsyncI2C imuBus(Config::IMU_I2C_BUS.port);
+
+// IMU: ICM20948, FIFO drained on its INT1 interrupt
+ICM20948AsyncInterface imuHardware(&imuBus, &imuBusGuard, Config::IMU_I2C_ADDRESS, Config::IMU_INT_PIN);
+BalanceIMU balanceIMU(&imuHardware);
+MahonyTiltEstimator mahonyEstimator;
+
+// ToF: Both VL53L4CX on Config::TOF_I2C_BUS, differentiated by XSHUT pins,
+// each with its GPIO1 data-ready line on an interrupt pin.
+// On boot, both are shut down, then brought up one at a time to assign
+// unique addresses: rear gets 0x30, front keeps default 0x29.
+TwoWire* const tofWire = AsyncI2C::wireForPort(Config::TOF_I2C_BUS.port);
+
+VL53L4CXInterface rearToFHardware(tofWire, Config::TOF_REAR.xshutPin, Config::TOF_REAR.i2cAddress,
+                                  Config::TOF_REAR.timingBudgetUs, Config::TOF_REAR.gpio1Pin);
+ToFSensor rearToF(&rearToFHardware);
+
+VL53L4CXInterface frontToFHardware(tofWire, Config::TOF_FRONT.xshutPin, Config::TOF_FRONT.i2cAddress,
+                                   Config::TOF_FRONT.timingBudgetUs, Config::TOF_FRONT.gpio1Pin);
+ToFSensor frontToF(&frontToFHardware);
+
+// Range vs. rate per sensor, from the commanded speed towards its side
+ToFRangingPolicy rearRanging(&rearToF, Telemetry::SENSOR_REAR, -1.0f);
+ToFRangingPolicy frontRanging(&frontToF, Telemetry::SENSOR_FRONT, 1.0f);
+
+// Motors: two ODrive S1 axes on CAN3. RX is parsed in the CAN ISR;
+// setpoints are queued without waiting for the bus.
+FlexCANInterface canBus(Config::CAN_IRQ_PRIORITY);
+ODriveCAN odrive(&canBus);
+ODriveAxis leftAxis(&canBus, Config::MOTOR_LEFT.canId);
+ODriveAxis rightAxis(&canBus, Config::MOTOR_RIGHT.canId);
+DriveCoordinator drive(&leftAxis, &rightAxis);
+CANBusMonitor canMonitor(&canBus, Config::CAN_BUS_SPEED);
+
+// Cascaded tilt/velocity controller, run in the balance ISR right after
+// the IMU FIFO drain so setpoints leave as soon as the tilt is known
+BalanceMotorController balanceController(&balanceIMU, &drive);
+
+// Full-rate flight recorder: one record per balance tick into RAM, SD
+// writes from a loop slot, emergency snapshot of the seconds around a fall
+BlackBoxRecorder blackBox;
+
+// Vibration spectrum of the full-rate IMU stream, FFTs in a loop slot
+VibrationAnalyzer vibration;
+
+// Impacts from jerk in the same stream, published from the balance ISR
+CollisionDetector collisionDetector;
+
+// Startup runs as a non-blocking sequence from loop() (setup() only
+// queues it): IMU and CAN on one track, ToF bring-up on another.
+enum BootTrack : uint8_t {
+    BOOT_TRACK_CONTROL = 0,
+    BOOT_TRACK_TOF     = 1
+};
+
+BootSequencer boot;
+
+// Loop health, judged every HEALTH_WINDOW_MS once booted: reported on every
+// change, escalated to the safe state (no driving, balance continues) when
+// it persists, and the RTWDOG fed only while the balance task keeps up
+RtWatchdog watchdog;
+HealthMonitor health(&watchdog);
+
+static bool balanceRunning = false;     // balance ISR started, ARM allowed
+static bool rearToFAddressed = false;
+
+// Full-rate motor traffic has to fit the bus with headroom for retries
+static_assert((uint64_t)Config::CAN_FRAMES_PER_BALANCE_CYCLE * canFrameBits(8, false) *
+                  Config::BALANCE_LOOP_HZ * 100 <=
+              (uint64_t)Config::CAN_BUS_SPEED * Config::CAN_BUS_LOAD_LIMIT_PERCENT,
+              "CAN_BUS_SPEED too low for the balance loop's motor traffic");
+
+// ---------------------------------------------------------------------------
+// Tasks
+// ---------------------------------------------------------------------------
+
+static const uint16_t IMU_TELEMETRY_DECIMATION =
+    (uint32_t)Config::BALANCE_LOOP_HZ * Config::IMU_TELEMETRY_INTERVAL_MS / 1000;
+
+// Runs in the PIT ISR at Config::BALANCE_LOOP_HZ. Must never block: the
+// IMU samples were already fetched from the FIFO by the previous tick's
+// async drain, and events and telemetry only go as far as a queue.
+HOT_CODE static void balanceTask() {
+    static uint16_t telemetryTick = 0;
+
+    {
+        PROFILE_SCOPE(Profiler::PROBE_BALANCE_UPDATE);
+        balanceIMU.updateBatch();
+    }
+    {
+        PROFILE_SCOPE(Profiler::PROBE_BALANCE_CONTROL);
+        balanceController.update();
+    }
+    health.balanceTick(balanceIMU.getLastSampleTimeUs());
+
+    // Setpoints are out; everything below only detects and records
+    const IMUSample* batch;
+    uint8_t batchCount = balanceIMU.getLastBatch(batch);
+    collisionDetector.update(batch, batchCount);
+    vibration.push(batch, batchCount);
+
+    float ax, ay, az;
+    float gx, gy, gz;
+    balanceIMU.getAcceleration(ax, ay, az);
+    balanceIMU.getAngularVelocity(gx, gy, gz);
+
+    BlackBoxRecord record;
+    record.timestampUs = balanceIMU.getLastSampleTimeUs();
+    record.accel[0] = ax;
+    record.accel[1] = ay;
+    record.accel[2] = az;
+    record.gyro[0] = gx;
+    record.gyro[1] = gy;
+    record.gyro[2] = gz;
+    record.tiltDeg = balanceIMU.getTiltAngle();
+    record.leanSetpointDeg = balanceController.getLeanSetpoint();
+    record.wheelSpeedRevS = balanceController.getWheelSpeed();
+    record.wheelCommandRevS = balanceController.getWheelCommand();
+    record.iqMeasured[0] = leftAxis.getIqMeasured();
+    record.iqMeasured[1] = rightAxis.getIqMeasured();
+    record.frontMm = (int16_t)frontToF.getDistance();
+    record.rearMm = (int16_t)rearToF.getDistance();
+    record.controllerState = balanceController.getState();
+    memset(record.reserved, 0, sizeof(record.reserved));
+    blackBox.record(record);
+
+    if (++telemetryTick >= IMU_TELEMETRY_DECIMATION) {
+        telemetryTick = 0;
+        ImuTelemetrySample sample;
+        sample.timestampUs = balanceIMU.getLastSampleTimeUs();
+        sample.data.accelX = ax;
+        sample.data.accelY = ay;
+        sample.data.accelZ = az;
+        sample.data.gyroX = gx;
+        sample.data.gyroY = gy;
+        sample.data.gyroZ = gz;
+        sample.data.tiltAngle = balanceIMU.getTiltAngle();
+        bridge.imuTelemetry().push(sample);
+    }
+}
+
+// The controller keeps its own copy of the gains (limits and filter
+// included); it takes the ParamStore's as a whole, disarmed only
+static bool applyGains() {
+    const ParamBlock& block = params.active();
+    PidGains tilt, velocity;
+    balanceController.getGains(tilt, velocity);
+    tilt.kp = block.tiltKp;
+    tilt.ki = block.tiltKi;
+    tilt.kd = block.tiltKd;
+    velocity.kp = block.velocityKp;
+    velocity.ki = block.velocityKi;
+    return balanceController.setGains(tilt, velocity);
+}
+
+static bool isDisarmed() {
+    return balanceController.getState() == BalanceMotorController::STATE_DISARMED;
+}
+
+// The loop is only closed on an estimator validated for it; the replay
+// harness arms the controller directly to evaluate either one
+static bool armBalance() {
+    if (!Config::BALANCE_ARM_ON_COMPLEMENTARY && balanceIMU.usesBuiltInEstimator()) {
+        return false;
+    }
+    return balanceController.arm();
+}
+
+static Commands::CommandStatus setParam(const Commands::SetParamPayload& param) {
+    const ParamStore::ParamInfo* info = ParamStore::find(param.paramId);
+    if (!info) {
+        return Commands::STATUS_BAD_VALUE;
+    }
+    if (info->disarmedOnly && !isDisarmed()) {
+        return Commands::STATUS_REFUSED;
+    }
+    if (!params.set(param.paramId, param.value)) {
+        return Commands::STATUS_BAD_VALUE;
+    }
+    if (info->disarmedOnly) {
+        applyGains();
+    }
+    params.report(telemetry);
+    return Commands::STATUS_OK;
+}
+
+static Commands::CommandStatus executeCommand(const Commands::Command& cmd) {
+    switch (cmd.type) {
+        case Commands::CMD_PING:
+            return Commands::STATUS_OK;
+        case Commands::CMD_SET_VELOCITY: {
+            float revS = cmd.velocity.revS;
+            if (!isfinite(revS) || fabsf(revS) > Config::COMMAND_MAX_VELOCITY_REV_S) {
+                return Commands::STATUS_BAD_VALUE;
+            }
+            if (health.isSafeState()) {
+                return Commands::STATUS_REFUSED;   // CMD_RESET_ESTOP clears it
+            }
+            balanceController.setVelocityTarget(revS);
+            return Commands::STATUS_OK;
+        }
+        case Commands::CMD_ARM:
+            if (!balanceRunning) {
+                return Commands::STATUS_REFUSED;   // still booting
+            }
+            return armBalance() ? Commands::STATUS_OK : Commands::STATUS_REFUSED;
+        case Commands::CMD_DISARM:
+            balanceController.disarm();
+            return Commands::STATUS_OK;
+        case Commands::CMD_RESET_ESTOP:
+            // Clears whichever latch is set; the safe state only once healthy
+            if (!balanceController.isEmergencyStopped() && !health.isSafeState()) {
+                return Commands::STATUS_REFUSED;
+            }
+            if (!health.clearSafeState()) {
+                return Commands::STATUS_REFUSED;
+            }
+            if (balanceController.isEmergencyStopped()) {
+                balanceController.resetEmergencyStop();
+            }
+            blackBox.rearm();
+            health.report(telemetry);
+            return Commands::STATUS_OK;
+        case Commands::CMD_SET_PARAM:
+            return setParam(cmd.param);
+        case Commands::CMD_SAVE_PARAMS:
+            // EEPROM writes stall interrupts while flash is erased
+            if (!isDisarmed()) {
+                return Commands::STATUS_REFUSED;
+            }
+            return params.save() ? Commands::STATUS_OK : Commands::STATUS_REFUSED;
+        case Commands::CMD_RESET_PARAMS:
+            // Gains and the rest move together, so disarmed only as well
+            if (!isDisarmed()) {
+                return Commands::STATUS_REFUSED;
+            }
+            params.resetToDefaults();
+            applyGains();
+            params.report(telemetry);
+            return Commands::STATUS_OK;
+        case Commands::CMD_GET_PARAMS:
+            params.report(telemetry);
+            return Commands::STATUS_OK;
+        case Commands::CMD_TIME_SYNC:
+            return timeSync.addSample(cmd.timeSync, cmd.receivedUs) ? Commands::STATUS_OK
+                                                                    : Commands::STATUS_BAD_VALUE;
+        default:
+            return Commands::STATUS_BAD_VALUE;   // parser only passes known types
+    }
+}
+
+static void bridgeTask() {
+    PROFILE_SCOPE(Profiler::PROBE_BRIDGE_SERVICE);
+    eventBus.dispatchDeferred(Config::EVENT_DISPATCH_BUDGET);
+    bridge.service();
+
+    Commands::Command cmd;
+    while (bridge.commands().pop(cmd)) {
+        bridge.sendCommandAck(cmd, executeCommand(cmd));
+        timeSync.addCommandLatency(cmd.sentUs, micros());
+    }
+}
+
+static void timeSyncTask() {
+    timeSync.report(telemetry);
+}
+
+static void tofTask() {
+    // Disarmed the wheels won't follow the target, so rank as standing still
+    float commandedRevS = (balanceController.getState() == BalanceMotorController::STATE_ARMED)
+                              ? balanceController.getVelocityTarget() : 0.0f;
+    if (frontRanging.update(commandedRevS)) {
+        frontRanging.report(telemetry);
+    }
+    if (rearRanging.update(commandedRevS)) {
+        rearRanging.report(telemetry);
+    }
+
+    // GPIO1 data-ready flags: most ticks there is nothing to read
+    if (!frontToF.hasPendingData() && !rearToF.hasPendingData()) {
+        return;
+    }
+    PROFILE_SCOPE(Profiler::PROBE_TOF_UPDATE);
+    frontToF.update();
+    rearToF.update();
+}
+
+static void tofTelemetryTask() {
+    Telemetry::ToFPayload* p =
+        telemetry.begin<Telemetry::ToFPayload>(Telemetry::FRAME_TOF, micros());
+    p->frontMm = (int16_t)frontToF.getDistance();
+    p->rearMm = (int16_t)rearToF.getDistance();
+    telemetry.commit();
+}
+
+static void blackBoxTask() {
+    blackBox.service();
+}
+
+static const uint16_t VIBRATION_REPORT_DECIMATION =
+    Config::VIBRATION_REPORT_INTERVAL_MS / Config::VIBRATION_TASK_PERIOD_MS;
+
+static void vibrationTask() {
+    static uint16_t reportTick = 0;
+    vibration.service();
+    if (++reportTick >= VIBRATION_REPORT_DECIMATION) {
+        reportTick = 0;
+        vibration.report(telemetry);
+    }
+}
+
+static void fillMotorRecord(Telemetry::MotorAxisRecord& record, const ODriveAxis& axis) {
+    ODriveAxis::EncoderEstimate encoder = {};
+    axis.getEncoderEstimate(encoder);
+    record.nodeId = axis.getNodeId();
+    record.axisState = axis.isAlive(Config::ODRIVE_HEARTBEAT_TIMEOUT_US) ? axis.getAxisState() : 0;
+    record.axisError = axis.getAxisError();
+    record.positionRev = encoder.positionRev;
+    record.velocityRevS = encoder.velocityRevS;
+    record.iqMeasured = axis.getIqMeasured();
+    record.busVoltage = axis.getBusVoltage();
+    record.txFailures = axis.getTxFailureCount();
+}
+
+static void motorTelemetryTask() {
+    Telemetry::MotorPayload* p =
+        telemetry.begin<Telemetry::MotorPayload>(Telemetry::FRAME_MOTOR, micros());
+    fillMotorRecord(p->axes[0], leftAxis);
+    fillMotorRecord(p->axes[1], rightAxis);
+    telemetry.commit();
+
+    balanceController.report(telemetry);
+}
+
+static void fillTaskRecord(Telemetry::TaskStatsRecord& record, const char* name, const TaskStats& stats) {
+    memset(record.name, 0, sizeof(record.name));
+    strncpy(record.name, name, sizeof(record.name));
+    record.runs = stats.runs;
+    record.overruns = stats.overruns;
+    record.lastCycles = stats.lastCycles;
+    record.maxCycles = stats.maxCycles;
+    record.maxJitterCycles = stats.maxJitterCycles;
+}
+
+static HealthMonitor::Inputs healthInputs() {
+    TaskStats balanceStats;
+    scheduler.getBalanceStats(balanceStats);
+
+    HealthMonitor::Inputs inputs;
+    inputs.balanceRuns = balanceStats.runs;
+    inputs.balanceOverruns = balanceStats.overruns;
+    inputs.i2cTimeouts = imuBus.getTimeoutCount();
+    inputs.canTxFailures = leftAxis.getTxFailureCount() + rightAxis.getTxFailureCount();
+    inputs.tofMeasurementUs[Telemetry::SENSOR_REAR] = rearToF.getLastMeasurementUs();
+    inputs.tofMeasurementUs[Telemetry::SENSOR_FRONT] = frontToF.getLastMeasurementUs();
+    return inputs;
+}
+
+// No-op until health.start() at the end of the boot sequence
+static void healthTask() {
+    imuBus.checkTimeout(Config::HEALTH_I2C_TIMEOUT_US);
+    if (!health.update(healthInputs())) {
+        return;
+    }
+    health.report(telemetry);
+    if (health.isSafeState()) {
+        balanceController.setVelocityTarget(0.0f);
+        telemetry.log("Safe state: driving stopped until CMD_RESET_ESTOP");
+    }
+}
+
+// The balance task plus every loop slot, paged over FRAME_SCHEDULER frames
+static constexpr uint8_t SCHEDULER_REPORT_FRAMES =
+    (1 + TaskScheduler::MAX_LOOP_TASKS + Telemetry::MAX_TASK_RECORDS - 1) / Telemetry::MAX_TASK_RECORDS;
+static_assert(SCHEDULER_REPORT_FRAMES <= 2,
+              "MAX_LOOP_TASKS grew: scheduler stats would take more than two frames per report");
+
+static void schedulerStatsTask() {
+    const uint8_t total = 1 + scheduler.getTaskCount();
+    for (uint8_t first = 0; first < total; first += Telemetry::MAX_TASK_RECORDS) {
+        Telemetry::SchedulerPayload* p =
+            telemetry.begin<Telemetry::SchedulerPayload>(Telemetry::FRAME_SCHEDULER, micros());
+        p->cpuHz = F_CPU_ACTUAL;
+        p->firstTask = first;
+        p->totalTasks = total;
+
+        uint8_t count = 0;
+        for (uint8_t index = first; index < total && count < Telemetry::MAX_TASK_RECORDS; index++) {
+            if (index == 0) {
+                TaskStats balanceStats;
+                scheduler.getBalanceStats(balanceStats);
+                fillTaskRecord(p->tasks[count++], "balance", balanceStats);
+            } else {
+                fillTaskRecord(p->tasks[count++], scheduler.getTaskName(index - 1),
+                               scheduler.getTaskStats(index - 1));
+            }
+        }
+        p->taskCount = count;
+        telemetry.commit(offsetof(Telemetry::SchedulerPayload, tasks) + count * sizeof(Telemetry::TaskStatsRecord));
+    }
+
+    Telemetry::ImuHealthPayload* h =
+        telemetry.begin<Telemetry::ImuHealthPayload>(Telemetry::FRAME_IMU_HEALTH, micros());
+    h->deferredReads = imuHardware.getDeferredReadCount();
+    h->failedReads = imuHardware.getFailedReadCount();
+    h->fifoResets = imuHardware.getFifoResetCount();
+    h->busContentions = imuBusGuard.getContentionCount();
+    telemetry.commit();
+
+    bridge.sendLinkHealth();
+    canMonitor.report(telemetry);
+    blackBox.report(telemetry);
+    health.report(telemetry);
+    Profiler::report(telemetry);  // no-op unless built with INSTINCTUS_PROFILE
+}
+
+// ---------------------------------------------------------------------------
+// Boot sequence steps (BootSequencer). Failures are logged here; the
+// sequence carries on without the device, as a straight setup() would.
+
+static BootSequencer::StepResult imuResetStep(uint32_t& waitUs) {
+    // On failure imuInit retries the reset itself
+    if (!imuHardware.reset()) {
+        return BootSequencer::STEP_FAILED;
+    }
+    waitUs = Config::IMU_RESET_TIME_US;
+    return BootSequencer::STEP_DONE;
+}
+
+static BootSequencer::StepResult imuInitStep(uint32_t&) {
+    balanceIMU.setEventBus(&eventBus);
+    collisionDetector.setEventBus(&eventBus);
+    if (Config::TILT_USE_MAHONY) {
+        balanceIMU.setEstimator(&mahonyEstimator);
+    }
+    if (!balanceIMU.initialize()) {
+        telemetry.log("IMU init failed");
+        return BootSequencer::STEP_FAILED;
+    }
+    return BootSequencer::STEP_DONE;
+}
+
+static BootSequencer::StepResult balanceStartStep(uint32_t&) {
+    odrive.addAxis(&leftAxis);
+    odrive.addAxis(&rightAxis);
+    bool ok = true;
+    if (!odrive.begin(Config::CAN_BUS_SPEED)) {
+        telemetry.log("CAN init failed");
+        ok = false;
+    }
+    if (!scheduler.begin(balanceTask, Config::BALANCE_LOOP_HZ, Config::BALANCE_ISR_PRIORITY)) {
+        telemetry.log("Balance timer start failed");
+        return BootSequencer::STEP_FAILED;
+    }
+    balanceRunning = true;
+    if (Config::BALANCE_AUTO_ARM && !armBalance()) {
+        telemetry.log("Balance controller arm failed");
+        ok = false;
+    }
+    return ok ? BootSequencer::STEP_DONE : BootSequencer::STEP_FAILED;
+}
+
+static BootSequencer::StepResult vibrationStartStep(uint32_t&) {
+    if (Config::VIBRATION_ENABLED && !vibration.begin()) {
+        telemetry.log("Vibration FFT init failed");
+        return BootSequencer::STEP_FAILED;
+    }
+    return BootSequencer::STEP_DONE;
+}
+
+static BootSequencer::StepResult blackBoxStartStep(uint32_t&) {
+    if (Config::BLACKBOX_ENABLED && !blackBox.begin()) {
+        telemetry.log("SD card not found, black box off");
+        return BootSequencer::STEP_FAILED;
+    }
+    return BootSequencer::STEP_DONE;
+}
+
+static BootSequencer::StepResult rearToFPowerStep(uint32_t& waitUs) {
+    rearToFHardware.powerUp();
+    waitUs = Config::TOF_BOOT_TIME_US;
+    return BootSequencer::STEP_DONE;
+}
+
+static BootSequencer::StepResult rearToFAddressStep(uint32_t& waitUs) {
+    // Rear moves to 0x30 first; only then may the front come up at 0x29
+    rearToFAddressed = rearToFHardware.assignAddress();
+    if (!rearToFAddressed) {
+        return BootSequencer::STEP_FAILED;
+    }
+    frontToFHardware.powerUp();
+    waitUs = Config::TOF_BOOT_TIME_US;
+    return BootSequencer::STEP_DONE;
+}
+
+static BootSequencer::StepResult frontToFAddressStep(uint32_t&) {
+    if (!rearToFAddressed) {
+        return BootSequencer::STEP_FAILED;   // retried by tofFInit
+    }
+    return frontToFHardware.assignAddress() ? BootSequencer::STEP_DONE : BootSequencer::STEP_FAILED;
+}
+
+static BootSequencer::StepResult rearToFInitStep(uint32_t&) {
+    rearToF.setEventBus(&eventBus, Telemetry::SENSOR_REAR, Config::TOF_REAR.warnDistanceMm);
+    if (!rearToF.initialize()) {
+        telemetry.log("Rear ToF init failed");
+        return BootSequencer::STEP_FAILED;
+    }
+    return BootSequencer::STEP_DONE;
+}
+
+static BootSequencer::StepResult frontToFInitStep(uint32_t&) {
+    frontToF.setEventBus(&eventBus, Telemetry::SENSOR_FRONT, Config::TOF_FRONT.warnDistanceMm);
+    if (!frontToF.initialize()) {
+        telemetry.log("Front ToF init failed");
+        return BootSequencer::STEP_FAILED;
+    }
+    return BootSequencer::STEP_DONE;
+}
+
+// ---------------------------------------------------------------------------
+
+#ifdef INSTINCTUS_BENCH
+// Bench build: the stages are timed with nothing else running (no balance
+// ISR, no boot sequence) and printed as JSON lines on USB Serial. Any
+// byte received runs the suite again; the LED is on while it passes.
+static bool benchImuReady = false;
+
+static uint32_t readCycles() {
+    return ARM_DWT_CYCCNT;
+}
+
+COLD_CODE static void runBenchmark() {
+    if (F_CPU_ACTUAL != Config::BENCH_REFERENCE_HZ) {
+        Serial.println("{\"bench\":\"pipeline\",\"warning\":\"F_CPU differs from BENCH_REFERENCE_HZ\"}");
+    }
+    PipelineBenchmark::Options options = {
+        benchImuReady ? &imuHardware : nullptr, readCycles, PipelineBenchmark::GATE_MAX, "teensy41"
+    };
+    digitalWrite(LED_BUILTIN, PipelineBenchmark::run(options, Serial) ? HIGH : LOW);
+}
+
+COLD_CODE static void benchSetup() {
+    Serial.begin(Config::SERIAL_BAUD_RATE);
+    pinMode(LED_BUILTIN, OUTPUT);
+    uint32_t start = millis();
+    while (!Serial && millis() - start < Config::BENCH_SERIAL_WAIT_MS) {
+    }
+
+    // readSensors is timed on the real IMU when it comes up
+    imuBus.begin(Config::IMU_I2C_IRQ_PRIORITY, Config::IMU_I2C_BUS.clockHz);
+    benchImuReady = imuHardware.initialize();
+    runBenchmark();
+}
+
+static void benchLoop() {
+    if (Serial.available() > 0) {
+        while (Serial.available() > 0) {
+            Serial.read();
+        }
+        runBenchmark();
+    }
+}
+#endif // INSTINCTUS_BENCH
+
+COLD_CODE void setup() {
+#ifdef INSTINCTUS_BENCH
+    benchSetup();
+    return;
+#endif
+    // No waiting for the USB host: frames queue on the link until the
+    // port is opened, and the Jetson has the boot report either way
+    Serial.begin(Config::SERIAL_BAUD_RATE);
+    jetsonLink.setPort(0, &Serial);
+    if (Config::LINK_UART_ENABLED && uartPort.begin(Config::LINK_UART_BAUD)) {
+        jetsonLink.setPort(1, &uartPort);
+    }
+    jetsonLink.route(Telemetry::CHANNEL_CONTROL, Config::LINK_CONTROL_PORT);
+    jetsonLink.route(Telemetry::CHANNEL_TELEMETRY, Config::LINK_TELEMETRY_PORT);
+    jetsonLink.route(Telemetry::CHANNEL_BULK, Config::LINK_BULK_PORT);
     pinMode(LED_BUILTIN, OUTPUT);
+
+    tofWire->begin();
+    tofWire->setClock(Config::TOF_I2C_BUS.clockHz);
+    imuBus.begin(Config::IMU_I2C_IRQ_PRIORITY, Config::IMU_I2C_BUS.clockHz);
+
+    // Persisted parameters, before anything reads them
+    if (!params.load()) {
+        telemetry.log("No saved parameters, using defaults");
+    }
+    applyGains();
+    balanceIMU.setParams(&params);
+    rearToF.setParams(&params);
+    frontToF.setParams(&params);
+    rearRanging.setParams(&params);
+    frontRanging.setParams(&params);
+
+    // Event routing, before any publisher can run
+    eventBus.emergency.subscribe<BalanceMotorController, &BalanceMotorController::onBalanceEmergency>(
+        &balanceController, Dispatch::IMMEDIATE);
+    eventBus.emergency.subscribe<BlackBoxRecorder, &BlackBoxRecorder::onBalanceEmergency>(
+        &blackBox, Dispatch::IMMEDIATE);
+    eventBus.emergency.subscribe<JetsonBridge, &JetsonBridge::onBalanceEmergency>(&bridge, Dispatch::DEFERRED);
+    eventBus.tilt.subscribe<JetsonBridge, &JetsonBridge::onTilt>(&bridge, Dispatch::DEFERRED);
+    eventBus.obstacle.subscribe<JetsonBridge, &JetsonBridge::onObstacle>(&bridge, Dispatch::DEFERRED);
+    eventBus.collision.subscribe<JetsonBridge, &JetsonBridge::onCollision>(&bridge, Dispatch::DEFERRED);
+    bridge.setLink(&jetsonLink);
+    telemetry.setClock(&timeSync);
+    bridge.setCommandInput(&Serial);
+
+    // Both ToF sensors held in reset; the boot sequence brings them up one
+    // at a time to assign unique addresses
+    pinMode(Config::TOF_REAR.xshutPin, OUTPUT);
+    pinMode(Config::TOF_FRONT.xshutPin, OUTPUT);
+    digitalWrite(Config::TOF_REAR.xshutPin, LOW);
+    digitalWrite(Config::TOF_FRONT.xshutPin, LOW);
+
+    // Loop slots in priority order. They already run during the boot
+    // sequence; every one of them is a no-op until its device is up.
+    scheduler.addTask("bridge", bridgeTask, Config::BRIDGE_TASK_PERIOD_MS * 1000UL);
+    scheduler.addTask("health", healthTask, Config::HEALTH_WINDOW_MS * 1000UL);
+    scheduler.addTask("tof", tofTask, Config::TOF_TASK_PERIOD_MS * 1000UL);
+    scheduler.addTask("tofTlm", tofTelemetryTask, Config::TOF_TELEMETRY_INTERVAL_MS * 1000UL);
+    scheduler.addTask("motorTlm", motorTelemetryTask, Config::MOTOR_TELEMETRY_INTERVAL_MS * 1000UL);
+    scheduler.addTask("blackBox", blackBoxTask, Config::BLACKBOX_TASK_PERIOD_MS * 1000UL);
+    scheduler.addTask("vibFft", vibrationTask, Config::VIBRATION_TASK_PERIOD_MS * 1000UL);
+    scheduler.addTask("stats", schedulerStatsTask, Config::SCHEDULER_STATS_INTERVAL_MS * 1000UL);
+    scheduler.addTask("timeSync", timeSyncTask, Config::TIME_SYNC_PERIOD_MS * 1000UL);
+
+    // Control track: IMU, CAN, balance loop, then the loop-only extras.
+    // ToF track: power-up and address assignment overlap the IMU reset;
+    // the slow firmware init of each sensor waits for the balance loop.
+    boot.addStep(BOOT_TRACK_CONTROL, "imuReset", imuResetStep);
+    boot.addStep(BOOT_TRACK_CONTROL, "imuInit", imuInitStep);
+    int8_t balanceStep = boot.addStep(BOOT_TRACK_CONTROL, "balance", balanceStartStep);
+    boot.addStep(BOOT_TRACK_CONTROL, "vibFft", vibrationStartStep);
+    boot.addStep(BOOT_TRACK_CONTROL, "blackBox", blackBoxStartStep);
+    boot.addStep(BOOT_TRACK_TOF, "tofRPwr", rearToFPowerStep);
+    boot.addStep(BOOT_TRACK_TOF, "tofRAddr", rearToFAddressStep);
+    boot.addStep(BOOT_TRACK_TOF, "tofFAddr", frontToFAddressStep);
+    boot.addStep(BOOT_TRACK_TOF, "tofRInit", rearToFInitStep, balanceStep);
+    boot.addStep(BOOT_TRACK_TOF, "tofFInit", frontToFInitStep, balanceStep);
+    boot.start();
 }
 
 void loop() {
-    digitalWrite(LED_BUILTIN, HIGH);
-    delay(500);
-    digitalWrite(LED_BUILTIN, LOW);
-    delay(500);
-    Serial.println("Hello from Calvin Instinctus!");
+#ifdef INSTINCTUS_BENCH
+    benchLoop();
+    return;
+#endif
+    scheduler.runPending();
+    if (boot.run()) {
+        boot.report(telemetry);
+        params.report(telemetry);
+        digitalWrite(LED_BUILTIN, HIGH);
+        if (RtWatchdog::causedLastReset()) {
+            telemetry.log("Last reset was the watchdog");
+        }
+        if (Config::WATCHDOG_ENABLED && !watchdog.begin(Config::WATCHDOG_TIMEOUT_MS)) {
+            telemetry.log("Watchdog timeout out of range, not started");
+        }
+        health.start(healthInputs());
+        telemetry.log("Calvin Instinctus initialized");
+    }
 }